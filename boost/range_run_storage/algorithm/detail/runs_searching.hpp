@@ -14,6 +14,8 @@
 #include <functional>
 #include <boost/assert.hpp>
 #include <boost/utility/enable_if.hpp>
+#include <boost/iterator/iterator_traits.hpp>
+#include <boost/iterator/iterator_categories.hpp>
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/range_run_storage/utility/subrun.hpp>
@@ -141,14 +143,49 @@ namespace boost { namespace range_run_storage
             return begin + (rrs::offset(run) - rrs::offset(period));
         }
 
-        // Binary search in the index property map for the requested offset
+        // Search forward from begin, which is usually close to the run we are
+        // looking for, so try 1, 2, 4, ... runs ahead before binary searching
+        // the last step. The cost is logarithmic in the distance skipped rather
+        // than in the length of the sequence.
         template<typename Cursor, typename Runs, typename Run>
         Cursor
-        run_skip_ahead_to(Cursor begin, Cursor end, Runs const &runs, Run const &run)
+        run_gallop_to(Cursor begin, Cursor end, Runs const &runs, Run const &run, random_access_traversal_tag)
+        {
+            typedef typename rrs::concepts::Run<Run>::offset_type offset_type;
+            typedef std::pair<offset_type, offset_type> run_type;
+            typedef typename iterator_difference<Cursor>::type difference_type;
+
+            run_type const target = rrs::run_cast<run_type>(run);
+            if(begin == end || !rrs::less(rrs::run_cast<run_type>(runs(*begin)), target))
+                return begin;
+
+            // begin is before the target
+            difference_type step = 1;
+            while(step < end - begin && rrs::less(rrs::run_cast<run_type>(runs(*(begin + step))), target))
+            {
+                begin += step;
+                step *= 2;
+            }
+
+            Cursor last = step < end - begin ? begin + step : end;
+            return run_lower_bound(begin + 1, last, runs, run);
+        }
+
+        template<typename Cursor, typename Runs, typename Run>
+        Cursor
+        run_gallop_to(Cursor begin, Cursor end, Runs const &runs, Run const &run, incrementable_traversal_tag)
         {
             return run_lower_bound(begin, end, runs, run);
         }
 
+        // Search forward in the runs property map for the requested run
+        template<typename Cursor, typename Runs, typename Run>
+        Cursor
+        run_skip_ahead_to(Cursor begin, Cursor end, Runs const &runs, Run const &run)
+        {
+            return run_gallop_to(begin, end, runs, run, typename iterator_traversal<Cursor>::type());
+        }
+
         // Optimize for random-access
         template<typename Iter, typename Runs, typename Run>
         typename enable_if<rrs::traits::is_dense_runs<Runs>, counting_iterator<Iter> >::type
@@ -160,7 +197,10 @@ namespace boost { namespace range_run_storage
         )
         {
             BOOST_ASSERT(rrs::offset(runs(*begin)) <= rrs::offset(run));
-            BOOST_ASSERT(rrs::offset(runs(*begin)) + (end-begin) >= rrs::offset(run));
+
+            // The other sequence may skip past the end of this one entirely
+            if(rrs::offset(runs(*begin)) + (end-begin) <= rrs::offset(run))
+                return end;
 
             return begin + (rrs::offset(run) - rrs::offset(runs(*begin)));
         }
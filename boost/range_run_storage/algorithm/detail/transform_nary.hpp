@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file transform_nary.hpp
+/// transform() for any number of InfiniteRangeRunStorage
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_RANGE_RUN_STORAGE_ALGORITHM_DETAIL_TRANSFORM_NARY_EAN_10_18_2026_HPP
+#define BOOST_RANGE_RUN_STORAGE_ALGORITHM_DETAIL_TRANSFORM_NARY_EAN_10_18_2026_HPP
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <boost/mpl/assert.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/range/value_type.hpp>
+#include <boost/utility/result_of.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/range_run_storage/utility/infinity.hpp>
+
+namespace boost { namespace range_run_storage
+{
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+
+        // The runs of one input, in order: its pre-run, its finite runs and
+        // its post-run, without the empty ones.
+        template<typename In>
+        struct nary_input
+        {
+            typedef concepts::InfiniteRangeRunStorage<In const> concept_type;
+            typedef typename concept_type::value_type value_type;
+            typedef typename concept_type::offset_type offset_type;
+            typedef typename concept_type::cursor cursor_type;
+            typedef typename concept_type::runs runs_type;
+            typedef typename concept_type::elements elements_type;
+
+            explicit nary_input(In const &in)
+              : in_(&in)
+              , runs_(rrs::runs(in))
+              , elements_(sequence::elements(in))
+              , begin_(sequence::begin(in))
+              , end_(sequence::end(in))
+              , state_(0)
+              , offset_()
+              , end_offset_()
+              , value_(rrs::zero(in))
+              , zero_(rrs::zero(in))
+              , active_(false)
+            {}
+
+            // Load the next non-empty run. Returns false when there are no more.
+            bool next()
+            {
+                for(;;)
+                {
+                    switch(this->state_)
+                    {
+                    case 0:
+                        this->state_ = 1;
+                        if(this->set_(rrs::pre_run(*this->in_), rrs::pre_value(*this->in_)))
+                            return true;
+                        break;
+                    case 1:
+                        if(this->begin_ != this->end_)
+                        {
+                            cursor_type where = this->begin_++;
+                            if(this->set_(this->runs_(*where), this->elements_(*where)))
+                                return true;
+                            break;
+                        }
+                        this->state_ = 2;
+                        if(this->set_(rrs::post_run(*this->in_), rrs::post_value(*this->in_)))
+                            return true;
+                        break;
+                    default:
+                        this->state_ = 3;
+                        return false;
+                    }
+                }
+            }
+
+            // The next offset at which this input's value changes
+            offset_type boundary() const
+            {
+                return this->active_ ? this->end_offset_ : this->offset_;
+            }
+
+            value_type const &value() const
+            {
+                return this->active_ ? this->value_ : this->zero_;
+            }
+
+            template<typename Run, typename Value>
+            bool set_(Run const &run, Value const &value)
+            {
+                if(rrs::empty(run))
+                {
+                    return false;
+                }
+                this->offset_ = rrs::offset(run);
+                this->end_offset_ = rrs::end_offset(run);
+                this->value_ = value;
+                return true;
+            }
+
+            In const *in_;
+            runs_type runs_;
+            elements_type elements_;
+            cursor_type begin_;
+            cursor_type end_;
+            int state_;
+            offset_type offset_;
+            offset_type end_offset_;
+            value_type value_;
+            value_type zero_;
+            bool active_;
+        };
+
+        // The fold of the current values of k inputs, kept in a complete binary
+        // tree whose leaves are the inputs in order. Changing one value refolds
+        // only the O(log k) nodes above it. Leaves past the last input are
+        // empty and fold to nothing, so the inputs are still combined from left
+        // to right; only the grouping differs from a left fold.
+        template<typename Value, typename BinOp>
+        struct nary_fold
+        {
+            template<typename Input>
+            nary_fold(std::vector<Input> const &in, BinOp const &binary_op)
+              : binary_op_(binary_op)
+              , width_(1)
+              , nodes_()
+              , full_()
+            {
+                while(this->width_ < in.size())
+                {
+                    this->width_ *= 2;
+                }
+
+                this->nodes_.resize(2 * this->width_);
+                this->full_.resize(2 * this->width_, false);
+                for(std::size_t i = 0; i != in.size(); ++i)
+                {
+                    this->nodes_[this->width_ + i] = in[i].value();
+                    this->full_[this->width_ + i] = true;
+                }
+                for(std::size_t i = this->width_ - 1; i != 0; --i)
+                {
+                    this->refold_(i);
+                }
+            }
+
+            template<typename Input>
+            void set(std::size_t i, Input const &in)
+            {
+                i += this->width_;
+                this->nodes_[i] = in.value();
+                for(i /= 2; i != 0; i /= 2)
+                {
+                    this->refold_(i);
+                }
+            }
+
+            Value const &value() const
+            {
+                return this->nodes_[1];
+            }
+
+        private:
+            void refold_(std::size_t i)
+            {
+                std::size_t const left = 2 * i, right = left + 1;
+                if(this->full_[left] && this->full_[right])
+                {
+                    this->nodes_[i] = this->binary_op_(this->nodes_[left], this->nodes_[right]);
+                }
+                else if(this->full_[left] || this->full_[right])
+                {
+                    this->nodes_[i] = this->nodes_[this->full_[left] ? left : right];
+                }
+                this->full_[i] = this->full_[left] || this->full_[right];
+            }
+
+            BinOp const &binary_op_;
+            std::size_t width_;
+            std::vector<Value> nodes_;
+            std::vector<bool> full_;
+        };
+
+        // Sweeps the inputs from -inf to +inf. A min-heap holds the offset at
+        // which each input next starts or stops a run, and a nary_fold holds the
+        // fold of the current values, so each input that starts or stops a run
+        // costs O(log k), however many inputs there are. The fold is written out
+        // wherever at least one input (for a union) or every input (for an
+        // intersection) has a run.
+        template<typename Inputs, typename BinOp, typename Out>
+        void transform_nary(Inputs const &inputs, BinOp const &binary_op, bool is_union, Out &out)
+        {
+            typedef typename range_value<Inputs const>::type in_type;
+            typedef nary_input<in_type> input_type;
+            typedef typename input_type::value_type value_type;
+            typedef typename input_type::offset_type offset_type;
+            typedef typename boost::result_of<BinOp(value_type, value_type)>::type result_type;
+            typedef std::pair<offset_type, std::size_t> event_type;
+            typedef std::greater<event_type> event_order;
+
+            BOOST_MPL_ASSERT((is_integral<offset_type>));
+
+            std::vector<input_type> in;
+            for(typename range_iterator<Inputs const>::type begin = boost::begin(inputs), end = boost::end(inputs); begin != end; ++begin)
+            {
+                in.push_back(input_type(*begin));
+            }
+
+            if(in.empty())
+            {
+                return;
+            }
+
+            std::size_t const size = in.size();
+            std::size_t active = 0;
+            offset_type offset = -inf;
+            std::vector<event_type> heap;
+            heap.reserve(size);
+
+            for(std::size_t i = 0; i != size; ++i)
+            {
+                if(in[i].next())
+                {
+                    in[i].active_ = (in[i].offset_ == offset);
+                    active += in[i].active_;
+                    heap.push_back(event_type(in[i].boundary(), i));
+                }
+                else if(!is_union)
+                {
+                    return;
+                }
+            }
+
+            std::make_heap(heap.begin(), heap.end(), event_order());
+            nary_fold<result_type, BinOp> fold(in, binary_op);
+
+            while(!heap.empty())
+            {
+                offset_type const end_offset = heap.front().first;
+
+                if(offset != end_offset && (is_union ? active != 0 : active == size))
+                {
+                    std::pair<offset_type, offset_type> const run(offset, end_offset);
+                    rrs::set_at(out, run, fold.value());
+                }
+
+                // Every input whose run starts or stops here moves on
+                while(!heap.empty() && heap.front().first == end_offset)
+                {
+                    std::pop_heap(heap.begin(), heap.end(), event_order());
+                    std::size_t const which = heap.back().second;
+                    input_type &that = in[which];
+                    heap.pop_back();
+
+                    if(!that.active_)
+                    {
+                        that.active_ = true;
+                        ++active;
+                    }
+                    else if(that.next())
+                    {
+                        that.active_ = (that.offset_ == end_offset);
+                        active -= !that.active_;
+                    }
+                    else
+                    {
+                        that.active_ = false;
+                        --active;
+                        fold.set(which, that);
+
+                        // An intersection is over once any input runs out
+                        if(!is_union)
+                        {
+                            return;
+                        }
+                        continue;
+                    }
+
+                    fold.set(which, that);
+                    heap.push_back(event_type(that.boundary(), which));
+                    std::push_heap(heap.begin(), heap.end(), event_order());
+                }
+
+                offset = end_offset;
+            }
+        }
+    } // namespace detail
+}}
+
+#endif // BOOST_RANGE_RUN_STORAGE_ALGORITHM_DETAIL_TRANSFORM_NARY_EAN_10_18_2026_HPP
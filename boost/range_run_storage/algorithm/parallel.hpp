@@ -0,0 +1,568 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file parallel.hpp
+/// Multi-threaded versions of \c transform, \c copy and \c for_each
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_RANGE_RUN_STORAGE_ALGORITHM_PARALLEL_EAN_10_18_2026_HPP
+#define BOOST_RANGE_RUN_STORAGE_ALGORITHM_PARALLEL_EAN_10_18_2026_HPP
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <iterator>
+#include <boost/bind.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility/result_of.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/range_run_storage/utility/unit_run.hpp>
+#include <boost/range_run_storage/utility/subsequence.hpp>
+#include <boost/range_run_storage/algorithm/transform.hpp>
+#include <boost/range_run_storage/algorithm/for_each.hpp>
+#include <boost/range_run_storage/algorithm/detail/placeholders.hpp>
+#include <boost/range_run_storage/algorithm/detail/runs_searching.hpp>
+
+namespace boost { namespace range_run_storage
+{
+    namespace rrs = range_run_storage;
+
+    namespace detail
+    {
+        // An OrderedInserter that saves the runs written to it, so that a worker
+        // thread can compute its part of the output before it is stitched into
+        // the real OrderedInserter in order.
+        template<typename Offset, typename Value>
+        struct run_buffer
+        {
+            typedef std::pair<Offset, Offset> run_type;
+            typedef std::vector<std::pair<run_type, Value> > data_type;
+
+            template<typename Run, typename V>
+            void set_at(Run &run, V &value)
+            {
+                this->data_.push_back(std::make_pair(rrs::run_cast<run_type>(run), Value(value)));
+            }
+
+            template<typename Out>
+            void flush(Out &out)
+            {
+                typename data_type::iterator begin = this->data_.begin(), end = this->data_.end();
+                for(; begin != end; ++begin)
+                {
+                    rrs::set_at(out, begin->first, begin->second);
+                }
+                data_type().swap(this->data_);
+            }
+
+        private:
+            data_type data_;
+        };
+
+        // The runs of storage in [begin, end), with fun applied to their values
+        template<typename In, typename UnaryOp, typename Out>
+        struct transform_chunk
+        {
+            typedef typename concepts::InfiniteRangeRunStorage<In const>::cursor cursor_type;
+
+            transform_chunk(In const &in, cursor_type begin, cursor_type end, UnaryOp const &fun, Out &out)
+              : in_(in), begin_(begin), end_(end), fun_(fun), out_(out)
+            {}
+
+            void operator ()() const
+            {
+                typename concepts::InfiniteRangeRunStorage<In const>::runs runs = rrs::runs(this->in_);
+                typename concepts::InfiniteRangeRunStorage<In const>::elements elements = sequence::elements(this->in_);
+                for(cursor_type begin = this->begin_; begin != this->end_; ++begin)
+                {
+                    rrs::set_at(this->out_, runs(*begin), this->fun_(elements(*begin)));
+                }
+            }
+
+        private:
+            In const &in_;
+            cursor_type begin_;
+            cursor_type end_;
+            UnaryOp const &fun_;
+            Out &out_;
+        };
+
+        // The union of two ranges of runs that do not overlap any run outside them.
+        // The first chunk also has the pre-runs and the last the post-runs; the
+        // others have empty ones.
+        template<typename Left, typename Right, typename BothOp, typename LeftOp, typename RightOp, typename Out>
+        struct transform_union_chunk
+        {
+            typedef concepts::InfiniteRangeRunStorage<Left const> left_concept;
+            typedef concepts::InfiniteRangeRunStorage<Right const> right_concept;
+            typedef typename left_concept::offset_type offset_type;
+            typedef std::pair<offset_type, offset_type> run_type;
+            typedef run_value_subsequence<run_type, typename left_concept::value_type> left_run_type;
+            typedef run_value_subsequence<run_type, typename right_concept::value_type> right_run_type;
+            typedef range_run_subsequence<Left> left_type;
+            typedef range_run_subsequence<Right> right_type;
+
+            transform_union_chunk(
+                left_run_type const &left_pre
+              , left_type const &left
+              , left_run_type const &left_post
+              , right_run_type const &right_pre
+              , right_type const &right
+              , right_run_type const &right_post
+              , BothOp const &both_op
+              , LeftOp const &left_op
+              , RightOp const &right_op
+              , Out &out
+            )
+              : left_pre_(left_pre), left_(left), left_post_(left_post)
+              , right_pre_(right_pre), right_(right), right_post_(right_post)
+              , both_op_(both_op), left_op_(left_op), right_op_(right_op), out_(out)
+            {}
+
+            void operator ()() const
+            {
+                left_run_type left_pre(this->left_pre_), left_post(this->left_post_);
+                right_run_type right_pre(this->right_pre_), right_post(this->right_post_);
+                left_type left(this->left_);
+                right_type right(this->right_);
+                detail::transform_union(
+                    fusion::tie(left_pre, left, left_post)
+                  , fusion::tie(right_pre, right, right_post)
+                  , this->both_op_
+                  , this->left_op_
+                  , this->right_op_
+                  , this->out_
+                );
+            }
+
+        private:
+            left_run_type left_pre_;
+            left_type left_;
+            left_run_type left_post_;
+            right_run_type right_pre_;
+            right_type right_;
+            right_run_type right_post_;
+            BothOp const &both_op_;
+            LeftOp const &left_op_;
+            RightOp const &right_op_;
+            Out &out_;
+        };
+
+        // Runs a task, and saves whatever it throws so that the exception can be
+        // rethrown on the calling thread instead of escaping the thread function.
+        template<typename Task>
+        struct guarded_task
+        {
+            guarded_task(Task const &task, exception_ptr &error)
+              : task_(task), error_(error)
+            {}
+
+            void operator ()() const
+            {
+                try
+                {
+                    this->task_();
+                }
+                catch(...)
+                {
+                    this->error_ = boost::current_exception();
+                }
+            }
+
+        private:
+            Task const &task_;
+            exception_ptr &error_;
+        };
+
+        // Run each task on its own thread, and wait for them all. The threads are
+        // joined on every path, so they never outlive the buffers they write to,
+        // and then the first exception thrown by a task, if any, is rethrown.
+        template<typename Task>
+        void run_tasks(std::vector<Task> const &tasks)
+        {
+            std::vector<exception_ptr> errors(tasks.size());
+            thread_group threads;
+            try
+            {
+                for(std::size_t i = 1; i < tasks.size(); ++i)
+                {
+                    threads.create_thread(guarded_task<Task>(tasks[i], errors[i]));
+                }
+                if(!tasks.empty())
+                {
+                    guarded_task<Task>(tasks[0], errors[0])();
+                }
+            }
+            catch(...)
+            {
+                threads.join_all();
+                throw;
+            }
+            threads.join_all();
+
+            for(std::size_t i = 0; i != errors.size(); ++i)
+            {
+                if(errors[i])
+                {
+                    boost::rethrow_exception(errors[i]);
+                }
+            }
+        }
+
+        // Split [begin, end) into chunks of about the same number of runs
+        template<typename Cursor>
+        std::vector<Cursor> split_cursors(Cursor begin, Cursor end, std::size_t chunks)
+        {
+            typedef typename std::iterator_traits<Cursor>::difference_type difference_type;
+            difference_type const size = std::distance(begin, end);
+            std::vector<Cursor> splits(1, begin);
+            difference_type done = 0;
+            for(std::size_t i = 1; i < chunks; ++i)
+            {
+                difference_type const next = size * static_cast<difference_type>(i) / static_cast<difference_type>(chunks);
+                std::advance(begin, next - done);
+                done = next;
+                splits.push_back(begin);
+            }
+            splits.push_back(end);
+            return splits;
+        }
+
+        // The first run in [begin, end) that ends after offset
+        template<typename Cursor, typename Runs, typename Offset>
+        Cursor run_after(Cursor begin, Cursor end, Runs const &runs, Offset offset)
+        {
+            return detail::run_lower_bound(begin, end, runs, rrs::unit_run<Offset>(offset));
+        }
+
+        template<typename Left, typename Right, typename BothOp, typename LeftOp, typename RightOp, typename Out>
+        void parallel_transform_impl(
+            Left const &left
+          , Right const &right
+          , BothOp const &both_op
+          , LeftOp const &left_op
+          , RightOp const &right_op
+          , Out &out
+          , std::size_t chunks
+          , mpl::false_
+        )
+        {
+            rrs::transform(left, right, both_op, left_op, right_op, out);
+        }
+
+        template<typename Left, typename Right, typename BothOp, typename LeftOp, typename RightOp, typename Out>
+        void parallel_transform_impl(
+            Left const &left
+          , Right const &right
+          , BothOp const &both_op
+          , LeftOp const &left_op
+          , RightOp const &right_op
+          , Out &out
+          , std::size_t chunks
+          , mpl::true_
+        )
+        {
+            typedef concepts::InfiniteRangeRunStorage<Left const> left_concept;
+            typedef concepts::InfiniteRangeRunStorage<Right const> right_concept;
+            typedef typename left_concept::cursor left_cursor;
+            typedef typename right_concept::cursor right_cursor;
+            typedef typename left_concept::offset_type offset_type;
+            typedef typename result_of<BothOp(typename left_concept::value_type, typename right_concept::value_type)>::type result_type;
+            typedef run_buffer<offset_type, result_type> buffer_type;
+            typedef transform_union_chunk<Left, Right, BothOp, LeftOp, RightOp, buffer_type> task_type;
+
+            typedef typename task_type::run_type run_type;
+            typedef typename task_type::left_run_type left_run_type;
+            typedef typename task_type::right_run_type right_run_type;
+
+            if(chunks < 2)
+            {
+                rrs::transform(left, right, both_op, left_op, right_op, out);
+                return;
+            }
+
+            typename left_concept::runs left_runs = rrs::runs(left);
+            typename right_concept::runs right_runs = rrs::runs(right);
+            left_cursor const left_end = sequence::end(left);
+            right_cursor const right_end = sequence::end(right);
+
+            run_type const no_pre(-inf, -inf), no_post(inf, inf);
+            run_type const left_pre = rrs::empty(rrs::pre_run(left)) ? no_pre : rrs::run_cast<run_type>(rrs::pre_run(left));
+            run_type const left_post = rrs::empty(rrs::post_run(left)) ? no_post : rrs::run_cast<run_type>(rrs::post_run(left));
+            run_type const right_pre = rrs::empty(rrs::pre_run(right)) ? no_pre : rrs::run_cast<run_type>(rrs::pre_run(right));
+            run_type const right_post = rrs::empty(rrs::post_run(right)) ? no_post : rrs::run_cast<run_type>(rrs::post_run(right));
+
+            // The pre-runs go in the first chunk and the post-runs in the last, so
+            // the splits must fall between them.
+            offset_type const lo = (std::max)(rrs::end_offset(left_pre), rrs::end_offset(right_pre));
+            offset_type const hi = (std::min)(rrs::offset(left_post), rrs::offset(right_post));
+            if(!(lo < hi))
+            {
+                rrs::transform(left, right, both_op, left_op, right_op, out);
+                return;
+            }
+
+            // Split the left runs evenly, then move each split point forward until
+            // it does not cut a run of either input, so that the chunks are independent.
+            std::vector<left_cursor> left_splits(detail::split_cursors(sequence::begin(left), left_end, chunks));
+            std::vector<right_cursor> right_splits(1, sequence::begin(right));
+            offset_type split = lo;
+
+            for(std::size_t i = 1; i + 1 < left_splits.size(); ++i)
+            {
+                left_cursor l = left_splits[i - 1];
+                right_cursor r = right_splits.back();
+
+                if(left_splits[i] != left_end)
+                {
+                    split = (std::max)(split, rrs::offset(left_runs(*left_splits[i])));
+                }
+
+                for(bool moved = true; moved; )
+                {
+                    moved = false;
+                    r = detail::run_after(r, right_end, right_runs, split);
+                    if(r != right_end && rrs::offset(right_runs(*r)) < split)
+                    {
+                        split = rrs::end_offset(right_runs(*r));
+                        moved = true;
+                    }
+                    l = detail::run_after(l, left_end, left_runs, split);
+                    if(l != left_end && rrs::offset(left_runs(*l)) < split)
+                    {
+                        split = rrs::end_offset(left_runs(*l));
+                        moved = true;
+                    }
+                }
+
+                // Everything after hi belongs with the post-runs
+                if(split > hi || (l == left_end && r == right_end))
+                {
+                    left_splits.resize(i);
+                    left_splits.push_back(left_end);
+                    break;
+                }
+
+                left_splits[i] = l;
+                right_splits.push_back(r);
+            }
+            right_splits.push_back(right_end);
+
+            std::size_t const size = left_splits.size() - 1;
+            std::vector<buffer_type> buffers(size);
+            std::vector<task_type> tasks;
+            for(std::size_t i = 0; i != size; ++i)
+            {
+                tasks.push_back(task_type(
+                    left_run_type(i == 0 ? left_pre : no_pre, rrs::pre_value(left))
+                  , range_run_subsequence<Left>(left, left_splits[i], left_splits[i + 1])
+                  , left_run_type(i + 1 == size ? left_post : no_post, rrs::post_value(left))
+                  , right_run_type(i == 0 ? right_pre : no_pre, rrs::pre_value(right))
+                  , range_run_subsequence<Right>(right, right_splits[i], right_splits[i + 1])
+                  , right_run_type(i + 1 == size ? right_post : no_post, rrs::post_value(right))
+                  , both_op
+                  , left_op
+                  , right_op
+                  , buffers[i]
+                ));
+            }
+
+            detail::run_tasks(tasks);
+
+            for(std::size_t i = 0; i != size; ++i)
+            {
+                buffers[i].flush(out);
+            }
+        }
+
+        template<typename In, typename UnaryOp, typename Out>
+        void parallel_transform_impl(In const &in, UnaryOp const &fun, Out &out, std::size_t chunks)
+        {
+            typedef concepts::InfiniteRangeRunStorage<In const> in_concept;
+            typedef typename in_concept::cursor cursor_type;
+            typedef typename in_concept::offset_type offset_type;
+            typedef typename remove_cv<typename remove_reference<
+                typename result_of<UnaryOp(typename in_concept::value_type)>::type
+            >::type>::type result_type;
+            typedef run_buffer<offset_type, result_type> buffer_type;
+            typedef transform_chunk<In, UnaryOp, buffer_type> task_type;
+
+            if(chunks < 2)
+            {
+                detail::transform_impl(in, fun, out);
+                return;
+            }
+
+            typename in_concept::pre_run_type pre_run(rrs::pre_run(in));
+            if(!rrs::empty(pre_run))
+            {
+                rrs::set_at(out, pre_run, fun(rrs::pre_value(in)));
+            }
+
+            std::vector<cursor_type> splits(detail::split_cursors(sequence::begin(in), sequence::end(in), chunks));
+            std::vector<buffer_type> buffers(splits.size() - 1);
+            std::vector<task_type> tasks;
+            for(std::size_t i = 0; i != buffers.size(); ++i)
+            {
+                tasks.push_back(task_type(in, splits[i], splits[i + 1], fun, buffers[i]));
+            }
+
+            detail::run_tasks(tasks);
+
+            for(std::size_t i = 0; i != buffers.size(); ++i)
+            {
+                buffers[i].flush(out);
+            }
+
+            typename in_concept::post_run_type post_run(rrs::post_run(in));
+            if(!rrs::empty(post_run))
+            {
+                rrs::set_at(out, post_run, fun(rrs::post_value(in)));
+            }
+        }
+    }
+
+    /// \brief Multi-threaded \c transform.
+    ///
+    /// Computes the same result as the corresponding form of \c transform, using up to
+    /// \c threads threads. The runs of the input are split into \c threads chunks,
+    /// each chunk is transformed on its own thread into a private buffer, and the
+    /// buffers are then written to \c out in order on the calling thread. For the binary
+    /// forms, the chunks are chosen so that no run of either input crosses from one
+    /// chunk to the next, which requires integral offsets; with other offsets, or when
+    /// a pre- or post-run overlaps all of the other input, the binary forms run on the
+    /// calling thread only. If an operation throws on any thread, all the threads are
+    /// joined, and then the exception is rethrown on the calling thread; \c out is left
+    /// with whatever was written to it before the threads started.
+    ///
+    /// \param[in] in The input sequence.
+    /// \param[in] left The left input sequence.
+    /// \param[in] right The right input sequence.
+    /// \param unary_op A \c UnaryFunction used to transform the elements
+    ///         of the input sequence. It is called concurrently from several threads.
+    /// \param binary_op A \c BinaryFunction used to generate the output elements
+    ///         from the left and right elements. It is called concurrently from
+    ///         several threads.
+    /// \param[out] out An \c OrderedInserter into which the resulting sequence
+    ///         is written.
+    /// \param threads The number of threads to use.
+    /// \pre \c In is a model of \c InfiniteRangeRunStorage.
+    /// \pre \c Left is a model of \c InfiniteRangeRunStorage.
+    /// \pre \c Right is a model of \c InfiniteRangeRunStorage.
+    /// \pre \c UnaryOp is a model of \c UnaryFunction.
+    /// \pre \c BinaryOp is a model of \c BinaryFunction.
+    /// \pre \c Out is a model of \c OrderedInserter.
+    template<typename In, typename UnaryOp, typename Out>
+    Out &parallel_transform(In const &in, UnaryOp const &unary_op, Out &out, std::size_t threads)
+    {
+        detail::parallel_transform_impl(in, unary_op, out, threads);
+        return out;
+    }
+
+    /// \overload
+    ///
+    template<typename Left, typename Right, typename BinOp, typename Out>
+    Out &parallel_transform(Left const &left, Right const &right, BinOp const &binary_op, Out &out, std::size_t threads)
+    {
+        using concepts::InfiniteRangeRunStorage;
+
+        typedef typename InfiniteRangeRunStorage<Left const>::value_type left_value_type;
+        typedef typename InfiniteRangeRunStorage<Left const>::offset_type offset_type;
+        typedef typename InfiniteRangeRunStorage<Right const>::value_type right_value_type;
+
+        left_value_type const &left_zero(rrs::zero(left));
+        right_value_type const &right_zero(rrs::zero(right));
+
+        typedef typename result_of<BinOp(left_value_type, right_value_type)>::type result_type;
+
+        detail::parallel_transform_impl(
+            left
+          , right
+          , binary_op                                               // binary op
+          , boost::bind<result_type>(binary_op, ::_1, right_zero)   // left unary op
+          , boost::bind<result_type>(binary_op, left_zero, ::_1)    // right unary op
+          , out
+          , threads
+          , typename is_integral<offset_type>::type()
+        );
+
+        return out;
+    }
+
+    /// \brief Multi-threaded \c copy.
+    ///
+    /// Copies the runs and values from an \c InfiniteRangeRunStorage to an
+    /// \c OrderedInserter, reading the input on up to \c threads threads.
+    ///
+    /// \param[in] in An \c InfiniteRangeRunStorage from which to copy elements
+    ///     and values.
+    /// \param[out] out An \c OrderedInserter to receive the elements and values
+    /// \param threads The number of threads to use.
+    /// \return A reference to \c out.
+    /// \pre \c In is a model of \c InfiniteRangeRunStorage.
+    /// \pre \c Out is a model of \c OrderedInserter.
+    /// \attention You must call <tt>range_run_storage::commit()</tt> on the
+    ///     return value to commit the changes.
+    template<typename In, typename Out>
+    Out &parallel_copy(In const &in, Out &out, std::size_t threads)
+    {
+        detail::parallel_transform_impl(in, rrs::_1, out, threads);
+        return out;
+    }
+
+    /// \brief Multi-threaded \c for_each.
+    ///
+    /// Invokes the specified \c TernaryFunction for each (value, offset, end_offset)
+    /// tuple in an \c InfiniteRangeRunStorage. The finite runs are split into \c threads
+    /// chunks, and each chunk is visited in order on its own thread by its own copy
+    /// of \c fun. The pre- and post-runs are visited on the calling thread, before and
+    /// after the others. If \c fun throws on any thread, all the threads are joined, and
+    /// then the exception is rethrown on the calling thread.
+    ///
+    /// \param[in] in The input \c InfiniteRangeRunStorage.
+    /// \param fun A \c TernaryFunction to be invoked with each
+    ///     (value, offset, end_offset) tuple in the sequence.
+    /// \param threads The number of threads to use.
+    /// \pre \c In is a model of \c InfiniteRangeRunStorage.
+    /// \pre \c Fun is a model of \c TernaryFunction.
+    template<typename In, typename Fun>
+    void parallel_for_each(In const &in, Fun const &fun, std::size_t threads)
+    {
+        typedef concepts::InfiniteRangeRunStorage<In const> in_concept;
+        typedef typename in_concept::cursor cursor_type;
+        typedef detail::functor_inserter<Fun> inserter_type;
+        typedef detail::transform_chunk<In, placeholders_::first_, inserter_type> task_type;
+
+        inserter_type out(fun);
+        typename in_concept::pre_run_type pre_run(rrs::pre_run(in));
+        if(!rrs::empty(pre_run))
+        {
+            rrs::set_at(out, pre_run, rrs::pre_value(in));
+        }
+
+        std::vector<cursor_type> splits(detail::split_cursors(sequence::begin(in), sequence::end(in), threads));
+        std::vector<inserter_type> inserters(splits.size() - 1, out);
+        std::vector<task_type> tasks;
+        for(std::size_t i = 0; i != inserters.size(); ++i)
+        {
+            tasks.push_back(task_type(in, splits[i], splits[i + 1], rrs::_1, inserters[i]));
+        }
+
+        detail::run_tasks(tasks);
+
+        typename in_concept::post_run_type post_run(rrs::post_run(in));
+        if(!rrs::empty(post_run))
+        {
+            rrs::set_at(out, post_run, rrs::post_value(in));
+        }
+    }
+
+}}
+
+#endif
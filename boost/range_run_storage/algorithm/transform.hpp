@@ -23,6 +23,7 @@
 #include <boost/range_run_storage/algorithm/detail/transform.hpp>
 #include <boost/range_run_storage/algorithm/detail/transform_union.hpp>
 #include <boost/range_run_storage/algorithm/detail/transform_intersection.hpp>
+#include <boost/range_run_storage/algorithm/detail/transform_nary.hpp>
 
 namespace boost { namespace range_run_storage
 {
@@ -189,6 +190,53 @@ namespace boost { namespace range_run_storage
         return out;
     }
 
+    /// \brief Combine any number of \c InfiniteRangeRunStorage with a binary transform.
+    ///
+    /// <tt>transform_union(inputs, binary_op, out)</tt> steps through all the series in
+    /// \c inputs at once. Wherever at least one of them has a run, the values of all the
+    /// series at that offset are folded from left to right with \c binary_op, using
+    /// <tt>rrs::zero()</tt> for the series that have no run there, and the result is written
+    /// to \c out. With \c inputs <tt>{a, b, c}</tt> the result is the same as that of
+    /// transforming \c a and \c b, and then the result and \c c, but it takes a single pass
+    /// and builds no intermediate series. Each start or end of a run costs O(log k) for
+    /// k series.
+    ///
+    /// \param[in] inputs A range of series of the same type.
+    /// \param binary_op A \c BinaryFunction used to fold the values of the series.
+    /// \param[out] out An \c OrderedInserter into which the resulting sequence
+    ///         is written.
+    /// \pre The value type of \c Inputs is a model of \c InfiniteRangeRunStorage with
+    ///         integral offsets.
+    /// \pre \c BinOp is a model of \c BinaryFunction, and is associative.
+    /// \pre \c Out is a model of \c OrderedInserter.
+    template<typename Inputs, typename BinOp, typename Out>
+    Out &transform_union(Inputs const &inputs, BinOp const &binary_op, Out &out)
+    {
+        detail::transform_nary(inputs, binary_op, true, out);
+        return out;
+    }
+
+    /// \brief Combine any number of \c InfiniteRangeRunStorage with a binary transform,
+    ///     where they all have runs.
+    ///
+    /// Like \c transform_union, except that a result is written to \c out only where
+    /// every series in \c inputs has a run.
+    ///
+    /// \param[in] inputs A range of series of the same type.
+    /// \param binary_op A \c BinaryFunction used to fold the values of the series.
+    /// \param[out] out An \c OrderedInserter into which the resulting sequence
+    ///         is written.
+    /// \pre The value type of \c Inputs is a model of \c InfiniteRangeRunStorage with
+    ///         integral offsets.
+    /// \pre \c BinOp is a model of \c BinaryFunction, and is associative.
+    /// \pre \c Out is a model of \c OrderedInserter.
+    template<typename Inputs, typename BinOp, typename Out>
+    Out &transform_intersection(Inputs const &inputs, BinOp const &binary_op, Out &out)
+    {
+        detail::transform_nary(inputs, binary_op, false, out);
+        return out;
+    }
+
     template<typename In, typename UnaryOp>
     In &transform_inplace(In &in, UnaryOp const &unary_op)
     {
@@ -0,0 +1,64 @@
+// Copyright David Abrahams, Eric Niebler 2006. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_RANGE_RUN_STORAGE_SET_AT_OFFSETS_EAN_10_18_2026_HPP
+# define BOOST_RANGE_RUN_STORAGE_SET_AT_OFFSETS_EAN_10_18_2026_HPP
+
+# include <iterator>
+# include <boost/detail/function4.hpp>
+# include <boost/detail/pod_singleton.hpp>
+# include <boost/mpl/placeholders.hpp>
+# include <boost/sequence/tag.hpp>
+# include <boost/type_traits/remove_const.hpp>
+# include <boost/range_run_storage/set_at.hpp>
+# include <boost/range_run_storage/utility/unit_run.hpp>
+
+// set_at_offsets(o, begin, end, values) writes a unit run to an
+// OrderedInserter at each offset in the ascending range [begin, end), with
+// the corresponding value from values. Inserters that can take a whole
+// block at once specialize it; the default writes the runs one at a time
+// with set_at.
+
+namespace boost { namespace range_run_storage
+{
+
+/// INTERNAL ONLY
+namespace impl
+{
+    template<typename S, typename I, typename J, typename V, typename T = typename sequence::impl::tag<S>::type>
+    struct set_at_offsets
+    {
+        typedef void result_type;
+
+        result_type operator ()(S &s, I &begin, J &end, V &values) const
+        {
+            typedef typename remove_const<I>::type iterator_type;
+            typedef typename remove_const<V>::type value_iterator;
+            typedef typename std::iterator_traits<iterator_type>::value_type offset_type;
+            value_iterator value = values;
+            for(iterator_type i = begin; i != end; ++i, ++value)
+            {
+                unit_run<offset_type> run(*i);
+                range_run_storage::set_at(s, run, *value);
+            }
+        }
+    };
+}
+
+namespace op
+{
+    using mpl::_;
+
+    struct set_at_offsets
+      : boost::detail::function4<impl::set_at_offsets<_, _, _, _, sequence::impl::tag<_> > >
+    {};
+}
+
+namespace
+{
+    op::set_at_offsets const &set_at_offsets = boost::detail::pod_singleton<op::set_at_offsets>::instance;
+}
+
+}} // namespace boost::range_run_storage
+
+#endif // BOOST_RANGE_RUN_STORAGE_SET_AT_OFFSETS_EAN_10_18_2026_HPP
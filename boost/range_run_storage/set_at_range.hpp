@@ -0,0 +1,61 @@
+// Copyright David Abrahams, Eric Niebler 2006. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_RANGE_RUN_STORAGE_SET_AT_RANGE_EAN_10_18_2026_HPP
+# define BOOST_RANGE_RUN_STORAGE_SET_AT_RANGE_EAN_10_18_2026_HPP
+
+# include <boost/detail/function4.hpp>
+# include <boost/detail/pod_singleton.hpp>
+# include <boost/mpl/placeholders.hpp>
+# include <boost/sequence/tag.hpp>
+# include <boost/type_traits/remove_const.hpp>
+# include <boost/range_run_storage/set_at.hpp>
+# include <boost/range_run_storage/utility/unit_run.hpp>
+
+// set_at_range(o, offset, begin, end) writes the values in [begin, end) to
+// an OrderedInserter as consecutive unit runs starting at offset. Inserters
+// that can take a whole block at once specialize it; the default writes the
+// values one at a time with set_at.
+
+namespace boost { namespace range_run_storage
+{
+
+/// INTERNAL ONLY
+namespace impl
+{
+    template<typename S, typename O, typename I, typename J, typename T = typename sequence::impl::tag<S>::type>
+    struct set_at_range
+    {
+        typedef void result_type;
+
+        result_type operator ()(S &s, O &offset, I &begin, J &end) const
+        {
+            typedef typename remove_const<O>::type offset_type;
+            typedef typename remove_const<I>::type iterator_type;
+            offset_type off = offset;
+            for(iterator_type i = begin; i != end; ++i, ++off)
+            {
+                unit_run<offset_type> run(off);
+                range_run_storage::set_at(s, run, *i);
+            }
+        }
+    };
+}
+
+namespace op
+{
+    using mpl::_;
+
+    struct set_at_range
+      : boost::detail::function4<impl::set_at_range<_, _, _, _, sequence::impl::tag<_> > >
+    {};
+}
+
+namespace
+{
+    op::set_at_range const &set_at_range = boost::detail::pod_singleton<op::set_at_range>::instance;
+}
+
+}} // namespace boost::range_run_storage
+
+#endif // BOOST_RANGE_RUN_STORAGE_SET_AT_RANGE_EAN_10_18_2026_HPP
@@ -0,0 +1,440 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file binary_archive.hpp
+/// A native binary format for models of \c Mutable_InfiniteRangeRunStorage,
+/// with the offsets and values of the runs in contiguous blocks
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_RANGE_RUN_STORAGE_UTILITY_BINARY_ARCHIVE_EAN_10_18_2026_HPP
+#define BOOST_RANGE_RUN_STORAGE_UTILITY_BINARY_ARCHIVE_EAN_10_18_2026_HPP
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <boost/cstdint.hpp>
+#include <boost/implicit_cast.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/range_run_storage/set_at_range.hpp>
+#include <boost/range_run_storage/set_at_offsets.hpp>
+#include <boost/range_run_storage/utility/run_cast.hpp>
+
+namespace boost { namespace range_run_storage
+{
+
+    namespace detail
+    {
+        // The archive starts with a magic number and a version, then the
+        // sizes of an offset and a value and a set of flags, so that an
+        // archive is only read back into a storage of the same layout.
+        boost::uint32_t const binary_archive_magic = 0x73727262; // "brrs"
+        boost::uint32_t const binary_archive_version = 1;
+
+        enum binary_archive_flags
+        {
+            binary_archive_pre_run = 1      // the pre-run and its value follow the zero
+          , binary_archive_post_run = 2     // the post-run and its value follow the pre-run
+          , binary_archive_unit_runs = 4    // every run is a unit run; there is no block of ends
+          , binary_archive_contiguous = 8   // integral unit runs, each starting where the last ended; only the first start is stored
+        };
+
+        // A unit run has length 1 if the offsets are integral. If they are
+        // floating-point, a unit run is a point, as for unit_run<>: it ends
+        // where it starts.
+        template<typename Offset>
+        bool is_binary_unit_run(std::pair<Offset, Offset> const &run, mpl::false_)
+        {
+            return run.second == run.first + 1;
+        }
+
+        template<typename Offset>
+        bool is_binary_unit_run(std::pair<Offset, Offset> const &run, mpl::true_)
+        {
+            return run.second == run.first;
+        }
+
+        template<typename Offset>
+        Offset binary_unit_run_end(Offset start, mpl::false_)
+        {
+            return start + 1;
+        }
+
+        template<typename Offset>
+        Offset binary_unit_run_end(Offset start, mpl::true_)
+        {
+            return start;
+        }
+
+        // Whether the runs read from an archive are in order: unit runs at
+        // strictly increasing offsets, or other runs that each end after they
+        // start (or where they start, for floating-point offsets) and start
+        // no earlier than the one before ended. The comparisons are written
+        // so that a NaN offset fails them.
+        template<typename Offset>
+        bool binary_runs_in_order(std::vector<Offset> const &starts, std::vector<Offset> const &ends)
+        {
+            bool const points = is_floating_point<Offset>::value;
+            for(std::size_t i = 0; i != starts.size(); ++i)
+            {
+                if(ends.empty())
+                {
+                    if(0 != i && !(starts[i - 1] < starts[i]))
+                    {
+                        return false;
+                    }
+                }
+                else if(points ? !(starts[i] <= ends[i]) : !(starts[i] < ends[i]))
+                {
+                    return false;
+                }
+                else if(0 != i && !(ends[i - 1] <= starts[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Each field and each block is padded with zero bytes to a multiple
+        // of binary_archive_alignment bytes, so that an archive mapped into
+        // memory has its fields and blocks aligned.
+        std::size_t const binary_archive_alignment = 8;
+
+        inline std::size_t binary_archive_padding(std::size_t size)
+        {
+            return (binary_archive_alignment - size % binary_archive_alignment) % binary_archive_alignment;
+        }
+
+        inline void write_padding(std::ostream &os, std::size_t size)
+        {
+            char const zeros[binary_archive_alignment] = {};
+            os.write(zeros, detail::binary_archive_padding(size));
+        }
+
+        inline bool read_padding(std::istream &is, std::size_t size)
+        {
+            char padding[binary_archive_alignment];
+            std::size_t const count = detail::binary_archive_padding(size);
+            return 0 == count || is.read(padding, count).good();
+        }
+
+        template<typename T>
+        void write_binary(std::ostream &os, T const &t)
+        {
+            os.write(reinterpret_cast<char const *>(&t), sizeof(T));
+            detail::write_padding(os, sizeof(T));
+        }
+
+        template<typename T>
+        void write_block(std::ostream &os, std::vector<T> const &block)
+        {
+            if(!block.empty())
+            {
+                os.write(reinterpret_cast<char const *>(&block[0]), block.size() * sizeof(T));
+                detail::write_padding(os, block.size() * sizeof(T));
+            }
+        }
+
+        template<typename T>
+        bool read_binary(std::istream &is, T &t)
+        {
+            return is.read(reinterpret_cast<char *>(&t), sizeof(T)).good()
+                && detail::read_padding(is, sizeof(T));
+        }
+
+        // The block is read in chunks of at most 64 KiB, so that the count of
+        // a corrupt archive makes the read fail where the stream runs out,
+        // rather than allocating room for the whole count first.
+        template<typename T>
+        bool read_block(std::istream &is, std::vector<T> &block, boost::uint64_t size)
+        {
+            block.clear();
+            if(size > block.max_size())
+            {
+                return false;
+            }
+
+            std::size_t const chunk = (std::max)(std::size_t(1), std::size_t(65536) / sizeof(T));
+            while(block.size() != size)
+            {
+                std::size_t const done = block.size();
+                std::size_t const count = static_cast<std::size_t>((std::min)(boost::uint64_t(chunk), size - done));
+                block.resize(done + count);
+                if(!is.read(reinterpret_cast<char *>(&block[done]), count * sizeof(T)).good())
+                {
+                    return false;
+                }
+            }
+
+            return detail::read_padding(is, block.size() * sizeof(T));
+        }
+    }
+
+    /// \brief Write a storage to a stream in a native binary format.
+    ///
+    /// The archive is a header holding the zero, the pre- and post-runs with
+    ///     their values, and the number of runs, followed by a block of the
+    ///     starts of the runs, a block of their ends, and a block of their
+    ///     values. Each block is written with one call to \c write(). The ends
+    ///     are left out when every run is a unit run, and the starts too when
+    ///     the runs are also contiguous, as in a dense storage.
+    ///
+    /// With integral offsets, a unit run is a run of length 1. With
+    ///     floating-point offsets it is a run that ends where it starts, which
+    ///     is how a sparse storage with floating-point offsets reports its
+    ///     runs; such runs are never stored as contiguous.
+    ///
+    /// In order, the archive holds:
+    ///     - the magic number <tt>0x73727262</tt> and the version 1, as
+    ///       \c uint32_t;
+    ///     - the sizes of an offset and of a value, and the flags, as \c uint8_t;
+    ///     - the zero;
+    ///     - if the flags hold 1, the start and end of the pre-run, and its value;
+    ///     - if the flags hold 2, the start and end of the post-run, and its value;
+    ///     - the number of runs \em n, as \c uint64_t;
+    ///     - if the flags hold 8, the start of the first run, the others following
+    ///       on at intervals of 1; otherwise the \em n starts, and unless the
+    ///       flags hold 4, the \em n ends;
+    ///     - the \em n values.
+    ///
+    ///     Each field and each block is padded with zero bytes to a multiple of
+    ///     8 bytes, so a mapped archive has its blocks aligned; see
+    ///     \c mapped_dense_series\<\> and \c mapped_sparse_series\<\>.
+    ///
+    /// The format is that of the machine: it stores offsets and values as
+    ///     their bytes, in the byte order of the machine, and is meant for fast
+    ///     snapshots rather than for exchange. Unlike serialization through
+    ///     Boost.Serialization, the discretization of a series is not stored.
+    ///
+    /// \param os The stream to write to, opened in binary mode.
+    /// \param storage The storage to write.
+    /// \pre The \c value_type and \c offset_type of the storage are POD types.
+    template<typename Storage>
+    void save_binary(std::ostream &os, Storage const &storage)
+    {
+        namespace seq = sequence;
+        namespace rrs = range_run_storage;
+        typedef concepts::InfiniteRangeRunStorage<Storage const> storage_concept;
+        typedef typename storage_concept::value_type value_type;
+        typedef typename storage_concept::offset_type offset_type;
+        typedef typename storage_concept::cursor cursor_type;
+        typedef std::pair<offset_type, offset_type> run_type;
+
+        BOOST_MPL_ASSERT((is_pod<value_type>));
+        BOOST_MPL_ASSERT((is_pod<offset_type>));
+
+        // gather the runs into columns
+        std::vector<offset_type> starts;
+        std::vector<offset_type> ends;
+        std::vector<value_type> values;
+        bool unit_runs = true;
+        bool contiguous = true;
+
+        typename storage_concept::runs runs = rrs::runs(storage);
+        typename storage_concept::elements elements = seq::elements(storage);
+        cursor_type end = seq::end(storage);
+        for(cursor_type begin = seq::begin(storage); begin != end; ++begin)
+        {
+            run_type const run = rrs::run_cast<run_type>(runs(*begin));
+            unit_runs = unit_runs && detail::is_binary_unit_run(run, is_floating_point<offset_type>());
+            contiguous = contiguous && (ends.empty() || ends.back() == run.first);
+            starts.push_back(run.first);
+            ends.push_back(run.second);
+            values.push_back(elements(*begin));
+        }
+
+        run_type const pre_run = rrs::run_cast<run_type>(rrs::pre_run(storage));
+        run_type const post_run = rrs::run_cast<run_type>(rrs::post_run(storage));
+
+        boost::uint8_t flags = 0;
+        flags |= pre_run.first != pre_run.second ? detail::binary_archive_pre_run : 0;
+        flags |= post_run.first != post_run.second ? detail::binary_archive_post_run : 0;
+        flags |= unit_runs ? detail::binary_archive_unit_runs : 0;
+        flags |= unit_runs && contiguous && !starts.empty() && !is_floating_point<offset_type>::value
+          ? detail::binary_archive_contiguous
+          : 0;
+
+        // the header
+        detail::write_binary(os, detail::binary_archive_magic);
+        detail::write_binary(os, detail::binary_archive_version);
+        detail::write_binary(os, static_cast<boost::uint8_t>(sizeof(offset_type)));
+        detail::write_binary(os, static_cast<boost::uint8_t>(sizeof(value_type)));
+        detail::write_binary(os, flags);
+        detail::write_binary(os, implicit_cast<value_type const &>(rrs::zero(storage)));
+
+        if(flags & detail::binary_archive_pre_run)
+        {
+            detail::write_binary(os, pre_run.first);
+            detail::write_binary(os, pre_run.second);
+            detail::write_binary(os, implicit_cast<value_type const &>(rrs::pre_value(storage)));
+        }
+
+        if(flags & detail::binary_archive_post_run)
+        {
+            detail::write_binary(os, post_run.first);
+            detail::write_binary(os, post_run.second);
+            detail::write_binary(os, implicit_cast<value_type const &>(rrs::post_value(storage)));
+        }
+
+        detail::write_binary(os, static_cast<boost::uint64_t>(values.size()));
+
+        // the blocks
+        if(flags & detail::binary_archive_contiguous)
+        {
+            detail::write_binary(os, starts.front());
+        }
+        else
+        {
+            detail::write_block(os, starts);
+            if(!unit_runs)
+            {
+                detail::write_block(os, ends);
+            }
+        }
+
+        detail::write_block(os, values);
+    }
+
+    /// \brief Read a storage written by \c save_binary().
+    ///
+    /// Each block is read with one call to \c read() per chunk of at most
+    ///     64 KiB, and grows only as its chunks arrive, so a corrupt count of
+    ///     runs in the header cannot force a huge allocation: the read fails
+    ///     when the stream ends instead. The blocks are handed to the
+    ///     ordered inserter of the storage in bulk, with \c set_at_range()
+    ///     for contiguous unit runs and \c set_at_offsets() for other unit
+    ///     runs, so a dense or sparse storage fills its arrays directly.
+    ///
+    /// The runs are checked to be in order before any of them is written:
+    ///     unit runs must start at strictly increasing offsets, and other runs
+    ///     must not be empty or overlap, nor overlap the pre- and post-runs.
+    ///
+    /// \param is The stream to read from, opened in binary mode.
+    /// \param storage The storage to read into. Its runs are replaced.
+    /// \pre The \c value_type and \c offset_type of the storage are POD types.
+    /// \return \c true on success. If the stream does not hold an archive of
+    ///     a storage with the same sizes of offsets and values, ends before
+    ///     the number of runs in the header have been read, or holds runs out
+    ///     of order, sets \c failbit on the stream, leaves \c storage
+    ///     unchanged, and returns \c false.
+    template<typename Storage>
+    bool load_binary(std::istream &is, Storage &storage)
+    {
+        namespace rrs = range_run_storage;
+        typedef concepts::Mutable_InfiniteRangeRunStorage<Storage> storage_concept;
+        typedef typename storage_concept::value_type value_type;
+        typedef typename storage_concept::offset_type offset_type;
+        typedef typename storage_concept::ordered_inserter_type ordered_inserter_type;
+        typedef std::pair<offset_type, offset_type> run_type;
+
+        BOOST_MPL_ASSERT((is_pod<value_type>));
+        BOOST_MPL_ASSERT((is_pod<offset_type>));
+
+        boost::uint32_t magic = 0, version = 0;
+        boost::uint8_t offset_size = 0, value_size = 0, flags = 0;
+        value_type zero, pre_value, post_value;
+        run_type pre_run, post_run;
+        boost::uint64_t size = 0;
+        std::vector<offset_type> starts;
+        std::vector<offset_type> ends;
+        std::vector<value_type> values;
+
+        bool good = detail::read_binary(is, magic)
+            && detail::read_binary(is, version)
+            && detail::read_binary(is, offset_size)
+            && detail::read_binary(is, value_size)
+            && detail::read_binary(is, flags)
+            && detail::binary_archive_magic == magic
+            && detail::binary_archive_version == version
+            && sizeof(offset_type) == offset_size
+            && sizeof(value_type) == value_size
+            && detail::read_binary(is, zero)
+            && (!(flags & detail::binary_archive_pre_run)
+                || (detail::read_binary(is, pre_run.first)
+                    && detail::read_binary(is, pre_run.second)
+                    && detail::read_binary(is, pre_value)))
+            && (!(flags & detail::binary_archive_post_run)
+                || (detail::read_binary(is, post_run.first)
+                    && detail::read_binary(is, post_run.second)
+                    && detail::read_binary(is, post_value)))
+            && detail::read_binary(is, size);
+
+        if(good && (flags & detail::binary_archive_contiguous))
+        {
+            starts.resize(1);
+            good = detail::read_binary(is, starts[0]);
+        }
+        else if(good)
+        {
+            good = detail::read_block(is, starts, size)
+                && ((flags & detail::binary_archive_unit_runs) || detail::read_block(is, ends, size));
+        }
+
+        good = good && detail::read_block(is, values, size);
+
+        if(good && !(flags & detail::binary_archive_contiguous))
+        {
+            good = detail::binary_runs_in_order(starts, ends);
+        }
+
+        if(good && !values.empty())
+        {
+            offset_type const last_end = (flags & detail::binary_archive_contiguous)
+              ? static_cast<offset_type>(starts[0] + values.size())
+              : ends.empty()
+                ? detail::binary_unit_run_end(starts.back(), is_floating_point<offset_type>())
+                : ends.back();
+            good = (!(flags & detail::binary_archive_pre_run) || pre_run.second <= starts.front())
+                && (!(flags & detail::binary_archive_post_run) || last_end <= post_run.first);
+        }
+
+        if(!good)
+        {
+            is.setstate(std::ios::failbit);
+            return false;
+        }
+
+        rrs::zero(storage, zero);
+        ordered_inserter_type oi = rrs::ordered_inserter(storage);
+
+        if(flags & detail::binary_archive_pre_run)
+        {
+            rrs::set_at(oi, pre_run, pre_value);
+        }
+
+        if(flags & detail::binary_archive_contiguous)
+        {
+            rrs::set_at_range(oi, starts[0], values.begin(), values.end());
+        }
+        else if(flags & detail::binary_archive_unit_runs)
+        {
+            rrs::set_at_offsets(oi, starts.begin(), starts.end(), values.begin());
+        }
+        else
+        {
+            for(std::size_t i = 0; i != values.size(); ++i)
+            {
+                rrs::set_at(oi, run_type(starts[i], ends[i]), values[i]);
+            }
+        }
+
+        if(flags & detail::binary_archive_post_run)
+        {
+            rrs::set_at(oi, post_run, post_value);
+        }
+
+        rrs::commit(oi);
+        return true;
+    }
+
+}}
+
+#endif // BOOST_RANGE_RUN_STORAGE_UTILITY_BINARY_ARCHIVE_EAN_10_18_2026_HPP
@@ -51,6 +51,20 @@ namespace boost { namespace range_run_storage
             }
         }
 
+        // The runs of storage in [begin, end)
+        range_run_subsequence(RRS const &storage, cursor_type begin, cursor_type end)
+          : subrun_()
+          , elements_(seq::elements(storage))
+          , runs_(rrs::runs(storage))
+          , begin_(begin)
+          , end_(end)
+        {
+            if(this->begin_ != this->end_)
+            {
+                this->subrun_ = rrs::subrun(this->runs_(*this->begin_));
+            }
+        }
+
         void next()
         {
             BOOST_ASSERT(this->begin_ != this->end_);
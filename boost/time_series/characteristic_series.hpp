@@ -69,8 +69,8 @@ namespace boost { namespace time_series
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<characteristic_storage_tag, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<characteristic_storage_tag, Value, Discretization, Offset, Allocator>
         {
             typedef characteristic_unit_series<Value, Discretization, Offset> type;
         };
@@ -145,8 +145,8 @@ namespace boost { namespace time_series
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<scaled_storage_tag<characteristic_storage_tag>, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<scaled_storage_tag<characteristic_storage_tag>, Value, Discretization, Offset, Allocator>
         {
             typedef characteristic_series<Value, Discretization, Offset> type;
         };
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file compressed_sparse_series.hpp
+/// A time series that uses compressed sparse storage
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_COMPRESSED_SPARSE_SERIES_HPP_EAN_10_18_2026
+#define BOOST_TIME_SERIES_COMPRESSED_SPARSE_SERIES_HPP_EAN_10_18_2026
+
+#include <boost/time_series/time_series_facade.hpp>
+#include <boost/time_series/storage/compressed_sparse_array.hpp>
+
+namespace boost { namespace time_series
+{
+
+    /// \brief A \c Mutable_TimeSeries that has an arbitrary number of runs of arbitrary value and unit length,
+    ///     stored compressed.
+    ///
+    /// A \c Mutable_TimeSeries that has an arbitrary number of runs of arbitrary value and unit length,
+    /// like \c sparse_series\<\>, for an integral \c Offset and a POD \c Value of at most 8 bytes.
+    /// The offsets are encoded as the change in the distance between neighbouring runs, and the
+    /// values as the XOR of their bits with those of the value before, in blocks of 128 runs.
+    /// Regular ticks with slowly changing values take a few bits per run. Reading the runs in
+    /// order decodes them as it goes; random access finds the block by binary search and decodes
+    /// from its start. Runs must be written in order, through an \c ordered_inserter\<\>.
+    ///
+    /// The named parameters for the constructor are, in order:
+    ///   -# \c discretization, with a default of \c Discretization(1)
+    ///   -# \c zero, with a default of \c Value(0)
+    template<typename Value, typename Discretization, typename Offset>
+    struct compressed_sparse_series
+      : time_series_facade<
+            compressed_sparse_series<Value, Discretization, Offset>
+          , storage::compressed_sparse_array<Value, Offset>
+          , Discretization
+        >
+    {
+        typedef time_series_facade<
+            compressed_sparse_series<Value, Discretization, Offset>
+          , storage::compressed_sparse_array<Value, Offset>
+          , Discretization
+        > base_type;
+
+        using base_type::operator=;
+
+        BOOST_TIME_SERIES_DEFINE_CTORS(compressed_sparse_series)
+    };
+
+    namespace traits
+    {
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset>
+        struct storage_category<compressed_sparse_series<Value, Discretization, Offset> >
+          : storage_category<storage::compressed_sparse_array<Value, Offset> >
+        {};
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset>
+        struct discretization_type<compressed_sparse_series<Value, Discretization, Offset> >
+        {
+            typedef Discretization type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset>
+        struct offset_type<compressed_sparse_series<Value, Discretization, Offset> >
+        {
+            typedef Offset type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<compressed_sparse_storage_tag, Value, Discretization, Offset, Allocator>
+        {
+            typedef compressed_sparse_series<Value, Discretization, Offset> type;
+        };
+    }
+
+}}
+
+namespace boost { namespace sequence { namespace impl
+{
+    /// INTERNAL ONLY
+    template<typename Value, typename Discretization, typename Offset>
+    struct tag<time_series::compressed_sparse_series<Value, Discretization, Offset> >
+    {
+        typedef time_series_tag type;
+    };
+}}}
+
+namespace boost { namespace constructors { namespace impl
+{
+    /// INTERNAL ONLY
+    struct compressed_sparse_series_tag;
+
+    /// INTERNAL ONLY
+    template<typename Value, typename Discretization, typename Offset>
+    struct tag<time_series::compressed_sparse_series<Value, Discretization, Offset> >
+    {
+        typedef compressed_sparse_series_tag type;
+    };
+
+    /// INTERNAL ONLY
+    template<typename T>
+    struct construct<T, compressed_sparse_series_tag>
+      : arg_pack_construct
+    {
+        typedef parameter::parameters<
+            parameter::optional<time_series::tag::discretization>
+          , parameter::optional<time_series::tag::zero>
+        > args_type;
+    };
+
+}}}
+
+#endif
@@ -65,8 +65,8 @@ namespace boost { namespace time_series
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<constant_storage_tag, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<constant_storage_tag, Value, Discretization, Offset, Allocator>
         {
             typedef constant_series<Value, Discretization, Offset> type;
         };
@@ -68,8 +68,8 @@ namespace boost { namespace time_series
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<delta_storage_tag, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<delta_storage_tag, Value, Discretization, Offset, Allocator>
         {
             typedef delta_unit_series<Value, Discretization, Offset> type;
         };
@@ -143,8 +143,8 @@ namespace boost { namespace time_series
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<scaled_storage_tag<delta_storage_tag>, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<scaled_storage_tag<delta_storage_tag>, Value, Discretization, Offset, Allocator>
         {
             typedef delta_series<Value, Discretization, Offset> type;
         };
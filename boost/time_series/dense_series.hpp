@@ -13,6 +13,8 @@
 #include <boost/mpl/assert.hpp>
 #include <boost/type_traits/is_same.hpp>
 #include <boost/time_series/time_series_facade.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/traits/allocator_type.hpp>
 #include <boost/time_series/storage/dense_array.hpp>
 
 namespace boost { namespace time_series
@@ -31,23 +33,36 @@ namespace boost { namespace time_series
     ///   -# \c value, with a default of the \c zero named parameter
     ///   -# \c discretization, with a default of \c Discretization(1)
     ///   -# \c zero, with a default of \c Value(0)
-    template<typename Value, typename Discretization>
+    ///   -# \c allocator, with a default of \c Allocator()
+    ///
+    /// The buffer, and the copy made by an \c ordered_inserter\<\>, are allocated
+    /// with a copy of the \c allocator named parameter.
+    template<typename Value, typename Discretization, typename Allocator>
     struct dense_series
       : time_series_facade<
-            dense_series<Value, Discretization>
-          , storage::dense_array<Value>
+            dense_series<Value, Discretization, Allocator>
+          , storage::dense_array<Value, Allocator>
           , Discretization
         >
     {
         typedef time_series_facade<
-            dense_series<Value, Discretization>
-          , storage::dense_array<Value>
+            dense_series<Value, Discretization, Allocator>
+          , storage::dense_array<Value, Allocator>
           , Discretization
         > base_type;
 
+        typedef Allocator allocator_type;
+
         using base_type::operator=;
 
         BOOST_TIME_SERIES_DEFINE_CTORS(dense_series)
+
+        /// \return A copy of the allocator of the series' storage.
+        /// \throw nothrow
+        allocator_type get_allocator() const
+        {
+            return allocator_type(detail::time_series_facade_access::data(*this).get_allocator());
+        }
     };
 
     /// \brief Fetch a raw pointer to the internal dense storage of a \c dense_series\<\>
@@ -58,56 +73,103 @@ namespace boost { namespace time_series
     ///     \c std::size_t with the number of elements in the buffer. If the \c dense_series\<\>
     ///     is empty, the returned pointer is 0 and the returned size is 0.
     /// \throw nothrow
-    template<typename Value, typename Discretization>
+    template<typename Value, typename Discretization, typename Allocator>
     inline std::pair<Value *, std::size_t>
-    get_raw_buffer(dense_series<Value, Discretization> &series)
+    get_raw_buffer(dense_series<Value, Discretization, Allocator> &series)
     {
         typedef detail::time_series_facade_access access;
         typedef std::pair<Value *, std::size_t> buffer_type;
-        storage::dense_array<Value> &data = access::data(series);
+        storage::dense_array<Value, Allocator> &data = access::data(series);
         return data.empty() ? buffer_type(0, 0) : buffer_type(&*data.begin(), data.size());
     }
 
     /// \overload
     ///
-    template<typename Value, typename Discretization>
+    template<typename Value, typename Discretization, typename Allocator>
     inline std::pair<Value const *, std::size_t>
-    get_raw_buffer(dense_series<Value, Discretization> const &series)
+    get_raw_buffer(dense_series<Value, Discretization, Allocator> const &series)
     {
         typedef detail::time_series_facade_access access;
         typedef std::pair<Value const *, std::size_t> buffer_type;
-        storage::dense_array<Value> const &data = access::data(series);
+        storage::dense_array<Value, Allocator> const &data = access::data(series);
         return data.empty() ? buffer_type(0, 0) : buffer_type(&*data.begin(), data.size());
     }
 
+    /// \brief Creates an \c ordered_inserter\<\> that appends to a \c dense_series\<\>
+    ///
+    /// Creates an \c ordered_inserter\<\> that appends to a \c dense_series\<\>
+    /// rather than replacing its contents. Runs that land at or after the end of
+    /// the dense storage are collected by the inserter and copied onto the end of
+    /// the series' buffer on \c commit(), so appending to a long series does not
+    /// copy it. The first run that lands before the end of the dense storage
+    /// causes the series to be copied, and the copy is swapped in on \c commit().
+    ///
+    /// As with \c make_ordered_inserter(), the series is not changed before
+    /// \c commit(). If the inserter is destroyed without being committed, or
+    /// \c commit() throws, the series keeps its old contents.
+    ///
+    /// \param series The series to append to.
+    /// \param offset The offset of the first run written into the resulting inserter,
+    ///     if the offset of that run is not otherwise specified.
+    /// \return An \c ordered_inserter\<\> in append mode.
+    template<typename Value, typename Discretization, typename Allocator, typename Offset>
+    inline ordered_inserter<dense_series<Value, Discretization, Allocator> >
+    make_append_inserter(dense_series<Value, Discretization, Allocator> &series, Offset offset)
+    {
+        typedef detail::time_series_facade_access access;
+        return ordered_inserter<dense_series<Value, Discretization, Allocator> >(
+            storage::dense_ordered_inserter<Value, Allocator>(access::data(series), storage::append_mode)
+          , offset
+        );
+    }
+
+    /// \overload
+    ///
+    template<typename Value, typename Discretization, typename Allocator>
+    inline ordered_inserter<dense_series<Value, Discretization, Allocator> >
+    make_append_inserter(dense_series<Value, Discretization, Allocator> &series)
+    {
+        typedef detail::time_series_facade_access access;
+        return ordered_inserter<dense_series<Value, Discretization, Allocator> >(
+            storage::dense_ordered_inserter<Value, Allocator>(access::data(series), storage::append_mode)
+        );
+    }
+
     namespace traits
     {
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization>
-        struct storage_category<dense_series<Value, Discretization> >
-          : storage_category<storage::dense_array<Value> >
+        template<typename Value, typename Discretization, typename Allocator>
+        struct storage_category<dense_series<Value, Discretization, Allocator> >
+          : storage_category<storage::dense_array<Value, Allocator> >
         {};
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization>
-        struct discretization_type<dense_series<Value, Discretization> >
+        template<typename Value, typename Discretization, typename Allocator>
+        struct discretization_type<dense_series<Value, Discretization, Allocator> >
         {
             typedef Discretization type;
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization>
-        struct offset_type<dense_series<Value, Discretization> >
+        template<typename Value, typename Discretization, typename Allocator>
+        struct offset_type<dense_series<Value, Discretization, Allocator> >
         {
             typedef std::ptrdiff_t type;
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<dense_storage_tag, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Allocator>
+        struct allocator_type<dense_series<Value, Discretization, Allocator> >
+        {
+            typedef Allocator type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<dense_storage_tag, Value, Discretization, Offset, Allocator>
         {
             BOOST_MPL_ASSERT((is_same<Offset, std::ptrdiff_t>));
-            typedef dense_series<Value, Discretization> type;
+            typedef dense_series<Value, Discretization, Allocator> type;
         };
     }
 
@@ -116,8 +178,8 @@ namespace boost { namespace time_series
 namespace boost { namespace sequence { namespace impl
 {
     /// INTERNAL ONLY
-    template<typename Value, typename Discretization>
-    struct tag<time_series::dense_series<Value, Discretization> >
+    template<typename Value, typename Discretization, typename Allocator>
+    struct tag<time_series::dense_series<Value, Discretization, Allocator> >
     {
         typedef time_series_tag type;
     };
@@ -129,8 +191,8 @@ namespace boost { namespace constructors { namespace impl
     struct dense_series_tag;
 
     /// INTERNAL ONLY
-    template<typename Value, typename Discretization>
-    struct tag<time_series::dense_series<Value, Discretization> >
+    template<typename Value, typename Discretization, typename Allocator>
+    struct tag<time_series::dense_series<Value, Discretization, Allocator> >
     {
         typedef dense_series_tag type;
     };
@@ -146,6 +208,7 @@ namespace boost { namespace constructors { namespace impl
           , parameter::optional<time_series::tag::value>
           , parameter::optional<time_series::tag::discretization>
           , parameter::optional<time_series::tag::zero>
+          , parameter::optional<time_series::tag::allocator>
         > args_type;
     };
 
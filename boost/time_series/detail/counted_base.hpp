@@ -8,7 +8,6 @@
 #define BOOST_TIME_SERIES_DETAIL_COUNTED_BASE_HPP_EAN_06_17_2006
 
 #include <boost/assert.hpp>
-#include <boost/checked_delete.hpp>
 #include <boost/detail/atomic_count.hpp>
 
 namespace boost { namespace time_series { namespace detail
@@ -60,7 +59,7 @@ namespace boost { namespace time_series { namespace detail
             BOOST_ASSERT(0 < that->count_);
             if(0 == --that->count_)
             {
-                boost::checked_delete(static_cast<Derived const *>(that));
+                Derived::destroy(static_cast<Derived const *>(that));
             }
         }
     };
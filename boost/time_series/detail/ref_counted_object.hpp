@@ -7,40 +7,56 @@
 #ifndef BOOST_TIME_SERIES_DETAIL_REF_COUNTED_OBJECT_HPP_EAN_06_17_2006
 #define BOOST_TIME_SERIES_DETAIL_REF_COUNTED_OBJECT_HPP_EAN_06_17_2006
 
+#include <memory>
 #include <boost/time_series/detail/counted_base.hpp>
 
 namespace boost { namespace time_series { namespace detail
 {
-    template<typename T>
+    // ref_counted_object
+    //   Created with create(), in memory from a copy of alloc, and given back
+    //   to that allocator when the last reference goes away.
+    template<typename T, typename Allocator = std::allocator<T> >
     struct ref_counted_object
-      : counted_base<ref_counted_object<T> >
+      : counted_base<ref_counted_object<T, Allocator> >
     {
-        ref_counted_object()
-          : obj_()
-        {}
-
-        ref_counted_object(ref_counted_object const &that)
-          : obj_(that.obj_)
-        {}
-
-        explicit ref_counted_object(T const &obj)
-          : obj_(obj)
-        {}
+        static ref_counted_object *create(Allocator const &alloc)
+        {
+            ref_counted_object *that = ref_counted_object::allocate_(alloc);
+            try
+            {
+                ::new(static_cast<void *>(that)) ref_counted_object(alloc);
+            }
+            catch(...)
+            {
+                ref_counted_object::deallocate_(alloc, that);
+                throw;
+            }
+            return that;
+        }
 
         template<typename A0>
-        explicit ref_counted_object(A0 const &a0)
-          : obj_(a0)
-        {}
-
-        template<typename A0, typename A1>
-        ref_counted_object(A0 const &a0, A1 const &a1)
-          : obj_(a0, a1)
-        {}
+        static ref_counted_object *create(Allocator const &alloc, A0 const &a0)
+        {
+            ref_counted_object *that = ref_counted_object::allocate_(alloc);
+            try
+            {
+                ::new(static_cast<void *>(that)) ref_counted_object(alloc, a0);
+            }
+            catch(...)
+            {
+                ref_counted_object::deallocate_(alloc, that);
+                throw;
+            }
+            return that;
+        }
 
-        template<typename A0, typename A1, typename A2>
-        ref_counted_object(A0 const &a0, A1 const &a1, A2 const &a2)
-          : obj_(a0, a1, a2)
-        {}
+        static void destroy(ref_counted_object const *that)
+        {
+            Allocator const alloc(that->alloc_);
+            ref_counted_object *p = const_cast<ref_counted_object *>(that);
+            p->~ref_counted_object();
+            ref_counted_object::deallocate_(alloc, p);
+        }
 
         T &get()
         {
@@ -51,7 +67,34 @@ namespace boost { namespace time_series { namespace detail
         {
             return this->obj_;
         }
+
     private:
+        typedef typename Allocator::template rebind<ref_counted_object>::other node_allocator;
+
+        explicit ref_counted_object(Allocator const &alloc)
+          : alloc_(alloc)
+          , obj_()
+        {}
+
+        template<typename A0>
+        ref_counted_object(Allocator const &alloc, A0 const &a0)
+          : alloc_(alloc)
+          , obj_(a0)
+        {}
+
+        static ref_counted_object *allocate_(Allocator const &alloc)
+        {
+            node_allocator nodes(alloc);
+            return nodes.allocate(1);
+        }
+
+        static void deallocate_(Allocator const &alloc, ref_counted_object *that)
+        {
+            node_allocator nodes(alloc);
+            nodes.deallocate(that, 1);
+        }
+
+        Allocator alloc_;
         T obj_;
     };
 
@@ -68,8 +68,8 @@ namespace boost { namespace time_series
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<inverse_heaviside_storage_tag, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<inverse_heaviside_storage_tag, Value, Discretization, Offset, Allocator>
         {
             typedef inverse_heaviside_unit_series<Value, Discretization, Offset> type;
         };
@@ -143,8 +143,8 @@ namespace boost { namespace time_series
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<scaled_storage_tag<inverse_heaviside_storage_tag>, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<scaled_storage_tag<inverse_heaviside_storage_tag>, Value, Discretization, Offset, Allocator>
         {
             typedef inverse_heaviside_series<Value, Discretization, Offset> type;
         };
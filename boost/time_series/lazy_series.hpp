@@ -0,0 +1,1126 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file lazy_series.hpp
+/// Lazily-evaluated arithmetic expressions over time series
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_LAZY_SERIES_HPP_EAN_10_18_2026
+#define BOOST_TIME_SERIES_LAZY_SERIES_HPP_EAN_10_18_2026
+
+#include <utility>
+#include <algorithm>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/apply.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/placeholders.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/utility/result_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/sequence/concepts.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/range_run_storage/algorithm/detail/runs_searching.hpp>
+#include <boost/range_run_storage/utility/unit_run.hpp>
+#include <boost/time_series/time_series_fwd.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/traits/promotion.hpp>
+#include <boost/time_series/traits/offset_type.hpp>
+#include <boost/time_series/traits/storage_category.hpp>
+#include <boost/time_series/traits/discretization_type.hpp>
+#include <boost/time_series/utility/time_series_base.hpp>
+#include <boost/time_series/numeric/numeric.hpp>
+
+// A lazy_series is a view of an arithmetic expression over other series. It
+// computes nothing until it is read, and then walks the runs of all the
+// series in the expression at once, so that assigning it to a series makes a
+// single pass with no temporary series.
+namespace boost { namespace time_series
+{
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+        namespace seq = sequence;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // The operations of a lazy_binary node. A union operation is defined
+        // wherever either operand is, and an intersection operation only where
+        // both are. zero_op computes the zero of the result, as in numeric.hpp.
+        struct lazy_plus
+        {
+            typedef numeric::op::plus op_type;
+            typedef numeric::op::plus zero_op_type;
+            typedef traits::plus<mpl::_, mpl::_> storage_generator;
+            typedef mpl::true_ is_union;
+        };
+
+        struct lazy_minus
+        {
+            typedef numeric::op::minus op_type;
+            typedef numeric::op::minus zero_op_type;
+            typedef traits::minus<mpl::_, mpl::_> storage_generator;
+            typedef mpl::true_ is_union;
+        };
+
+        struct lazy_multiplies
+        {
+            typedef numeric::op::multiplies op_type;
+            typedef numeric::op::multiplies zero_op_type;
+            typedef traits::multiplies<mpl::_, mpl::_> storage_generator;
+            typedef mpl::false_ is_union;
+        };
+
+        // BUGBUG possible divide by zero, so use multiplies for the zero
+        struct lazy_divides
+        {
+            typedef numeric::op::divides op_type;
+            typedef numeric::op::multiplies zero_op_type;
+            typedef traits::divides<mpl::_, mpl::_> storage_generator;
+            typedef mpl::false_ is_union;
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // lazy_terminal
+        //   A leaf of the expression tree; refers to a series.
+        template<typename Series>
+        struct lazy_terminal
+        {
+            typedef TimeSeries<Series const> series_concept;
+            typedef Series series_type;
+            typedef typename series_concept::value_type value_type;
+            typedef typename series_concept::offset_type offset_type;
+            typedef typename series_concept::discretization_type discretization_type;
+            typedef typename series_concept::storage_category storage_category;
+            typedef typename series_concept::cursor cursor;
+
+            explicit lazy_terminal(Series const &series)
+              : series_(series)
+            {}
+
+            discretization_type discretization() const
+            {
+                return this->series_.discretization();
+            }
+
+            value_type zero() const
+            {
+                return rrs::zero(this->series_);
+            }
+
+            // The value of the run that covers offset n, if there is one
+            bool at(offset_type n, value_type &value) const
+            {
+                typedef typename series_concept::runs runs_type;
+
+                if(lazy_terminal::contains(rrs::pre_run(this->series_), n))
+                {
+                    value = rrs::pre_value(this->series_);
+                    return true;
+                }
+
+                if(lazy_terminal::contains(rrs::post_run(this->series_), n))
+                {
+                    value = rrs::post_value(this->series_);
+                    return true;
+                }
+
+                runs_type runs(rrs::runs(this->series_));
+                cursor end = seq::end(this->series_);
+                cursor where = rrs::detail::run_lower_bound(
+                    seq::begin(this->series_)
+                  , end
+                  , runs
+                  , rrs::unit_run<offset_type>(n)
+                );
+
+                if(where != end && lazy_terminal::contains(runs(*where), n))
+                {
+                    value = seq::elements(this->series_)(*where);
+                    return true;
+                }
+
+                return false;
+            }
+
+            // The final segment of the series, which stretches to +inf. It has a
+            // value only if the last run of the series is infinite.
+            void last(offset_type &offset, bool &present, value_type &value) const
+            {
+                typedef typename series_concept::pre_run_type pre_run_type;
+                typedef typename series_concept::post_run_type post_run_type;
+
+                pre_run_type pre(rrs::pre_run(this->series_));
+                post_run_type post(rrs::post_run(this->series_));
+                cursor begin = seq::begin(this->series_);
+                cursor end = seq::end(this->series_);
+
+                present = false;
+                value = this->zero();
+                offset = -inf;
+
+                if(!rrs::empty(post))
+                {
+                    lazy_terminal::last_run(post, rrs::post_value(this->series_), offset, present, value);
+                }
+                else if(begin != end)
+                {
+                    --end;
+                    lazy_terminal::last_run(
+                        rrs::runs(this->series_)(*end)
+                      , seq::elements(this->series_)(*end)
+                      , offset
+                      , present
+                      , value
+                    );
+                }
+                else if(!rrs::empty(pre))
+                {
+                    lazy_terminal::last_run(pre, rrs::pre_value(this->series_), offset, present, value);
+                }
+            }
+
+        private:
+            template<typename Run>
+            static bool contains(Run const &run, offset_type n)
+            {
+                return !rrs::empty(run) && rrs::offset(run) <= n && n < rrs::end_offset(run);
+            }
+
+            template<typename Run, typename Value>
+            static void last_run(Run const &run, Value const &v, offset_type &offset, bool &present, value_type &value)
+            {
+                if(rrs::end_offset(run) == inf)
+                {
+                    offset = rrs::offset(run);
+                    present = true;
+                    value = v;
+                }
+                else
+                {
+                    offset = rrs::end_offset(run);
+                }
+            }
+
+        public:
+            Series const &series_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // lazy_binary
+        //   An arithmetic operation on two sub-expressions.
+        template<typename Left, typename Right, typename Operation>
+        struct lazy_binary
+        {
+            typedef Left left_type;
+            typedef Right right_type;
+            typedef Operation operation_type;
+            typedef typename Operation::op_type op_type;
+            typedef typename Operation::zero_op_type zero_op_type;
+            typedef typename Operation::is_union is_union;
+
+            typedef typename result_of<
+                op_type(typename Left::value_type, typename Right::value_type)
+            >::type value_type;
+
+            typedef typename Left::offset_type offset_type;
+            BOOST_MPL_ASSERT((is_same<offset_type, typename Right::offset_type>));
+
+            typedef typename mpl::if_<
+                is_same<typename Left::discretization_type, time_series::any>
+              , typename Right::discretization_type
+              , typename Left::discretization_type
+            >::type discretization_type;
+
+            typedef typename mpl::apply<
+                typename Operation::storage_generator
+              , typename Left::storage_category
+              , typename Right::storage_category
+            >::type storage_category;
+
+            lazy_binary(Left const &left, Right const &right)
+              : left_(left)
+              , right_(right)
+            {}
+
+            discretization_type discretization() const
+            {
+                return detail::make_discretization(this->left_.discretization(), this->right_.discretization());
+            }
+
+            value_type zero() const
+            {
+                return zero_op_type()(this->left_.zero(), this->right_.zero());
+            }
+
+            bool at(offset_type n, value_type &value) const
+            {
+                typename Left::value_type left_value = this->left_.zero();
+                typename Right::value_type right_value = this->right_.zero();
+                bool in_left = this->left_.at(n, left_value);
+                bool in_right = this->right_.at(n, right_value);
+                if(is_union::value ? (in_left || in_right) : (in_left && in_right))
+                {
+                    value = op_type()(left_value, right_value);
+                    return true;
+                }
+                return false;
+            }
+
+            void last(offset_type &offset, bool &present, value_type &value) const
+            {
+                offset_type left_offset, right_offset;
+                bool in_left, in_right;
+                typename Left::value_type left_value = this->left_.zero();
+                typename Right::value_type right_value = this->right_.zero();
+                this->left_.last(left_offset, in_left, left_value);
+                this->right_.last(right_offset, in_right, right_value);
+
+                offset = (std::max)(left_offset, right_offset);
+                present = is_union::value ? (in_left || in_right) : (in_left && in_right);
+                value = present ? op_type()(left_value, right_value) : this->zero();
+            }
+
+            Left left_;
+            Right right_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // lazy_scaled
+        //   A sub-expression multiplied by a scalar. Like scaled_series, the zero
+        //   is not scaled.
+        template<typename Expr, typename Factor>
+        struct lazy_scaled
+        {
+            typedef Expr expression_type;
+            typedef Factor factor_type;
+            typedef typename Expr::value_type value_type;
+            typedef typename Expr::offset_type offset_type;
+            typedef typename Expr::discretization_type discretization_type;
+            typedef typename Expr::storage_category storage_category;
+
+            lazy_scaled(Expr const &expr, Factor const &factor)
+              : expr_(expr)
+              , factor_(factor)
+            {}
+
+            discretization_type discretization() const
+            {
+                return this->expr_.discretization();
+            }
+
+            value_type zero() const
+            {
+                return this->expr_.zero();
+            }
+
+            bool at(offset_type n, value_type &value) const
+            {
+                if(this->expr_.at(n, value))
+                {
+                    value = value * this->factor_;
+                    return true;
+                }
+                return false;
+            }
+
+            void last(offset_type &offset, bool &present, value_type &value) const
+            {
+                this->expr_.last(offset, present, value);
+                if(present)
+                {
+                    value = value * this->factor_;
+                }
+            }
+
+            Expr expr_;
+            Factor factor_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // lazy_reader
+        //   Steps through an expression one segment at a time, from -inf to +inf.
+        //   Each segment [offset(), end_offset()) either has a value throughout
+        //   or has none. The segments of an expression end wherever a segment of
+        //   one of its sub-expressions does, so reading the root reads every
+        //   series in the tree in a single n-way merge.
+        template<typename Expr>
+        struct lazy_reader;
+
+        template<typename Series>
+        struct lazy_reader<lazy_terminal<Series> >
+        {
+            typedef lazy_terminal<Series> expression_type;
+            typedef typename expression_type::series_concept series_concept;
+            typedef typename expression_type::value_type value_type;
+            typedef typename expression_type::offset_type offset_type;
+            typedef typename series_concept::cursor cursor;
+            typedef typename series_concept::runs runs_type;
+            typedef typename series_concept::elements elements_type;
+
+            lazy_reader()
+              : series_(0)
+            {}
+
+            explicit lazy_reader(expression_type const &expr)
+              : series_(&expr.series_)
+              , runs_(rrs::runs(expr.series_))
+              , elements_(seq::elements(expr.series_))
+              , begin_(seq::begin(expr.series_))
+              , end_(seq::end(expr.series_))
+              , state_(pre_state)
+              , offset_(-inf)
+              , zero_(expr.zero())
+            {
+                this->load_();
+                this->settle_();
+            }
+
+            offset_type offset() const
+            {
+                return this->offset_;
+            }
+
+            offset_type end_offset() const
+            {
+                return this->end_offset_;
+            }
+
+            bool present() const
+            {
+                return this->present_;
+            }
+
+            value_type const &value() const
+            {
+                return this->present_ ? this->value_ : this->zero_;
+            }
+
+            value_type const &zero() const
+            {
+                return this->zero_;
+            }
+
+            void next()
+            {
+                this->offset_ = this->end_offset_;
+                if(this->present_)
+                {
+                    this->load_();
+                }
+                this->settle_();
+            }
+
+        private:
+            enum state_type { pre_state, body_state, post_state, done_state };
+
+            // Fetch the next non-empty run of the series
+            void load_()
+            {
+                this->has_run_ = false;
+                while(!this->has_run_ && this->state_ != done_state)
+                {
+                    switch(this->state_)
+                    {
+                    case pre_state:
+                        this->state_ = body_state;
+                        this->set_run_(rrs::pre_run(*this->series_), rrs::pre_value(*this->series_));
+                        break;
+                    case body_state:
+                        if(this->begin_ != this->end_)
+                        {
+                            this->set_run_(this->runs_(*this->begin_), this->elements_(*this->begin_));
+                            ++this->begin_;
+                        }
+                        else
+                        {
+                            this->state_ = post_state;
+                        }
+                        break;
+                    case post_state:
+                        this->state_ = done_state;
+                        this->set_run_(rrs::post_run(*this->series_), rrs::post_value(*this->series_));
+                        break;
+                    default:
+                        break;
+                    }
+                }
+            }
+
+            template<typename Run, typename Value>
+            void set_run_(Run const &run, Value const &value)
+            {
+                if(!rrs::empty(run))
+                {
+                    this->has_run_ = true;
+                    this->run_offset_ = rrs::offset(run);
+                    this->run_end_offset_ = rrs::end_offset(run);
+                    this->value_ = value;
+                }
+            }
+
+            // Work out the segment that starts at offset_
+            void settle_()
+            {
+                if(!this->has_run_)
+                {
+                    this->present_ = false;
+                    this->end_offset_ = inf;
+                }
+                else if(this->offset_ < this->run_offset_)
+                {
+                    this->present_ = false;
+                    this->end_offset_ = this->run_offset_;
+                }
+                else
+                {
+                    this->present_ = true;
+                    this->end_offset_ = this->run_end_offset_;
+                }
+            }
+
+            Series const *series_;
+            runs_type runs_;
+            elements_type elements_;
+            cursor begin_;
+            cursor end_;
+            state_type state_;
+            bool has_run_;
+            offset_type run_offset_;
+            offset_type run_end_offset_;
+            offset_type offset_;
+            offset_type end_offset_;
+            bool present_;
+            value_type value_;
+            value_type zero_;
+        };
+
+        template<typename Left, typename Right, typename Operation>
+        struct lazy_reader<lazy_binary<Left, Right, Operation> >
+        {
+            typedef lazy_binary<Left, Right, Operation> expression_type;
+            typedef typename expression_type::value_type value_type;
+            typedef typename expression_type::offset_type offset_type;
+            typedef typename expression_type::op_type op_type;
+            typedef typename expression_type::is_union is_union;
+
+            lazy_reader()
+            {}
+
+            explicit lazy_reader(expression_type const &expr)
+              : left_(expr.left_)
+              , right_(expr.right_)
+              , zero_(expr.zero())
+            {
+                this->settle_();
+            }
+
+            offset_type offset() const
+            {
+                return (std::max)(this->left_.offset(), this->right_.offset());
+            }
+
+            offset_type end_offset() const
+            {
+                return (std::min)(this->left_.end_offset(), this->right_.end_offset());
+            }
+
+            bool present() const
+            {
+                return this->present_;
+            }
+
+            value_type const &value() const
+            {
+                return this->present_ ? this->value_ : this->zero_;
+            }
+
+            value_type const &zero() const
+            {
+                return this->zero_;
+            }
+
+            void next()
+            {
+                offset_type end = this->end_offset();
+                if(this->left_.end_offset() == end)
+                {
+                    this->left_.next();
+                }
+                if(this->right_.end_offset() == end)
+                {
+                    this->right_.next();
+                }
+                this->settle_();
+            }
+
+        private:
+            void settle_()
+            {
+                this->present_ = is_union::value
+                  ? (this->left_.present() || this->right_.present())
+                  : (this->left_.present() && this->right_.present());
+
+                if(this->present_)
+                {
+                    this->value_ = op_type()(this->left_.value(), this->right_.value());
+                }
+            }
+
+            lazy_reader<Left> left_;
+            lazy_reader<Right> right_;
+            bool present_;
+            value_type value_;
+            value_type zero_;
+        };
+
+        template<typename Expr, typename Factor>
+        struct lazy_reader<lazy_scaled<Expr, Factor> >
+        {
+            typedef lazy_scaled<Expr, Factor> expression_type;
+            typedef typename expression_type::value_type value_type;
+            typedef typename expression_type::offset_type offset_type;
+
+            lazy_reader()
+            {}
+
+            explicit lazy_reader(expression_type const &expr)
+              : expr_(expr.expr_)
+              , factor_(expr.factor_)
+            {
+                this->settle_();
+            }
+
+            offset_type offset() const
+            {
+                return this->expr_.offset();
+            }
+
+            offset_type end_offset() const
+            {
+                return this->expr_.end_offset();
+            }
+
+            bool present() const
+            {
+                return this->expr_.present();
+            }
+
+            value_type const &value() const
+            {
+                return this->present() ? this->value_ : this->expr_.zero();
+            }
+
+            value_type const &zero() const
+            {
+                return this->expr_.zero();
+            }
+
+            void next()
+            {
+                this->expr_.next();
+                this->settle_();
+            }
+
+        private:
+            void settle_()
+            {
+                if(this->expr_.present())
+                {
+                    this->value_ = this->expr_.value() * this->factor_;
+                }
+            }
+
+            lazy_reader<Expr> expr_;
+            Factor factor_;
+            value_type value_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // lazy_run_value
+        //   The key of a lazy_series' cursor: one run and its value.
+        template<typename Value, typename Offset>
+        struct lazy_run_value
+        {
+            std::pair<Offset, Offset> run;
+            Value value;
+        };
+
+        template<typename Offset>
+        struct lazy_runs_map
+        {
+            typedef std::pair<Offset, Offset> result_type;
+
+            template<typename Value>
+            result_type operator ()(lazy_run_value<Value, Offset> const &k) const
+            {
+                return k.run;
+            }
+        };
+
+        template<typename Value>
+        struct lazy_elements_map
+        {
+            typedef Value result_type;
+
+            template<typename Offset>
+            result_type operator ()(lazy_run_value<Value, Offset> const &k) const
+            {
+                return k.value;
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // lazy_cursor
+        //   Visits the finite runs of an expression: everything after the pre-run
+        //   and before the final segment, skipping the segments that have no value.
+        template<typename Expr>
+        struct lazy_cursor
+          : iterator_facade<
+                lazy_cursor<Expr>
+              , lazy_run_value<typename Expr::value_type, typename Expr::offset_type>
+              , forward_traversal_tag
+              , lazy_run_value<typename Expr::value_type, typename Expr::offset_type>
+            >
+        {
+            typedef typename Expr::offset_type offset_type;
+            typedef lazy_run_value<typename Expr::value_type, offset_type> run_value_type;
+
+            lazy_cursor()
+              : reader_()
+              , stop_()
+              , at_end_(true)
+            {}
+
+            lazy_cursor(Expr const &expr, offset_type stop, bool at_end)
+              : reader_(expr)
+              , stop_(stop)
+              , at_end_(at_end)
+            {
+                if(!this->at_end_)
+                {
+                    // skip the pre-run
+                    if(this->reader_.present())
+                    {
+                        this->reader_.next();
+                    }
+                    this->skip_();
+                }
+            }
+
+        private:
+            friend class boost::iterator_core_access;
+
+            void skip_()
+            {
+                while(this->reader_.offset() < this->stop_ && !this->reader_.present())
+                {
+                    this->reader_.next();
+                }
+                this->at_end_ = !(this->reader_.offset() < this->stop_);
+            }
+
+            offset_type position_() const
+            {
+                return this->at_end_ ? this->stop_ : this->reader_.offset();
+            }
+
+            run_value_type dereference() const
+            {
+                run_value_type that;
+                that.run = std::make_pair(this->reader_.offset(), this->reader_.end_offset());
+                that.value = this->reader_.value();
+                return that;
+            }
+
+            void increment()
+            {
+                this->reader_.next();
+                this->skip_();
+            }
+
+            bool equal(lazy_cursor const &that) const
+            {
+                return this->position_() == that.position_();
+            }
+
+            lazy_reader<Expr> reader_;
+            offset_type stop_;
+            bool at_end_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // lazy_expression
+        //   The expression tree for an operand: a lazy_series' own tree, or a
+        //   terminal that refers to any other series.
+        template<typename Series>
+        struct lazy_expression
+        {
+            typedef lazy_terminal<Series> type;
+
+            static type make(Series const &series)
+            {
+                return type(series);
+            }
+        };
+
+        template<typename Expr>
+        struct lazy_expression<lazy_series<Expr> >
+        {
+            typedef Expr type;
+
+            static type const &make(lazy_series<Expr> const &series)
+            {
+                return series.expr();
+            }
+        };
+
+        template<typename Left, typename Right, typename Operation>
+        struct lazy_binary_result
+        {
+            typedef lazy_series<
+                lazy_binary<
+                    typename lazy_expression<Left>::type
+                  , typename lazy_expression<Right>::type
+                  , Operation
+                >
+            > type;
+
+            static type make(Left const &left, Right const &right)
+            {
+                typedef typename type::expression_type expression_type;
+                return type(expression_type(
+                    lazy_expression<Left>::make(left)
+                  , lazy_expression<Right>::make(right)
+                ));
+            }
+        };
+    }
+
+    /// \brief A lazily-evaluated arithmetic expression over time series.
+    ///
+    /// A \c lazy_series\<\> is a read-only \c TimeSeries that represents the sum,
+    /// difference, product or quotient of other series without computing it. It
+    /// is created by wrapping an operand with \c lazy(), after which the arithmetic
+    /// operators build larger \c lazy_series\<\> expressions instead of temporary
+    /// series. The expression is evaluated when it is assigned to a series, or
+    /// used to construct one, by walking the runs of all of its operands in a single
+    /// pass. The result is the same as that of the corresponding eager expression.
+    ///
+    /// A \c lazy_series\<\> refers to the series in its expression, which must outlive it.
+    /// Offsets must be integral.
+    template<typename Expr>
+    struct lazy_series
+      : time_series_base<lazy_series<Expr> >
+    {
+        typedef Expr expression_type;
+        typedef typename Expr::value_type value_type;
+        typedef typename Expr::offset_type offset_type;
+        typedef typename Expr::discretization_type discretization_type;
+        typedef typename Expr::storage_category storage_category;
+        typedef value_type reference;
+        typedef detail::lazy_cursor<Expr> cursor;
+
+        BOOST_MPL_ASSERT((is_integral<offset_type>));
+
+        explicit lazy_series(Expr const &expr)
+          : expr_(expr)
+        {}
+
+        discretization_type discretization() const
+        {
+            return this->expr_.discretization();
+        }
+
+        reference operator [](offset_type n) const
+        {
+            value_type value = this->expr_.zero();
+            return this->expr_.at(n, value) ? value : this->expr_.zero();
+        }
+
+        Expr const &expr() const
+        {
+            return this->expr_;
+        }
+
+    private:
+        Expr expr_;
+    };
+
+    namespace traits
+    {
+        /// INTERNAL ONLY
+        template<typename Expr>
+        struct discretization_type<lazy_series<Expr> >
+        {
+            typedef typename Expr::discretization_type type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename Expr>
+        struct offset_type<lazy_series<Expr> >
+        {
+            typedef typename Expr::offset_type type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename Expr>
+        struct storage_category<lazy_series<Expr> >
+        {
+            typedef typename Expr::storage_category type;
+        };
+    }
+
+    /// \brief Wraps a series so that arithmetic on it is evaluated lazily.
+    ///
+    /// \param series The series.
+    /// \return A \c lazy_series\<\> that refers to \c series.
+    template<typename Series>
+    inline lazy_series<detail::lazy_terminal<Series> > const
+    lazy(time_series_base<Series> const &series)
+    {
+        return lazy_series<detail::lazy_terminal<Series> >(
+            detail::lazy_terminal<Series>(series.cast())
+        );
+    }
+
+    /// \overload
+    ///
+    template<typename Expr>
+    inline lazy_series<Expr> const &
+    lazy(lazy_series<Expr> const &series)
+    {
+        return series;
+    }
+
+#define BOOST_TIME_SERIES_DEFINE_LAZY_OPERATOR(OP, OPERATION)\
+    template<typename Left, typename Right>\
+    typename detail::lazy_binary_result<lazy_series<Left>, lazy_series<Right>, detail::OPERATION>::type const\
+    operator OP(lazy_series<Left> const &left, lazy_series<Right> const &right)\
+    {\
+        return detail::lazy_binary_result<lazy_series<Left>, lazy_series<Right>, detail::OPERATION>\
+            ::make(left, right);\
+    }\
+    template<typename Left, typename Right>\
+    typename detail::lazy_binary_result<lazy_series<Left>, Right, detail::OPERATION>::type const\
+    operator OP(lazy_series<Left> const &left, time_series_base<Right> const &right)\
+    {\
+        return detail::lazy_binary_result<lazy_series<Left>, Right, detail::OPERATION>\
+            ::make(left, right.cast());\
+    }\
+    template<typename Left, typename Right>\
+    typename detail::lazy_binary_result<Left, lazy_series<Right>, detail::OPERATION>::type const\
+    operator OP(time_series_base<Left> const &left, lazy_series<Right> const &right)\
+    {\
+        return detail::lazy_binary_result<Left, lazy_series<Right>, detail::OPERATION>\
+            ::make(left.cast(), right);\
+    }\
+    /**/
+
+    BOOST_TIME_SERIES_DEFINE_LAZY_OPERATOR(+, lazy_plus)
+    BOOST_TIME_SERIES_DEFINE_LAZY_OPERATOR(-, lazy_minus)
+    BOOST_TIME_SERIES_DEFINE_LAZY_OPERATOR(*, lazy_multiplies)
+    BOOST_TIME_SERIES_DEFINE_LAZY_OPERATOR(/, lazy_divides)
+
+#undef BOOST_TIME_SERIES_DEFINE_LAZY_OPERATOR
+
+    ///////////////////////////////////////////////////////////////////////////
+    // operator * (with scalar)
+    template<typename Expr, typename Factor>
+    typename disable_if<
+        traits::is_time_series<Factor>
+      , lazy_series<detail::lazy_scaled<Expr, Factor> > const
+    >::type
+    operator *(lazy_series<Expr> const &left, Factor const &right)
+    {
+        return lazy_series<detail::lazy_scaled<Expr, Factor> >(
+            detail::lazy_scaled<Expr, Factor>(left.expr(), right)
+        );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // operator * (with scalar)
+    template<typename Factor, typename Expr>
+    typename disable_if<
+        traits::is_time_series<Factor>
+      , lazy_series<detail::lazy_scaled<Expr, Factor> > const
+    >::type
+    operator *(Factor const &left, lazy_series<Expr> const &right)
+    {
+        return lazy_series<detail::lazy_scaled<Expr, Factor> >(
+            detail::lazy_scaled<Expr, Factor>(right.expr(), left)
+        );
+    }
+
+}} // namespace boost::time_series
+
+namespace boost
+{
+    namespace sequence { namespace impl
+    {
+        /// INTERNAL ONLY
+        struct lazy_series_tag;
+
+        /// INTERNAL ONLY
+        template<typename Expr>
+        struct tag<time_series::lazy_series<Expr> >
+        {
+            typedef lazy_series_tag type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename S>
+        struct elements<S, lazy_series_tag>
+        {
+            typedef time_series::detail::lazy_elements_map<typename S::value_type> result_type;
+
+            result_type operator ()(S &) const
+            {
+                return result_type();
+            }
+        };
+
+        /// INTERNAL ONLY
+        template<typename S>
+        struct begin<S, lazy_series_tag>
+        {
+            typedef typename S::cursor result_type;
+
+            result_type operator ()(S &s) const
+            {
+                typename S::offset_type offset;
+                bool present;
+                typename S::value_type value = s.expr().zero();
+                s.expr().last(offset, present, value);
+                return result_type(s.expr(), offset, false);
+            }
+        };
+
+        /// INTERNAL ONLY
+        template<typename S>
+        struct end<S, lazy_series_tag>
+        {
+            typedef typename S::cursor result_type;
+
+            result_type operator ()(S &s) const
+            {
+                typename S::offset_type offset;
+                bool present;
+                typename S::value_type value = s.expr().zero();
+                s.expr().last(offset, present, value);
+                return result_type(s.expr(), offset, true);
+            }
+        };
+    }}
+
+    namespace range_run_storage { namespace impl
+    {
+        /// INTERNAL ONLY
+        template<typename S>
+        struct runs<S, sequence::impl::lazy_series_tag>
+        {
+            typedef time_series::detail::lazy_runs_map<typename S::offset_type> result_type;
+
+            result_type operator ()(S &) const
+            {
+                return result_type();
+            }
+        };
+
+        /// INTERNAL ONLY
+        template<typename S, typename I>
+        struct get_at<S, I, sequence::impl::lazy_series_tag>
+        {
+            typedef typename S::reference result_type;
+
+            result_type operator ()(S &s, I &i) const
+            {
+                return s[i];
+            }
+        };
+
+        /// INTERNAL ONLY
+        template<typename S>
+        struct zero<S, sequence::impl::lazy_series_tag>
+        {
+            typedef typename S::value_type result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.expr().zero();
+            }
+        };
+
+        /// INTERNAL ONLY
+        template<typename S>
+        struct pre_run<S, sequence::impl::lazy_series_tag>
+        {
+            typedef typename S::offset_type offset_type;
+            typedef std::pair<offset_type, offset_type> result_type;
+
+            result_type operator ()(S &s) const
+            {
+                time_series::detail::lazy_reader<typename S::expression_type> reader(s.expr());
+                return reader.present()
+                  ? result_type(-inf, reader.end_offset())
+                  : result_type(-inf, -inf);
+            }
+        };
+
+        /// INTERNAL ONLY
+        template<typename S>
+        struct pre_value<S, sequence::impl::lazy_series_tag>
+        {
+            typedef typename S::value_type result_type;
+
+            result_type operator ()(S &s) const
+            {
+                time_series::detail::lazy_reader<typename S::expression_type> reader(s.expr());
+                return reader.value();
+            }
+        };
+
+        /// INTERNAL ONLY
+        template<typename S>
+        struct post_run<S, sequence::impl::lazy_series_tag>
+        {
+            typedef typename S::offset_type offset_type;
+            typedef std::pair<offset_type, offset_type> result_type;
+
+            result_type operator ()(S &s) const
+            {
+                offset_type offset;
+                bool present;
+                typename S::value_type value = s.expr().zero();
+                s.expr().last(offset, present, value);
+
+                // A final segment that starts at -inf is the pre-run
+                return present && offset != -inf
+                  ? result_type(offset, inf)
+                  : result_type(inf, inf);
+            }
+        };
+
+        /// INTERNAL ONLY
+        template<typename S>
+        struct post_value<S, sequence::impl::lazy_series_tag>
+        {
+            typedef typename S::value_type result_type;
+
+            result_type operator ()(S &s) const
+            {
+                typename S::offset_type offset;
+                bool present;
+                typename S::value_type value = s.expr().zero();
+                s.expr().last(offset, present, value);
+                return value;
+            }
+        };
+    }}
+}
+
+#endif
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file mapped_dense_series.hpp
+/// A read-only time series over a memory-mapped file that holds dense storage
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_MAPPED_DENSE_SERIES_HPP_EAN_10_18_2026
+#define BOOST_TIME_SERIES_MAPPED_DENSE_SERIES_HPP_EAN_10_18_2026
+
+#include <boost/time_series/time_series_facade.hpp>
+#include <boost/time_series/storage/mapped_dense_array.hpp>
+
+namespace boost { namespace time_series
+{
+
+    /// \brief A read-only \c TimeSeries over a memory-mapped file that holds dense storage.
+    ///
+    /// The file is one written by \c range_run_storage::save_binary() from a
+    /// \c dense_series\<\> of the same \c Value. It is mapped into memory read-only,
+    /// so opening it takes constant time, the values are read in place rather
+    /// than copied onto the heap, and processes that map the same file share
+    /// its pages. Copies of the series share the mapping.
+    ///
+    /// The named parameters for the constructor are, in order:
+    ///   -# \c file, the path of the file, with a default of an empty series
+    ///   -# \c discretization, with a default of \c Discretization(1)
+    ///
+    /// \throw std::runtime_error if the file does not hold an archive of a
+    ///     dense storage with the same sizes of offsets and values.
+    /// \throw boost::interprocess::interprocess_exception if the file cannot be mapped.
+    template<typename Value, typename Discretization>
+    struct mapped_dense_series
+      : time_series_facade<
+            mapped_dense_series<Value, Discretization>
+          , storage::mapped_dense_array<Value>
+          , Discretization
+        >
+    {
+        typedef time_series_facade<
+            mapped_dense_series<Value, Discretization>
+          , storage::mapped_dense_array<Value>
+          , Discretization
+        > base_type;
+
+        BOOST_TIME_SERIES_DEFINE_CTORS(mapped_dense_series)
+    };
+
+    namespace traits
+    {
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization>
+        struct storage_category<mapped_dense_series<Value, Discretization> >
+          : storage_category<storage::mapped_dense_array<Value> >
+        {};
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization>
+        struct discretization_type<mapped_dense_series<Value, Discretization> >
+        {
+            typedef Discretization type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization>
+        struct offset_type<mapped_dense_series<Value, Discretization> >
+        {
+            typedef std::ptrdiff_t type;
+        };
+    }
+
+}}
+
+namespace boost { namespace sequence { namespace impl
+{
+    /// INTERNAL ONLY
+    template<typename Value, typename Discretization>
+    struct tag<time_series::mapped_dense_series<Value, Discretization> >
+    {
+        typedef time_series_tag type;
+    };
+}}}
+
+namespace boost { namespace constructors { namespace impl
+{
+    /// INTERNAL ONLY
+    struct mapped_dense_series_tag;
+
+    /// INTERNAL ONLY
+    template<typename Value, typename Discretization>
+    struct tag<time_series::mapped_dense_series<Value, Discretization> >
+    {
+        typedef mapped_dense_series_tag type;
+    };
+
+    /// INTERNAL ONLY
+    template<typename T>
+    struct construct<T, mapped_dense_series_tag>
+      : arg_pack_construct
+    {
+        typedef parameter::parameters<
+            parameter::optional<time_series::tag::file>
+          , parameter::optional<time_series::tag::discretization>
+        > args_type;
+    };
+
+}}}
+
+#endif
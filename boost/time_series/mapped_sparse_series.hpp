@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file mapped_sparse_series.hpp
+/// A read-only time series over a memory-mapped file that holds sparse storage
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_MAPPED_SPARSE_SERIES_HPP_EAN_10_18_2026
+#define BOOST_TIME_SERIES_MAPPED_SPARSE_SERIES_HPP_EAN_10_18_2026
+
+#include <boost/time_series/time_series_facade.hpp>
+#include <boost/time_series/storage/mapped_sparse_array.hpp>
+
+namespace boost { namespace time_series
+{
+
+    /// \brief A read-only \c TimeSeries over a memory-mapped file that holds sparse storage.
+    ///
+    /// The file is one written by \c range_run_storage::save_binary() from a
+    /// \c sparse_series\<\> of the same \c Value and \c Offset. It is mapped into
+    /// memory read-only, so opening it takes constant time, the offsets and
+    /// values are read in place rather than copied onto the heap, and processes
+    /// that map the same file share its pages. Copies of the series share the
+    /// mapping. Random access is by binary search over the mapped offsets.
+    ///
+    /// The named parameters for the constructor are, in order:
+    ///   -# \c file, the path of the file, with a default of an empty series
+    ///   -# \c discretization, with a default of \c Discretization(1)
+    ///
+    /// \throw std::runtime_error if the file does not hold an archive of a
+    ///     sparse storage with the same sizes of offsets and values.
+    /// \throw boost::interprocess::interprocess_exception if the file cannot be mapped.
+    template<typename Value, typename Discretization, typename Offset>
+    struct mapped_sparse_series
+      : time_series_facade<
+            mapped_sparse_series<Value, Discretization, Offset>
+          , storage::mapped_sparse_array<Value, Offset>
+          , Discretization
+        >
+    {
+        typedef time_series_facade<
+            mapped_sparse_series<Value, Discretization, Offset>
+          , storage::mapped_sparse_array<Value, Offset>
+          , Discretization
+        > base_type;
+
+        BOOST_TIME_SERIES_DEFINE_CTORS(mapped_sparse_series)
+    };
+
+    namespace traits
+    {
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset>
+        struct storage_category<mapped_sparse_series<Value, Discretization, Offset> >
+          : storage_category<storage::mapped_sparse_array<Value, Offset> >
+        {};
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset>
+        struct discretization_type<mapped_sparse_series<Value, Discretization, Offset> >
+        {
+            typedef Discretization type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset>
+        struct offset_type<mapped_sparse_series<Value, Discretization, Offset> >
+        {
+            typedef Offset type;
+        };
+    }
+
+}}
+
+namespace boost { namespace sequence { namespace impl
+{
+    /// INTERNAL ONLY
+    template<typename Value, typename Discretization, typename Offset>
+    struct tag<time_series::mapped_sparse_series<Value, Discretization, Offset> >
+    {
+        typedef time_series_tag type;
+    };
+}}}
+
+namespace boost { namespace constructors { namespace impl
+{
+    /// INTERNAL ONLY
+    struct mapped_sparse_series_tag;
+
+    /// INTERNAL ONLY
+    template<typename Value, typename Discretization, typename Offset>
+    struct tag<time_series::mapped_sparse_series<Value, Discretization, Offset> >
+    {
+        typedef mapped_sparse_series_tag type;
+    };
+
+    /// INTERNAL ONLY
+    template<typename T>
+    struct construct<T, mapped_sparse_series_tag>
+      : arg_pack_construct
+    {
+        typedef parameter::parameters<
+            parameter::optional<time_series::tag::file>
+          , parameter::optional<time_series::tag::discretization>
+        > args_type;
+    };
+
+}}}
+
+#endif
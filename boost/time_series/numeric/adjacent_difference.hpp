@@ -15,6 +15,7 @@
 #include <boost/time_series/concepts.hpp>
 #include <boost/time_series/sparse_series.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 
 namespace boost { namespace time_series
 {
@@ -102,16 +103,22 @@ namespace boost { namespace time_series
         typename concepts::TimeSeries<Series const>::value_type
       , typename concepts::TimeSeries<Series const>::discretization_type
       , typename concepts::TimeSeries<Series const>::offset_type
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >))
     adjacent_difference(Series const &series)
     {
         typedef typename concepts::TimeSeries<Series const>::value_type value_type;
         typedef typename concepts::TimeSeries<Series const>::offset_type offset_type;
         typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
 
         // The partial differences are held in a sparse array.
-        sparse_series<value_type, discretization_type, offset_type> result(
+        sparse_series<value_type, discretization_type, offset_type, allocator_type> result(
             time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
         );
 
         time_series::adjacent_difference(
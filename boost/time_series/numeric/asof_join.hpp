@@ -0,0 +1,241 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file asof_join.hpp
+/// Sample one series at the runs of another, with last-known-value semantics
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_ASOF_JOIN_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_ASOF_JOIN_EAN_10_18_2026
+
+#include <boost/concept/requires.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+
+        // Any value is recent enough
+        struct no_tolerance
+        {};
+
+        template<typename Offset>
+        bool asof_recent(Offset, Offset, no_tolerance)
+        {
+            return true;
+        }
+
+        template<typename Offset, typename Tolerance>
+        bool asof_recent(Offset offset, Offset end_offset, Tolerance tolerance)
+        {
+            return offset < end_offset + tolerance;
+        }
+
+        // asof_join_inserter
+        //   Receives the runs of the left series in order, and walks a cursor
+        //   through the runs of the right series alongside them, so the whole
+        //   join is a single merge of the two.
+        template<typename Out, typename Right, typename Tolerance>
+        struct asof_join_inserter
+        {
+            typedef concepts::TimeSeries<Right> right_concept;
+            typedef typename right_concept::cursor cursor_type;
+            typedef typename right_concept::offset_type offset_type;
+
+            asof_join_inserter(Out const &out, Right &right, Tolerance const &tolerance)
+              : out_(out)
+              , right_(right)
+              , tolerance_(tolerance)
+              , runs_(rrs::runs(right))
+              , elements_(sequence::elements(right))
+              , begin_(sequence::begin(right))
+              , end_(sequence::end(right))
+              , last_(sequence::end(right))
+            {}
+
+            template<typename Run, typename Value>
+            void set_at(Run const &run, Value const &)
+            {
+                offset_type offset = rrs::offset(run);
+                if(-inf == offset)
+                {
+                    return;
+                }
+
+                // last_ is the latest right run that starts at or before offset
+                for(; this->begin_ != this->end_ && !(offset < rrs::offset(this->runs_(*this->begin_))); ++this->begin_)
+                {
+                    this->last_ = this->begin_;
+                }
+
+                typename right_concept::post_run_type post_run(rrs::post_run(this->right_));
+                typename right_concept::pre_run_type pre_run(rrs::pre_run(this->right_));
+
+                if(!rrs::empty(post_run) && !(offset < rrs::offset(post_run)))
+                {
+                    if(this->recent_(offset, post_run))
+                    {
+                        this->out_(rrs::post_value(this->right_), offset);
+                    }
+                }
+                else if(this->last_ != this->end_)
+                {
+                    if(this->recent_(offset, this->runs_(*this->last_)))
+                    {
+                        this->out_(this->elements_(*this->last_), offset);
+                    }
+                }
+                else if(!rrs::empty(pre_run) && !(offset < rrs::offset(pre_run)))
+                {
+                    if(this->recent_(offset, pre_run))
+                    {
+                        this->out_(rrs::pre_value(this->right_), offset);
+                    }
+                }
+            }
+
+            Out const &finalize() const
+            {
+                return this->out_;
+            }
+
+        private:
+            template<typename Run>
+            bool recent_(offset_type offset, Run const &run) const
+            {
+                offset_type end_offset = rrs::end_offset(run);
+                return inf == end_offset || detail::asof_recent(offset, end_offset, this->tolerance_);
+            }
+
+            Out out_;
+            Right &right_;
+            Tolerance tolerance_;
+            typename right_concept::runs runs_;
+            typename right_concept::elements elements_;
+            cursor_type begin_;
+            cursor_type end_;
+            cursor_type last_;
+        };
+    }
+
+    /// \brief Sample the right series at the start of each run of the left
+    ///     series, using the latest value the right series had taken by then.
+    ///
+    /// For each run of \c left, starting at offset \em o, writes to \c out the
+    ///     value of the latest run of \c right that starts at or before \em o,
+    ///     at offset \em o. That run may have ended before \em o; its value is
+    ///     then the last known value of \c right. If \c right has no run that
+    ///     starts at or before \em o, or, when a \c tolerance is given, the run
+    ///     ended \c tolerance or more before \em o, nothing is written at \em o.
+    ///     For integral offsets, a value last seen at offset \em j is accepted
+    ///     at \em o if <tt>o - j <= tolerance</tt>.
+    ///
+    /// The two series are merged in one pass, so the cost is linear in the
+    ///     number of runs of both.
+    ///
+    /// \param left The series whose runs give the offsets to sample at.
+    /// \param right The series to sample.
+    /// \param tolerance The largest allowed age of a sampled value.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre \c Left is a model of the \c TimeSeries concept.
+    /// \pre \c Right is a model of the \c TimeSeries concept, with the same
+    ///     \c offset_type as \c Left.
+    /// \pre \c Out is a model of the \c OrderedInserter concept.
+    /// \return A \c sparse_series\<\> if no ordered inserter is specified; otherwise,
+    ///     the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Left, typename Right, typename Tolerance, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Left const>))
+        ((concepts::TimeSeries<Right const>)),
+    (ordered_inserter<Out>))
+    asof_join(Left const &left, Right const &right, Tolerance tolerance, ordered_inserter<Out> out)
+    {
+        detail::asof_join_inserter<ordered_inserter<Out>, Right const, Tolerance> o(out, right, tolerance);
+        return range_run_storage::copy(left, o).finalize();
+    }
+
+    /// \overload
+    ///
+    template<typename Left, typename Right, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Left const>))
+        ((concepts::TimeSeries<Right const>)),
+    (ordered_inserter<Out>))
+    asof_join(Left const &left, Right const &right, ordered_inserter<Out> out)
+    {
+        return time_series::asof_join(left, right, detail::no_tolerance(), out);
+    }
+
+    /// \overload
+    ///
+    template<typename Left, typename Right, typename Tolerance>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Left const>))
+        ((concepts::TimeSeries<Right const>)),
+    (sparse_series<
+        typename concepts::TimeSeries<Right const>::value_type
+      , typename concepts::TimeSeries<Right const>::discretization_type
+      , typename concepts::TimeSeries<Left const>::offset_type
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Right const>::value_type
+          , Left
+          , Right
+        >::type
+    >))
+    asof_join(Left const &left, Right const &right, Tolerance tolerance)
+    {
+        typedef typename concepts::TimeSeries<Right const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Right const>::discretization_type discretization_type;
+        typedef typename concepts::TimeSeries<Left const>::offset_type offset_type;
+        typedef typename detail::series_result_allocator<value_type, Left, Right>::type allocator_type;
+
+        sparse_series<value_type, discretization_type, offset_type, allocator_type> result(
+            time_series::discretization = right.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(left, right)
+        );
+
+        time_series::asof_join(
+            left
+          , right
+          , tolerance
+          , time_series::make_ordered_inserter(result)
+        ).commit();
+
+        return result;
+    }
+
+    /// \overload
+    ///
+    template<typename Left, typename Right>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Left const>))
+        ((concepts::TimeSeries<Right const>)),
+    (sparse_series<
+        typename concepts::TimeSeries<Right const>::value_type
+      , typename concepts::TimeSeries<Right const>::discretization_type
+      , typename concepts::TimeSeries<Left const>::offset_type
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Right const>::value_type
+          , Left
+          , Right
+        >::type
+    >))
+    asof_join(Left const &left, Right const &right)
+    {
+        return time_series::asof_join(left, right, detail::no_tolerance());
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_ASOF_JOIN_EAN_10_18_2026
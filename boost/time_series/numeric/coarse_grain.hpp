@@ -5,14 +5,21 @@
 #ifndef BOOST_TIME_SERIES_NUMERIC_COARSE_GRAIN_060615_HPP
 #define BOOST_TIME_SERIES_NUMERIC_COARSE_GRAIN_060615_HPP
 
+#include <memory>
+#include <cstddef>
 #include <boost/concept/requires.hpp>
 #include <boost/integer_traits.hpp>
 #include <boost/iterator/counting_iterator.hpp>
+#include <boost/mpl/apply_wrap.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/detail/pod_singleton.hpp>
 #include <boost/range_run_storage/algorithm/copy.hpp>
 #include <boost/time_series/concepts.hpp>
 #include <boost/time_series/sparse_series.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/traits/allocator_type.hpp>
 #include <boost/time_series/numeric/detail/find_period.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 
 namespace boost { namespace time_series
 {
@@ -66,8 +73,355 @@ namespace boost { namespace time_series
             Offset factor_;
         };
 
+        // The index of the coarse period that holds the fine offset
+        template<typename Offset>
+        Offset coarse_period(Offset offset, Offset factor)
+        {
+            return (offset - ((offset % factor) + factor) % factor) / factor;
+        }
+
+        // Feeds the part of each run within each coarse period to an
+        // accumulator, and writes out the result for each period when the
+        // runs move past it.
+        template<typename Out, typename Accumulator, typename Offset>
+        struct reduce_inserter
+        {
+            reduce_inserter(Out const &out, Offset factor)
+              : out_(out)
+              , accumulator_()
+              , period_(0)
+              , factor_(factor)
+            {}
+
+            template<typename Run, typename Value>
+            void set_at(Run &run, Value &value)
+            {
+                Offset start = rrs::offset(run);
+                Offset stop = rrs::end_offset(run);
+
+                while(start != stop)
+                {
+                    Offset period = detail::coarse_period(start, this->factor_);
+                    if(period != this->period_)
+                    {
+                        this->flush_();
+                        this->period_ = period;
+                    }
+
+                    Offset next = (std::min<Offset>)(stop, (period + 1) * this->factor_);
+                    this->accumulator_.add(value, next - start);
+                    start = next;
+                }
+            }
+
+            Out const &finalize()
+            {
+                this->flush_();
+                return this->out_;
+            }
+
+        private:
+            void flush_()
+            {
+                if(!this->accumulator_.empty())
+                {
+                    this->out_(this->accumulator_.result(), this->period_);
+                    this->accumulator_ = Accumulator();
+                }
+            }
+
+            Out out_;
+            Accumulator accumulator_;
+            Offset period_;
+            Offset factor_;
+        };
+
     } // namespace detail
 
+    namespace reducers
+    {
+
+        template <typename Derived>
+        struct reducer_base
+        {
+            Derived const &cast() const
+            {
+                return static_cast<Derived const&>(*this);
+            }
+        };
+
+        /// INTERNAL ONLY
+        struct accumulator_base
+        {
+            accumulator_base()
+              : count_(0)
+            {}
+
+            bool empty() const
+            {
+                return 0 == this->count_;
+            }
+
+        protected:
+            std::size_t count_;
+        };
+
+        /// A coarse_grain reducer that sums <tt>value * length</tt> over the
+        /// runs within each coarse period.
+        ///
+        struct sum_downsample
+          : reducer_base<sum_downsample>
+        {
+            template <typename Value, typename Discretization, typename Allocator = std::allocator<Value> >
+            struct apply
+            {
+                typedef sparse_series<Value, Discretization, std::ptrdiff_t, Allocator> type;
+            };
+
+            template <typename Value>
+            struct accumulator
+              : accumulator_base
+            {
+                accumulator()
+                  : sum_()
+                {}
+
+                void add(Value const &value, std::ptrdiff_t length)
+                {
+                    this->sum_ = 0 == this->count_++ ? Value(value * length) : Value(this->sum_ + value * length);
+                }
+
+                Value result() const
+                {
+                    return this->sum_;
+                }
+
+            private:
+                Value sum_;
+            };
+        };
+
+        /// A coarse_grain reducer that averages the values of the runs within
+        /// each coarse period, counting each run once whatever its length.
+        ///
+        struct mean_downsample
+          : reducer_base<mean_downsample>
+        {
+            template <typename Value, typename Discretization, typename Allocator = std::allocator<Value> >
+            struct apply
+            {
+                typedef typename numeric::functional::average<Value, std::size_t>::result_type result_type;
+                typedef sparse_series<
+                    result_type
+                  , Discretization
+                  , std::ptrdiff_t
+                  , typename Allocator::template rebind<result_type>::other
+                > type;
+            };
+
+            template <typename Value>
+            struct accumulator
+              : accumulator_base
+            {
+                accumulator()
+                  : sum_()
+                {}
+
+                void add(Value const &value, std::ptrdiff_t)
+                {
+                    this->sum_ = 0 == this->count_++ ? value : Value(this->sum_ + value);
+                }
+
+                typename numeric::functional::average<Value, std::size_t>::result_type result() const
+                {
+                    return numeric::average(this->sum_, this->count_);
+                }
+
+            private:
+                Value sum_;
+            };
+        };
+
+        /// A coarse_grain reducer that averages the values within each coarse
+        /// period weighted by the length of their runs. Offsets without a
+        /// run do not count.
+        ///
+        struct time_weighted_mean_downsample
+          : reducer_base<time_weighted_mean_downsample>
+        {
+            template <typename Value, typename Discretization, typename Allocator = std::allocator<Value> >
+            struct apply
+            {
+                typedef typename numeric::functional::average<Value, std::size_t>::result_type result_type;
+                typedef sparse_series<
+                    result_type
+                  , Discretization
+                  , std::ptrdiff_t
+                  , typename Allocator::template rebind<result_type>::other
+                > type;
+            };
+
+            template <typename Value>
+            struct accumulator
+              : accumulator_base
+            {
+                accumulator()
+                  : sum_()
+                  , length_(0)
+                {}
+
+                void add(Value const &value, std::ptrdiff_t length)
+                {
+                    this->sum_ = 0 == this->count_++ ? Value(value * length) : Value(this->sum_ + value * length);
+                    this->length_ += length;
+                }
+
+                typename numeric::functional::average<Value, std::size_t>::result_type result() const
+                {
+                    return numeric::average(this->sum_, this->length_);
+                }
+
+            private:
+                Value sum_;
+                std::size_t length_;
+            };
+        };
+
+        /// A coarse_grain reducer that picks the least value within each
+        /// coarse period.
+        ///
+        struct min_downsample
+          : reducer_base<min_downsample>
+        {
+            template <typename Value, typename Discretization, typename Allocator = std::allocator<Value> >
+            struct apply
+            {
+                typedef sparse_series<Value, Discretization, std::ptrdiff_t, Allocator> type;
+            };
+
+            template <typename Value>
+            struct accumulator
+              : accumulator_base
+            {
+                accumulator()
+                  : min_()
+                {}
+
+                void add(Value const &value, std::ptrdiff_t)
+                {
+                    if(0 == this->count_++)
+                        this->min_ = value;
+                    else
+                        numeric::min_assign(this->min_, value);
+                }
+
+                Value result() const
+                {
+                    return this->min_;
+                }
+
+            private:
+                Value min_;
+            };
+        };
+
+        /// A coarse_grain reducer that picks the greatest value within each
+        /// coarse period.
+        ///
+        struct max_downsample
+          : reducer_base<max_downsample>
+        {
+            template <typename Value, typename Discretization, typename Allocator = std::allocator<Value> >
+            struct apply
+            {
+                typedef sparse_series<Value, Discretization, std::ptrdiff_t, Allocator> type;
+            };
+
+            template <typename Value>
+            struct accumulator
+              : accumulator_base
+            {
+                accumulator()
+                  : max_()
+                {}
+
+                void add(Value const &value, std::ptrdiff_t)
+                {
+                    if(0 == this->count_++)
+                        this->max_ = value;
+                    else
+                        numeric::max_assign(this->max_, value);
+                }
+
+                Value result() const
+                {
+                    return this->max_;
+                }
+
+            private:
+                Value max_;
+            };
+        };
+
+        /// A coarse_grain reducer that picks the value of the last run within
+        /// each coarse period.
+        ///
+        struct last_downsample
+          : reducer_base<last_downsample>
+        {
+            template <typename Value, typename Discretization, typename Allocator = std::allocator<Value> >
+            struct apply
+            {
+                typedef sparse_series<Value, Discretization, std::ptrdiff_t, Allocator> type;
+            };
+
+            template <typename Value>
+            struct accumulator
+              : accumulator_base
+            {
+                accumulator()
+                  : last_()
+                {}
+
+                void add(Value const &value, std::ptrdiff_t)
+                {
+                    ++this->count_;
+                    this->last_ = value;
+                }
+
+                Value result() const
+                {
+                    return this->last_;
+                }
+
+            private:
+                Value last_;
+            };
+        };
+
+    } // namespace reducers
+
+    namespace
+    {
+        reducers::sum_downsample const &sum_downsample
+            = boost::detail::pod_singleton<reducers::sum_downsample>::instance;
+
+        reducers::mean_downsample const &mean_downsample
+            = boost::detail::pod_singleton<reducers::mean_downsample>::instance;
+
+        reducers::time_weighted_mean_downsample const &time_weighted_mean_downsample
+            = boost::detail::pod_singleton<reducers::time_weighted_mean_downsample>::instance;
+
+        reducers::min_downsample const &min_downsample
+            = boost::detail::pod_singleton<reducers::min_downsample>::instance;
+
+        reducers::max_downsample const &max_downsample
+            = boost::detail::pod_singleton<reducers::max_downsample>::instance;
+
+        reducers::last_downsample const &last_downsample
+            = boost::detail::pod_singleton<reducers::last_downsample>::instance;
+    }
+
     /// \brief Generate a series of a coarser discretization by picking the values
     /// at the coarse-grained points.
     ///
@@ -107,18 +461,118 @@ namespace boost { namespace time_series
     (sparse_series<
         typename concepts::TimeSeries<Series const>::value_type
       , Discretization
+      , std::ptrdiff_t
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >))
     coarse_grain(Series const &series, Discretization discretization)
     {
         typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
+
+        sparse_series<value_type, Discretization, std::ptrdiff_t, allocator_type> result(
+            time_series::discretization = discretization
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::coarse_grain(
+            series
+          , discretization
+          , time_series::make_ordered_inserter(result)
+        ).commit();
+
+        return result;
+    }
+
+    /// \brief Generate a series of a coarser discretization by reducing the runs
+    /// within each coarse period according to a reducer policy.
+    ///
+    /// Generate a series of a coarser discretization by reducing the runs within
+    /// each coarse period according to a reducer policy, in a single pass. Each
+    /// coarse period with at least one run in it gets a value; the others are
+    /// left at zero.
+    ///
+    /// \param series The input series.
+    /// \param discretization The coarser discretization.
+    /// \param reducer The reducer policy. Could be \c sum_downsample, \c mean_downsample,
+    ///         \c time_weighted_mean_downsample, \c min_downsample, \c max_downsample
+    ///         or \c last_downsample.
+    /// \param out An \c OrderedInserter into which to write the coarser series.
+    /// \return Either a <tt>sparse_series\<\></tt> containing the coarser series, or a
+    ///         copy of the \c OrderedInserter passed in. The <tt>sparse_series\<\></tt> gets a copy
+    ///         of the allocator of \c series, if it has one.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///         <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    /// \pre The coarser discretization is a multiple of the finer discretization.
+    /// \pre The series has integral offsets, and no infinite runs.
+    template <class Series, class Discretization, class Reducer, class Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    coarse_grain(
+        Series const &series
+      , Discretization discretization
+      , reducers::reducer_base<Reducer> const &
+      , ordered_inserter<Out> out
+    )
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::offset_type offset_type;
+
+        BOOST_ASSERT(discretization > series.discretization());
+        BOOST_ASSERT(discretization % series.discretization() == 0);
+
+        offset_type factor = discretization / series.discretization();
+
+        detail::reduce_inserter<
+            ordered_inserter<Out>
+          , typename Reducer::template accumulator<value_type>
+          , offset_type
+        > o(out, factor);
+
+        return range_run_storage::copy(series, o).finalize();
+    }
+
+    /// \overload
+    ///
+    template <class Series, class Discretization, class Reducer>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (typename mpl::apply_wrap3<
+        Reducer
+      , typename concepts::TimeSeries<Series const>::value_type
+      , Discretization
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
+    >::type))
+    coarse_grain(
+        Series const &series
+      , Discretization discretization
+      , reducers::reducer_base<Reducer> const &reducer
+    )
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename mpl::apply_wrap3<
+            Reducer
+          , value_type
+          , Discretization
+          , typename detail::series_result_allocator<value_type, Series>::type
+        >::type result_type;
+        typedef typename traits::allocator_type<result_type>::type allocator_type;
 
-        sparse_series<value_type, Discretization> result(
+        result_type result(
             time_series::discretization = discretization
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
         );
 
         time_series::coarse_grain(
             series
           , discretization
+          , reducer.cast()
           , time_series::make_ordered_inserter(result)
         ).commit();
 
@@ -0,0 +1,294 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file compact.hpp
+/// Re-encode a series as a piecewise constant series, merging neighbouring
+/// runs of equal value
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_COMPACT_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_COMPACT_EAN_10_18_2026
+
+#include <cstddef>
+#include <iterator>
+#include <boost/concept/requires.hpp>
+#include <boost/implicit_cast.hpp>
+#include <boost/range_run_storage/offset.hpp>
+#include <boost/range_run_storage/end_offset.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/traits/allocator_type.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+
+        // Discards the runs written to it
+        struct discard_runs
+        {
+            template<typename Value, typename Offset>
+            void operator ()(Value const &, Offset, Offset) const
+            {}
+        };
+
+        // compact_inserter
+        //   Merges each run with the one before when they touch and have the
+        //   same value, and writes the merged runs that are not zero to out.
+        //   Counts the runs that come in and the merged runs that go out.
+        template<typename Out, typename Value, typename Offset>
+        struct compact_inserter
+        {
+            compact_inserter(Out out, Value const &zero)
+              : out_(out)
+              , zero_(zero)
+              , value_(zero)
+              , offset_()
+              , end_offset_()
+              , pending_(false)
+              , runs_(0)
+              , compacted_runs_(0)
+            {}
+
+            template<typename Run>
+            void set_at(Run const &run, Value const &value)
+            {
+                ++this->runs_;
+                Offset const off = rrs::offset(run);
+                if(this->pending_ && this->end_offset_ == off && this->value_ == value)
+                {
+                    this->end_offset_ = rrs::end_offset(run);
+                    return;
+                }
+
+                this->flush_();
+                this->value_ = value;
+                this->offset_ = off;
+                this->end_offset_ = rrs::end_offset(run);
+                this->pending_ = true;
+            }
+
+            Out finalize()
+            {
+                this->flush_();
+                return this->out_;
+            }
+
+            std::size_t runs() const
+            {
+                return this->runs_;
+            }
+
+            std::size_t compacted_runs() const
+            {
+                return this->compacted_runs_;
+            }
+
+        private:
+            void flush_()
+            {
+                if(this->pending_ && !(this->value_ == this->zero_))
+                {
+                    this->out_(this->value_, this->offset_, this->end_offset_);
+                    ++this->compacted_runs_;
+                }
+                this->pending_ = false;
+            }
+
+            Out out_;
+            Value zero_;
+            Value value_;
+            Offset offset_;
+            Offset end_offset_;
+            bool pending_;
+            std::size_t runs_;
+            std::size_t compacted_runs_;
+        };
+
+        // The number of maximal stretches of equal values in [begin, end)
+        // that are not zero. The loop has no branches, so the compiler can
+        // compare several neighbours at once.
+        template<typename Iter, typename Value>
+        std::size_t count_compacted_runs(Iter begin, Iter end, Value const &zero)
+        {
+            std::ptrdiff_t const size = std::distance(begin, end);
+            if(0 == size)
+            {
+                return 0;
+            }
+
+            std::size_t count = !(begin[0] == zero);
+            for(std::ptrdiff_t i = 1; i != size; ++i)
+            {
+                count += static_cast<std::size_t>(!(begin[i] == zero) & !(begin[i] == begin[i - 1]));
+            }
+            return count;
+        }
+
+        // The buffer of a dense series without pre- or post-runs is scanned
+        // directly for the number of runs it would compact to.
+        template<typename Series>
+        bool count_values(Series const &, std::size_t &, std::size_t &)
+        {
+            return false;
+        }
+
+        template<typename Value, typename Discretization, typename Allocator>
+        bool count_values(dense_series<Value, Discretization, Allocator> const &series, std::size_t &runs, std::size_t &compacted_runs)
+        {
+            storage::dense_array<Value, Allocator> const &data = time_series_facade_access::data(series);
+            if(data.pre().second != -inf || data.post().first != inf)
+            {
+                return false;
+            }
+
+            runs = data.size();
+            compacted_runs = detail::count_compacted_runs(data.begin(), data.end(), data.zero());
+            return true;
+        }
+
+        inline double compaction_ratio(std::size_t runs, std::size_t compacted_runs)
+        {
+            return 0 == runs ? 1. : static_cast<double>(runs) / static_cast<double>(0 == compacted_runs ? 1 : compacted_runs);
+        }
+
+        template<typename Series>
+        struct compact_result
+        {
+            typedef piecewise_constant_series<
+                typename concepts::TimeSeries<Series const>::value_type
+              , typename concepts::TimeSeries<Series const>::discretization_type
+              , typename concepts::TimeSeries<Series const>::offset_type
+              , typename detail::series_result_allocator<
+                    typename concepts::TimeSeries<Series const>::value_type
+                  , Series
+                >::type
+            > type;
+        };
+    }
+
+    /// \brief Writes the runs of a series to an \c ordered_inserter\<\>, merging
+    ///     neighbouring runs of equal value.
+    ///
+    /// Runs that touch and have equal values are written as one run, and runs
+    ///     whose value is the zero of the series are not written. A dense series
+    ///     that holds long flat stretches is written as one run per stretch.
+    ///
+    /// \param series The input series.
+    /// \param out The ordered inserter that receives the merged runs.
+    /// \pre \c Series is a model of the \c TimeSeries concept.
+    /// \return \c out
+    template<typename Series, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    compact(Series const &series, ordered_inserter<Out> out)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::offset_type offset_type;
+
+        detail::compact_inserter<ordered_inserter<Out>, value_type, offset_type> o(
+            out
+          , implicit_cast<value_type const &>(range_run_storage::zero(series))
+        );
+
+        return range_run_storage::copy(series, o).finalize();
+    }
+
+    /// \brief Re-encodes a series as a \c piecewise_constant_series\<\>, merging
+    ///     neighbouring runs of equal value.
+    ///
+    /// \param series The input series.
+    /// \pre \c Series is a model of the \c TimeSeries concept.
+    /// \return A \c piecewise_constant_series\<\> with the same value at every
+    ///     offset as \c series, the same discretization and zero, and a copy
+    ///     of its allocator, if it has one.
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (typename detail::compact_result<Series>::type))
+    compact(Series const &series)
+    {
+        typedef typename detail::compact_result<Series>::type result_type;
+        typedef typename traits::allocator_type<result_type>::type allocator_type;
+
+        result_type result(
+            time_series::discretization = series.discretization()
+          , time_series::zero = range_run_storage::zero(series)
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::compact(series, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+    /// \brief The number of runs of a series for each run of the series
+    ///     <tt>compact(series)</tt>.
+    ///
+    /// The buffer of a dense series is scanned directly, without building
+    ///     the compacted series, comparing each value with the one before in
+    ///     a loop without branches.
+    ///
+    /// \param series The input series.
+    /// \pre \c Series is a model of the \c TimeSeries concept.
+    /// \return The number of runs of \c series, divided by the number of runs
+    ///     of <tt>compact(series)</tt>, or by 1 if it has none; 1 if \c series
+    ///     has no runs.
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (double))
+    compaction_ratio(Series const &series)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::offset_type offset_type;
+
+        std::size_t runs = 0, compacted_runs = 0;
+        if(!detail::count_values(series, runs, compacted_runs))
+        {
+            detail::compact_inserter<detail::discard_runs, value_type, offset_type> o(
+                detail::discard_runs()
+              , implicit_cast<value_type const &>(range_run_storage::zero(series))
+            );
+
+            range_run_storage::copy(series, o).finalize();
+            runs = o.runs();
+            compacted_runs = o.compacted_runs();
+        }
+
+        return detail::compaction_ratio(runs, compacted_runs);
+    }
+
+    /// \brief Re-encodes a series as a \c piecewise_constant_series\<\> if that
+    ///     takes at least \c threshold times fewer runs.
+    ///
+    /// \param series The input series.
+    /// \param out Receives <tt>compact(series)</tt> if the ratio reaches
+    ///     \c threshold, and is left unchanged otherwise.
+    /// \param threshold The least ratio for which \c series is compacted.
+    /// \pre \c Series is a model of the \c TimeSeries concept.
+    /// \return <tt>compaction_ratio(series)</tt>
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (double))
+    compact(Series const &series, typename detail::compact_result<Series>::type &out, double threshold)
+    {
+        double const ratio = time_series::compaction_ratio(series);
+        if(ratio >= threshold)
+        {
+            out = time_series::compact(series);
+        }
+        return ratio;
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_COMPACT_EAN_10_18_2026
@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file convolve.hpp
+/// Convolve a series with a kernel series
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_CONVOLVE_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_CONVOLVE_EAN_10_18_2026
+
+#include <vector>
+#include <numeric>
+#include <boost/implicit_cast.hpp>
+#include <boost/concept/requires.hpp>
+#include <boost/assert.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/convolution.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
+
+namespace boost { namespace time_series
+{
+
+    /// \brief Convolve a series with a kernel series.
+    ///
+    /// The result at offset \em i is the sum over the offsets \em j of the kernel
+    ///     of <tt>series[i - j] * kernel[j]</tt>. The runs of both series are
+    ///     laid out one value per offset, and the convolution of the two buffers
+    ///     is computed directly for small kernels, with an inner loop over
+    ///     contiguous values that the compiler can vectorize, and by a radix-2
+    ///     FFT otherwise. Integral results are rounded to the nearest integer,
+    ///     and are only taken from the FFT when its rounding error is small
+    ///     enough for that to give the exact result.
+    ///
+    /// The infinite pre- and post-runs of \c series, if any, are constant
+    ///     tails: the result has pre- and post-runs whose values are those of
+    ///     the tails times the sum of the kernel.
+    ///
+    /// \param series The input series.
+    /// \param kernel The kernel series.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre \c Series is a model of the \c TimeSeries concept, with integral offsets.
+    /// \pre \c Kernel is a model of the \c TimeSeries concept, with integral offsets.
+    /// \pre \c Out is a model of the \c OrderedInserter concept.
+    /// \pre <tt>kernel[-inf] == range_run_storage::zero(kernel)</tt>
+    /// \pre <tt>kernel[inf] == range_run_storage::zero(kernel)</tt>
+    /// \return A \c dense_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Kernel, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>))
+        ((concepts::TimeSeries<Kernel const>)),
+    (ordered_inserter<Out>))
+    convolve(Series const &series, Kernel const &kernel, ordered_inserter<Out> out)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef concepts::TimeSeries<Kernel const> kernel_concept;
+        typedef typename series_concept::value_type value_type;
+        typedef typename kernel_concept::value_type kernel_value_type;
+        typedef typename series_concept::offset_type offset_type;
+        typedef typename numeric::functional::multiplies<value_type, kernel_value_type>::result_type result_type;
+
+        BOOST_MPL_ASSERT((is_integral<offset_type>));
+        BOOST_MPL_ASSERT((is_integral<typename kernel_concept::offset_type>));
+
+        value_type const zero = range_run_storage::zero(series);
+        detail::convolution_buffer<value_type, offset_type> x(zero);
+        range_run_storage::copy(series, x);
+
+        detail::convolution_buffer<kernel_value_type, offset_type> k(range_run_storage::zero(kernel));
+        range_run_storage::copy(kernel, k);
+        BOOST_ASSERT(k.pre == implicit_cast<kernel_value_type const &>(range_run_storage::zero(kernel)));
+        BOOST_ASSERT(k.post == implicit_cast<kernel_value_type const &>(range_run_storage::zero(kernel)));
+
+        bool const pre = !(x.pre == zero), post = !(x.post == zero);
+        if(k.values.empty() || (x.values.empty() && !pre && !post))
+        {
+            return out;
+        }
+
+        // Enough of each tail that every result in the finite part sees it
+        std::size_t const n = x.values.size(), tail = k.values.size() - 1;
+        std::vector<value_type> ext(tail, x.pre);
+        ext.insert(ext.end(), x.values.begin(), x.values.end());
+        ext.insert(ext.end(), tail, x.post);
+
+        offset_type const offset = x.offset + k.offset;
+        result_type const sum = std::accumulate(k.values.begin(), k.values.end(), result_type());
+
+        if(pre)
+        {
+            out(x.pre * sum, -inf, offset);
+        }
+
+        if(!ext.empty())
+        {
+            std::vector<result_type> result;
+            detail::convolve_buffers(ext, k.values, result);
+            out.set_at_range(offset, result.begin() + tail, result.begin() + (tail + n + tail));
+        }
+
+        if(post)
+        {
+            out(x.post * sum, offset + n + tail, inf);
+        }
+
+        return out;
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Kernel>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>))
+        ((concepts::TimeSeries<Kernel const>)),
+    (dense_series<
+        typename numeric::functional::multiplies<
+            typename concepts::TimeSeries<Series const>::value_type
+          , typename concepts::TimeSeries<Kernel const>::value_type
+        >::result_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , typename detail::series_result_allocator<
+            typename numeric::functional::multiplies<
+                typename concepts::TimeSeries<Series const>::value_type
+              , typename concepts::TimeSeries<Kernel const>::value_type
+            >::result_type
+          , Series
+          , Kernel
+        >::type
+    >))
+    convolve(Series const &series, Kernel const &kernel)
+    {
+        typedef typename numeric::functional::multiplies<
+            typename concepts::TimeSeries<Series const>::value_type
+          , typename concepts::TimeSeries<Kernel const>::value_type
+        >::result_type result_type;
+        typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<result_type, Series, Kernel>::type allocator_type;
+
+        dense_series<result_type, discretization_type, allocator_type> result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series, kernel)
+        );
+
+        time_series::convolve(series, kernel, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_CONVOLVE_EAN_10_18_2026
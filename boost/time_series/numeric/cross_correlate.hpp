@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file cross_correlate.hpp
+/// Calculate the cross-correlation of two series over a range of lags
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_CROSS_CORRELATE_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_CROSS_CORRELATE_EAN_10_18_2026
+
+#include <cmath>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <boost/implicit_cast.hpp>
+#include <boost/concept/requires.hpp>
+#include <boost/assert.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/convolution.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        // result[lag + max_lag] = sum over i of a[i] * b[i + lag], where a and
+        // b start at offsets a0 and b0, directly for each lag
+        template<typename Result, typename A, typename B>
+        void direct_correlate(
+            std::vector<A> const &a, std::ptrdiff_t a0
+          , std::vector<B> const &b, std::ptrdiff_t b0
+          , std::ptrdiff_t max_lag
+          , std::vector<Result> &result
+        )
+        {
+            std::ptrdiff_t const a1 = a0 + a.size(), b1 = b0 + b.size();
+            for(std::ptrdiff_t lag = -max_lag; lag <= max_lag; ++lag)
+            {
+                std::ptrdiff_t const lo = (std::max)(a0, b0 - lag);
+                std::ptrdiff_t const hi = (std::min)(a1, b1 - lag);
+                Result sum = Result();
+                for(std::ptrdiff_t i = lo; i < hi; ++i)
+                {
+                    sum += Result(a[i - a0]) * b[i + lag - b0];
+                }
+                result[lag + max_lag] = sum;
+            }
+        }
+    }
+
+    /// \brief Calculate the cross-correlation of two series over a range of lags.
+    ///
+    /// The result at offset \em lag, for each \em lag in <em>[-max_lag, max_lag]</em>,
+    ///     is the sum over the offsets \em i of <tt>a[i] * b[i + lag]</tt>. When
+    ///     only a few lags are asked for, each is summed directly over the overlap
+    ///     of the two series; otherwise all lags come from one convolution of the
+    ///     two buffers by a radix-2 FFT. Integral results are rounded to the
+    ///     nearest integer, and are only taken from the FFT when its rounding
+    ///     error is small enough for that to give the exact result; otherwise
+    ///     each lag is summed directly.
+    ///
+    /// \param a The first series.
+    /// \param b The second series.
+    /// \param max_lag The largest lag, either way, to calculate. Must be integral.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre \c A and \c B are models of the \c TimeSeries concept, with integral offsets.
+    /// \pre \c Out is a model of the \c OrderedInserter concept.
+    /// \pre <tt>max_lag >= 0</tt>
+    /// \pre Neither series has a non-zero infinite pre- or post-run.
+    /// \return A \c dense_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename A, typename B, typename Lag, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<A const>))
+        ((concepts::TimeSeries<B const>)),
+    (ordered_inserter<Out>))
+    cross_correlate(A const &a, B const &b, Lag max_lag, ordered_inserter<Out> out)
+    {
+        typedef typename concepts::TimeSeries<A const>::value_type a_value_type;
+        typedef typename concepts::TimeSeries<B const>::value_type b_value_type;
+        typedef typename numeric::functional::multiplies<a_value_type, b_value_type>::result_type result_type;
+
+        BOOST_MPL_ASSERT((is_integral<Lag>));
+        BOOST_MPL_ASSERT((is_integral<typename concepts::TimeSeries<A const>::offset_type>));
+        BOOST_MPL_ASSERT((is_integral<typename concepts::TimeSeries<B const>::offset_type>));
+        BOOST_ASSERT(0 <= max_lag);
+
+        a_value_type const a_zero = range_run_storage::zero(a);
+        b_value_type const b_zero = range_run_storage::zero(b);
+        detail::convolution_buffer<a_value_type, std::ptrdiff_t> x(a_zero);
+        detail::convolution_buffer<b_value_type, std::ptrdiff_t> y(b_zero);
+        range_run_storage::copy(a, x);
+        range_run_storage::copy(b, y);
+        BOOST_ASSERT(x.pre == a_zero && x.post == a_zero);
+        BOOST_ASSERT(y.pre == b_zero && y.post == b_zero);
+
+        if(x.values.empty() || y.values.empty())
+        {
+            return out;
+        }
+
+        std::ptrdiff_t const lags = 2 * static_cast<std::ptrdiff_t>(max_lag) + 1;
+        std::vector<result_type> result(lags);
+
+        // Summing each lag directly is also the fallback when the FFT could
+        // round an integral result to the wrong integer, since it only costs
+        // as much as the lags asked for, not the full convolution.
+        double const direct = static_cast<double>(lags) * (std::min)(x.values.size(), y.values.size());
+        double const n = static_cast<double>(x.values.size() + y.values.size());
+        if(direct <= 8 * n * std::log(n) + 4096
+        || !detail::fft_is_exact_enough(x.values, y.values, 2 * n, is_integral<result_type>()))
+        {
+            detail::direct_correlate(x.values, x.offset, y.values, y.offset, max_lag, result);
+        }
+        else
+        {
+            // Convolving a reversed with b puts lag (m + b0 - a0 - na + 1) at m.
+            std::vector<a_value_type> reversed(x.values.rbegin(), x.values.rend());
+            std::vector<result_type> full;
+            detail::fft_convolve(reversed, y.values, full);
+
+            std::ptrdiff_t const first = y.offset - x.offset - static_cast<std::ptrdiff_t>(x.values.size()) + 1;
+            for(std::ptrdiff_t lag = -max_lag; lag <= max_lag; ++lag)
+            {
+                std::ptrdiff_t const m = lag - first;
+                if(0 <= m && m < static_cast<std::ptrdiff_t>(full.size()))
+                {
+                    result[lag + max_lag] = full[m];
+                }
+            }
+        }
+
+        out.set_at_range(-static_cast<std::ptrdiff_t>(max_lag), result.begin(), result.end());
+        return out;
+    }
+
+    /// \overload
+    ///
+    template<typename A, typename B, typename Lag>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<A const>))
+        ((concepts::TimeSeries<B const>)),
+    (dense_series<
+        typename numeric::functional::multiplies<
+            typename concepts::TimeSeries<A const>::value_type
+          , typename concepts::TimeSeries<B const>::value_type
+        >::result_type
+      , typename concepts::TimeSeries<A const>::discretization_type
+      , typename detail::series_result_allocator<
+            typename numeric::functional::multiplies<
+                typename concepts::TimeSeries<A const>::value_type
+              , typename concepts::TimeSeries<B const>::value_type
+            >::result_type
+          , A
+          , B
+        >::type
+    >))
+    cross_correlate(A const &a, B const &b, Lag max_lag)
+    {
+        typedef typename numeric::functional::multiplies<
+            typename concepts::TimeSeries<A const>::value_type
+          , typename concepts::TimeSeries<B const>::value_type
+        >::result_type result_type;
+        typedef typename concepts::TimeSeries<A const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<result_type, A, B>::type allocator_type;
+
+        dense_series<result_type, discretization_type, allocator_type> result(
+            time_series::discretization = a.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(a, b)
+        );
+
+        time_series::cross_correlate(a, b, max_lag, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_CROSS_CORRELATE_EAN_10_18_2026
@@ -0,0 +1,270 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file convolution.hpp
+/// The buffers, FFT and direct loops shared by convolve and cross_correlate
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_DETAIL_CONVOLUTION_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_DETAIL_CONVOLUTION_EAN_10_18_2026
+
+#include <cmath>
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <algorithm>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/range_run_storage/offset.hpp>
+#include <boost/range_run_storage/end_offset.hpp>
+#include <boost/time_series/time_series_fwd.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+
+        // convolution_buffer
+        //   The values of a series over the offsets from the end of its pre-run
+        //   to the start of its post-run, one per offset, with the gaps between
+        //   runs filled with zero. The values of the infinite pre- and post-runs,
+        //   if any, are kept as constant tails.
+        template<typename Value, typename Offset>
+        struct convolution_buffer
+        {
+            explicit convolution_buffer(Value const &zero)
+              : values()
+              , offset(0)
+              , pre(zero)
+              , post(zero)
+              , zero_(zero)
+              , started_(false)
+            {}
+
+            template<typename Run, typename V>
+            void set_at(Run const &run, V const &value)
+            {
+                Offset start = rrs::offset(run);
+                Offset stop = rrs::end_offset(run);
+
+                if(-inf == start)
+                {
+                    this->pre = value;
+                    this->start_(stop);
+                }
+                else
+                {
+                    this->start_(start);
+                    this->values.resize(start - this->offset, this->zero_);
+                    if(inf == stop)
+                    {
+                        this->post = value;
+                    }
+                    else
+                    {
+                        this->values.resize(stop - this->offset, value);
+                    }
+                }
+            }
+
+            std::vector<Value> values;
+            Offset offset;
+            Value pre;
+            Value post;
+
+        private:
+            void start_(Offset offset)
+            {
+                if(!this->started_)
+                {
+                    this->offset = offset;
+                    this->started_ = true;
+                }
+            }
+
+            Value zero_;
+            bool started_;
+        };
+
+        // In-place iterative radix-2 FFT. The size must be a power of 2.
+        inline void fft(std::vector<std::complex<double> > &a, bool inverse)
+        {
+            std::size_t const n = a.size();
+            for(std::size_t i = 1, j = 0; i < n; ++i)
+            {
+                std::size_t bit = n >> 1;
+                for(; j & bit; bit >>= 1)
+                {
+                    j ^= bit;
+                }
+                j ^= bit;
+                if(i < j)
+                {
+                    std::swap(a[i], a[j]);
+                }
+            }
+
+            // The roots of unity are each computed directly, rather than by
+            // repeated multiplication, whose rounding errors would add up
+            // along every stage.
+            double const pi = 3.14159265358979323846;
+            std::vector<std::complex<double> > roots(n / 2);
+            for(std::size_t k = 0; k < n / 2; ++k)
+            {
+                double const angle = 2 * pi * k / n * (inverse ? -1 : 1);
+                roots[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+
+            for(std::size_t len = 2; len <= n; len <<= 1)
+            {
+                std::size_t const stride = n / len;
+                for(std::size_t i = 0; i < n; i += len)
+                {
+                    for(std::size_t j = 0; j < len / 2; ++j)
+                    {
+                        std::complex<double> const u = a[i + j];
+                        std::complex<double> const v = a[i + j + len / 2] * roots[j * stride];
+                        a[i + j] = u + v;
+                        a[i + j + len / 2] = u - v;
+                    }
+                }
+            }
+
+            if(inverse)
+            {
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    a[i] /= static_cast<double>(n);
+                }
+            }
+        }
+
+        template<typename Result>
+        Result from_fft(double value, mpl::true_)
+        {
+            return static_cast<Result>(std::floor(value + 0.5));
+        }
+
+        template<typename Result>
+        Result from_fft(double value, mpl::false_)
+        {
+            return static_cast<Result>(value);
+        }
+
+        // result[m] = sum over i + j == m of x[i] * y[j], by FFT. Integral
+        // results are rounded to the nearest integer.
+        template<typename Result, typename X, typename Y>
+        void fft_convolve(std::vector<X> const &x, std::vector<Y> const &y, std::vector<Result> &result)
+        {
+            std::size_t const size = x.size() + y.size() - 1;
+            std::size_t n = 1;
+            while(n < size)
+            {
+                n <<= 1;
+            }
+
+            // Each input gets a transform of its own. Packing both into the
+            // real and imaginary parts of one transform saves a pass, but
+            // leaves the smaller spectrum with the rounding error of the
+            // larger, which integral results cannot afford.
+            std::vector<std::complex<double> > a(n), b(n);
+            for(std::size_t i = 0; i < x.size(); ++i)
+            {
+                a[i] = static_cast<double>(x[i]);
+            }
+            for(std::size_t i = 0; i < y.size(); ++i)
+            {
+                b[i] = static_cast<double>(y[i]);
+            }
+
+            detail::fft(a, false);
+            detail::fft(b, false);
+            for(std::size_t k = 0; k < n; ++k)
+            {
+                a[k] *= b[k];
+            }
+            detail::fft(a, true);
+
+            result.resize(size);
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                result[i] = detail::from_fft<Result>(a[i].real(), is_integral<Result>());
+            }
+        }
+
+        // The same, directly. The inner loop runs over contiguous arrays so
+        // that the compiler can vectorize it.
+        template<typename Result, typename X, typename Y>
+        void direct_convolve(std::vector<X> const &x, std::vector<Y> const &y, std::vector<Result> &result)
+        {
+            std::vector<Result> xs(x.begin(), x.end());
+            result.assign(x.size() + y.size() - 1, Result());
+            std::ptrdiff_t const size = xs.size();
+            for(std::size_t j = 0; j < y.size(); ++j)
+            {
+                Result const k = y[j];
+                Result *const out = &result[j];
+                Result const *const in = &xs[0];
+                for(std::ptrdiff_t i = 0; i < size; ++i)
+                {
+                    out[i] += in[i] * k;
+                }
+            }
+        }
+
+        template<typename T>
+        double sum_of_squares(std::vector<T> const &x)
+        {
+            double sum = 0.;
+            for(std::size_t i = 0; i < x.size(); ++i)
+            {
+                double const d = static_cast<double>(x[i]);
+                sum += d * d;
+            }
+            return sum;
+        }
+
+        // Whether the FFT gets every integral result to within 0.5 of the
+        // exact one, so that it rounds to it. The error of each result is at
+        // most about |x| |y| eps log2(n), with |x| and |y| the Euclidean
+        // norms of the inputs; a factor of 8 is kept in hand. No result is
+        // larger than |x| |y|, which must also be exact as a double.
+        template<typename X, typename Y>
+        bool fft_is_exact_enough(std::vector<X> const &, std::vector<Y> const &, double, mpl::false_)
+        {
+            return true;
+        }
+
+        template<typename X, typename Y>
+        bool fft_is_exact_enough(std::vector<X> const &x, std::vector<Y> const &y, double n, mpl::true_)
+        {
+            double const norms = std::sqrt(detail::sum_of_squares(x) * detail::sum_of_squares(y));
+            double const eps = 2.220446049250313e-16;
+            return norms * eps * 8 * std::log(n) / std::log(2.) < 0.5 && norms < 9007199254740992.;
+        }
+
+        // Picks the cheaper of the two for the sizes involved, unless the
+        // FFT could round an integral result to the wrong integer
+        template<typename Result, typename X, typename Y>
+        void convolve_buffers(std::vector<X> const &x, std::vector<Y> const &y, std::vector<Result> &result)
+        {
+            double const direct = static_cast<double>(x.size()) * y.size();
+            double const n = static_cast<double>(x.size() + y.size());
+            if(direct <= 8 * n * std::log(n) + 4096
+            || !detail::fft_is_exact_enough(x, y, 2 * n, is_integral<Result>()))
+            {
+                detail::direct_convolve(x, y, result);
+            }
+            else
+            {
+                detail::fft_convolve(x, y, result);
+            }
+        }
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_DETAIL_CONVOLUTION_EAN_10_18_2026
@@ -0,0 +1,369 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file dense_bin_op.hpp
+/// Elementwise binary operations directly on the buffers of dense series
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_DETAIL_DENSE_BIN_OP_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_DETAIL_DENSE_BIN_OP_EAN_10_18_2026
+
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/detail/construct.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/time_series/time_series_fwd.hpp>
+#include <boost/time_series/time_series_facade.hpp>
+#include <boost/time_series/scaled_series.hpp>
+#include <boost/time_series/storage/dense_array.hpp>
+#include <boost/time_series/utility/constants.hpp>
+
+namespace boost { namespace time_series { namespace detail
+{
+    namespace rrs = range_run_storage;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // dense_view
+    //   A flat view of a series whose values live in a contiguous buffer over
+    //   [lo, hi) and equal outside() everywhere else. A view that is everywhere()
+    //   has the same value at every offset. Series that cannot be viewed this
+    //   way go through rrs::transform.
+    template<typename S>
+    struct dense_view
+    {
+        typedef mpl::false_ is_viewable;
+    };
+
+    template<typename Value, typename Discretization, typename Allocator>
+    struct dense_view<dense_series<Value, Discretization, Allocator> >
+    {
+        typedef is_arithmetic<Value> is_viewable;
+        typedef Value value_type;
+
+        explicit dense_view(dense_series<Value, Discretization, Allocator> const &s)
+          : data_(time_series_facade_access::data(s))
+          , buffer_(data_.empty() ? 0 : &*data_.begin())
+        {}
+
+        // Pre- and post-runs would need to be split around the buffer.
+        bool valid() const
+        {
+            return this->data_.pre().second == -inf && this->data_.post().first == inf;
+        }
+
+        bool everywhere() const
+        {
+            return false;
+        }
+
+        std::ptrdiff_t lo() const
+        {
+            return this->data_.offset();
+        }
+
+        std::ptrdiff_t hi() const
+        {
+            return this->data_.end_offset();
+        }
+
+        Value const &outside() const
+        {
+            return this->data_.zero();
+        }
+
+        Value const &operator [](std::ptrdiff_t i) const
+        {
+            return this->buffer_[i - this->data_.offset()];
+        }
+
+    private:
+        storage::dense_array<Value, Allocator> const &data_;
+        Value const *buffer_;
+    };
+
+    template<typename Value, typename Discretization, typename Allocator, typename Factor>
+    struct dense_view<scaled_series<dense_series<Value, Discretization, Allocator> const, Factor> >
+    {
+        typedef mpl::and_<is_arithmetic<Value>, is_arithmetic<Factor> > is_viewable;
+        typedef Value value_type;
+
+        explicit dense_view(scaled_series<dense_series<Value, Discretization, Allocator> const, Factor> const &s)
+          : base_(s.data())
+          , factor_(s.factor())
+        {}
+
+        bool valid() const
+        {
+            return this->base_.valid();
+        }
+
+        bool everywhere() const
+        {
+            return false;
+        }
+
+        std::ptrdiff_t lo() const
+        {
+            return this->base_.lo();
+        }
+
+        std::ptrdiff_t hi() const
+        {
+            return this->base_.hi();
+        }
+
+        // rrs::zero() of a scaled_series is the unscaled zero
+        Value const &outside() const
+        {
+            return this->base_.outside();
+        }
+
+        Value operator [](std::ptrdiff_t i) const
+        {
+            return this->base_[i] * this->factor_;
+        }
+
+    private:
+        dense_view<dense_series<Value, Discretization, Allocator> > base_;
+        Factor factor_;
+    };
+
+    template<typename Value, typename Discretization>
+    struct dense_view<constant_series<Value, Discretization, std::ptrdiff_t> >
+    {
+        typedef is_arithmetic<Value> is_viewable;
+        typedef Value value_type;
+
+        explicit dense_view(constant_series<Value, Discretization, std::ptrdiff_t> const &s)
+          : value_(rrs::pre_value(s))
+        {}
+
+        bool valid() const
+        {
+            return true;
+        }
+
+        bool everywhere() const
+        {
+            return true;
+        }
+
+        std::ptrdiff_t lo() const
+        {
+            return 0;
+        }
+
+        std::ptrdiff_t hi() const
+        {
+            return 0;
+        }
+
+        Value const &outside() const
+        {
+            return this->value_;
+        }
+
+        Value const &operator [](std::ptrdiff_t) const
+        {
+            return this->value_;
+        }
+
+    private:
+        Value value_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // is_dense_bin_op
+    //   The result is a dense_series of arithmetic values, and both operands can be
+    //   viewed as flat buffers.
+    template<typename Out>
+    struct is_dense_out
+      : mpl::false_
+    {};
+
+    template<typename Value, typename Discretization, typename Allocator>
+    struct is_dense_out<dense_series<Value, Discretization, Allocator> >
+      : is_arithmetic<Value>
+    {};
+
+    template<typename Out, typename Left, typename Right>
+    struct is_dense_bin_op
+      : mpl::and_<
+            is_dense_out<typename remove_const<Out>::type>
+          , typename dense_view<typename remove_const<Left>::type>::is_viewable
+          , typename dense_view<typename remove_const<Right>::type>::is_viewable
+        >
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // dense_segment
+    //   Fill out[a,b) with op applied to the left and right values at each offset,
+    //   where in_left and in_right say whether [a,b) lies in each buffer.
+    template<typename Value, typename Left, typename Right, typename BinOp>
+    void dense_segment(
+        Value *out
+      , std::ptrdiff_t a
+      , std::ptrdiff_t b
+      , Left const &left
+      , Right const &right
+      , bool in_left
+      , bool in_right
+      , BinOp const &binop
+      , Value const &zero
+    )
+    {
+        if(in_left && in_right)
+        {
+            for(std::ptrdiff_t i = a; i != b; ++i)
+                *out++ = binop(left[i], right[i]);
+        }
+        else if(in_left)
+        {
+            typename Right::value_type const right_zero = right.outside();
+            for(std::ptrdiff_t i = a; i != b; ++i)
+                *out++ = binop(left[i], right_zero);
+        }
+        else if(in_right)
+        {
+            typename Left::value_type const left_zero = left.outside();
+            for(std::ptrdiff_t i = a; i != b; ++i)
+                *out++ = binop(left_zero, right[i]);
+        }
+        else
+        {
+            std::fill(out, out + (b - a), zero);
+        }
+    }
+
+    template<typename View>
+    bool contains(View const &view, std::ptrdiff_t a, std::ptrdiff_t b)
+    {
+        return view.everywhere() || (view.lo() <= a && b <= view.hi());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // dense_bin_op
+    //   Computes the union (or intersection) of two dense operands by walking
+    //   their buffers in lock-step instead of going through rrs::transform.
+    //   The output window is computed once, and each stretch of it where the
+    //   operands overlap in the same way is filled by a simple indexed loop,
+    //   which the compiler is free to vectorize. Returns false if the operands
+    //   have pre- or post-runs, in which case the caller must fall back to
+    //   rrs::transform.
+    template<typename Out, typename Left, typename Right, typename BinOp>
+    bool dense_bin_op(Out &, Left &, Right &, BinOp const &, bool, mpl::false_)
+    {
+        return false;
+    }
+
+    template<typename Out, typename Left, typename Right, typename BinOp>
+    bool dense_bin_op(Out &out, Left &left, Right &right, BinOp const &binop, bool is_union, mpl::true_)
+    {
+        typedef dense_view<typename remove_const<Left>::type> left_view;
+        typedef dense_view<typename remove_const<Right>::type> right_view;
+        typedef typename Out::value_type value_type;
+        typedef storage::dense_array<value_type, typename Out::allocator_type> array_type;
+        typedef std::pair<std::ptrdiff_t, std::ptrdiff_t> run_type;
+
+        left_view l(left);
+        right_view r(right);
+        if(!l.valid() || !r.valid())
+        {
+            return false;
+        }
+
+        value_type const zero = rrs::zero(out);
+        std::ptrdiff_t lo = 0, hi = 0;
+
+        if(l.everywhere())
+        {
+            lo = r.lo(), hi = r.hi();
+        }
+        else if(r.everywhere())
+        {
+            lo = l.lo(), hi = l.hi();
+        }
+        else if(!is_union)
+        {
+            lo = (std::max)(l.lo(), r.lo()), hi = (std::min)(l.hi(), r.hi());
+        }
+        else if(l.lo() == l.hi())
+        {
+            lo = r.lo(), hi = r.hi();
+        }
+        else if(r.lo() == r.hi())
+        {
+            lo = l.lo(), hi = l.hi();
+        }
+        else
+        {
+            lo = (std::min)(l.lo(), r.lo()), hi = (std::max)(l.hi(), r.hi());
+        }
+
+        if(lo >= hi)
+        {
+            // An everywhere() operand would need a pre-run of its own
+            if(is_union && (l.everywhere() || r.everywhere()))
+            {
+                return false;
+            }
+
+            lo = hi = 0;
+        }
+
+        array_type result(constructors::construct<array_type>(
+            time_series::start = lo
+          , time_series::stop = hi
+          , time_series::zero = zero
+          , time_series::allocator = time_series_facade_access::data(out).get_allocator()
+        ));
+
+        // The points at which either operand starts or stops, in order
+        std::ptrdiff_t cuts[6] = {lo, hi, l.lo(), l.hi(), r.lo(), r.hi()};
+        std::ptrdiff_t *const cuts_end = cuts + 6;
+        for(std::ptrdiff_t *c = cuts; c != cuts_end; ++c)
+        {
+            *c = (std::min)((std::max)(*c, lo), hi);
+        }
+        std::sort(cuts, cuts_end);
+
+        for(std::ptrdiff_t *c = cuts; c + 1 != cuts_end; ++c)
+        {
+            if(c[0] != c[1])
+            {
+                dense_segment(
+                    &*result.begin() + (c[0] - lo)
+                  , c[0]
+                  , c[1]
+                  , l
+                  , r
+                  , contains(l, c[0], c[1])
+                  , contains(r, c[0], c[1])
+                  , binop
+                  , zero
+                );
+            }
+        }
+
+        if(is_union && (l.everywhere() || r.everywhere()))
+        {
+            value_type const outside = binop(l.outside(), r.outside());
+            run_type const pre_run(static_cast<std::ptrdiff_t>(-inf), lo);
+            run_type const post_run(hi, static_cast<std::ptrdiff_t>(inf));
+            result.pre().set(pre_run, outside);
+            result.post().set(post_run, outside);
+        }
+
+        result.swap(time_series_facade_access::data(out));
+        return true;
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file result_allocator.hpp
+/// The allocator with which the result of an algorithm is built, taken from
+/// the series it is built from, and the empty result built with it
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_DETAIL_RESULT_ALLOCATOR_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_DETAIL_RESULT_ALLOCATOR_EAN_10_18_2026
+
+#include <memory>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_void.hpp>
+#include <boost/time_series/time_series_fwd.hpp>
+#include <boost/time_series/traits/allocator_type.hpp>
+#include <boost/detail/construct.hpp>
+
+namespace boost { namespace time_series { namespace detail
+{
+    // result_allocator
+    //   The allocator of the left operand, or else of the right one, rebound
+    //   to the value type of the result.
+    template<typename Allocator1, typename Allocator2, typename Value>
+    struct result_allocator
+    {
+        typedef typename Allocator1::template rebind<Value>::other type;
+    };
+
+    template<typename Allocator2, typename Value>
+    struct result_allocator<void, Allocator2, Value>
+    {
+        typedef typename Allocator2::template rebind<Value>::other type;
+    };
+
+    template<typename Value>
+    struct result_allocator<void, void, Value>
+    {
+        typedef std::allocator<Value> type;
+    };
+
+    // series_result_allocator
+    //   The allocator of a result with the given value type, built from the
+    //   series S1 or else from S2.
+    template<typename Value, typename S1, typename S2 = S1>
+    struct series_result_allocator
+      : result_allocator<
+            typename traits::allocator_type<S1>::type
+          , typename traits::allocator_type<S2>::type
+          , Value
+        >
+    {};
+
+    template<typename Allocator, typename S1, typename S2, typename S2HasNone>
+    Allocator get_result_allocator_(S1 const &s1, S2 const &, mpl::false_, S2HasNone)
+    {
+        return Allocator(s1.get_allocator());
+    }
+
+    template<typename Allocator, typename S1, typename S2>
+    Allocator get_result_allocator_(S1 const &, S2 const &s2, mpl::true_, mpl::false_)
+    {
+        return Allocator(s2.get_allocator());
+    }
+
+    template<typename Allocator, typename S1, typename S2>
+    Allocator get_result_allocator_(S1 const &, S2 const &, mpl::true_, mpl::true_)
+    {
+        return Allocator();
+    }
+
+    // get_result_allocator
+    //   A copy of the allocator of s1, or else of s2, converted to Allocator.
+    //   It is default-constructed only if neither series allocates.
+    template<typename Allocator, typename S1, typename S2>
+    Allocator get_result_allocator(S1 const &s1, S2 const &s2)
+    {
+        return detail::get_result_allocator_<Allocator>(
+            s1
+          , s2
+          , mpl::bool_<is_void<typename traits::allocator_type<S1>::type>::value>()
+          , mpl::bool_<is_void<typename traits::allocator_type<S2>::type>::value>()
+        );
+    }
+
+    template<typename Allocator, typename S1>
+    Allocator get_result_allocator(S1 const &s1)
+    {
+        return detail::get_result_allocator<Allocator>(s1, s1);
+    }
+
+    // make_result
+    //   An empty series of type Result to hold the result of an operation
+    //   on left and right. If Result allocates, it gets a copy of the
+    //   allocator of left, or else of right.
+    template<typename Result, typename Left, typename Right, typename Disc, typename Zero>
+    Result make_result(Left const &, Right const &, Disc const &disc, Zero const &zero, mpl::true_)
+    {
+        return constructors::construct<Result>(
+            time_series::discretization = disc
+          , time_series::zero = zero
+        );
+    }
+
+    template<typename Result, typename Left, typename Right, typename Disc, typename Zero>
+    Result make_result(Left const &left, Right const &right, Disc const &disc, Zero const &zero, mpl::false_)
+    {
+        typedef typename traits::allocator_type<Result>::type allocator_type;
+        return constructors::construct<Result>(
+            time_series::discretization = disc
+          , time_series::zero = zero
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(left, right)
+        );
+    }
+
+    template<typename Result, typename Left, typename Right, typename Disc, typename Zero>
+    Result make_result(Left const &left, Right const &right, Disc const &disc, Zero const &zero)
+    {
+        typedef typename traits::allocator_type<Result>::type allocator_type;
+        return detail::make_result<Result>(
+            left
+          , right
+          , disc
+          , zero
+          , mpl::bool_<is_void<allocator_type>::value>()
+        );
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,506 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ewma.hpp
+/// Calculate the exponentially weighted moving average of a series
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_EWMA_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_EWMA_EAN_10_18_2026
+
+#include <cmath>
+#include <vector>
+#include <boost/implicit_cast.hpp>
+#include <boost/concept/requires.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+
+        // The state after n more offsets of the value x
+        template<typename Result, typename Value, typename Decay, typename Offset>
+        Result ewma_advance(Result const &state, Value const &x, Decay decay, Offset n)
+        {
+            Result const value = x;
+            return value + (1 == n ? decay : std::pow(decay, n)) * (state - value);
+        }
+
+        // The average at the k-th offset, counting from 1, of a run of
+        // constant value that starts from the given state
+        template<typename Result, typename Value, typename Decay, typename Offset>
+        struct ewma_progression
+        {
+            typedef Result result_type;
+
+            ewma_progression(Result const &state, Value const &x, Decay decay)
+              : state_(state)
+              , x_(x)
+              , decay_(decay)
+            {}
+
+            Result operator ()(Offset k) const
+            {
+                return detail::ewma_advance<Result>(this->state_, this->x_, this->decay_, k);
+            }
+
+        private:
+            Result state_;
+            Value x_;
+            Decay decay_;
+        };
+
+        // ewma_inserter
+        //   Advances the average across each run, and across each gap between
+        //   runs at the zero of the series, in constant time by raising the
+        //   decay to the power of the length.
+        template<typename Out, typename Result, typename Value, typename Alpha, typename Offset>
+        struct ewma_inserter
+        {
+            typedef Value value_type;
+
+            ewma_inserter(Out const &out, Value const &zero, Alpha alpha)
+              : out_(out)
+              , zero_(zero)
+              , decay_(1 - alpha)
+              , state_(zero)
+              , offset_(-inf)
+            {}
+
+            template<typename Run>
+            void set_at(Run const &run, value_type const &value)
+            {
+                Offset start = rrs::offset(run);
+                Offset stop = rrs::end_offset(run);
+
+                if(-inf != this->offset_ && this->offset_ != start)
+                {
+                    this->state_ = detail::ewma_advance<Result>(this->state_, this->zero_, this->decay_, start - this->offset_);
+                }
+
+                this->state_ = detail::ewma_advance<Result>(this->state_, value, this->decay_, stop - start);
+                this->out_(this->state_, stop - 1);
+                this->offset_ = stop;
+            }
+
+            Out const &finalize() const
+            {
+                return this->out_;
+            }
+
+        private:
+            Out out_;
+            Value zero_;
+            Alpha decay_;
+            Result state_;
+            Offset offset_;
+        };
+
+        // ewma_filled_inserter
+        //   Writes the average at every offset from the start of the first run
+        //   to the end of the last, gaps included, one block per run and per
+        //   gap. Each value in a block comes from the closed form, so a run
+        //   costs no more than copying its averages into the result.
+        template<typename Out, typename Result, typename Value, typename Alpha, typename Offset>
+        struct ewma_filled_inserter
+        {
+            typedef Value value_type;
+
+            ewma_filled_inserter(Out const &out, Value const &zero, Alpha alpha)
+              : out_(out)
+              , zero_(zero)
+              , decay_(1 - alpha)
+              , state_(zero)
+              , offset_(-inf)
+            {}
+
+            template<typename Run>
+            void set_at(Run const &run, value_type const &value)
+            {
+                Offset start = rrs::offset(run);
+                Offset stop = rrs::end_offset(run);
+
+                if(-inf != this->offset_ && this->offset_ != start)
+                {
+                    this->fill_(this->zero_, this->offset_, start);
+                }
+
+                this->fill_(value, start, stop);
+                this->offset_ = stop;
+            }
+
+            Out const &finalize() const
+            {
+                return this->out_;
+            }
+
+        private:
+            void fill_(Value const &x, Offset start, Offset stop)
+            {
+                typedef ewma_progression<Result, Value, Alpha, Offset> progression;
+                typedef transform_iterator<progression, counting_iterator<Offset> > iterator;
+                progression const fun(this->state_, x, this->decay_);
+                this->out_.set_at_range(
+                    start
+                  , iterator(counting_iterator<Offset>(1), fun)
+                  , iterator(counting_iterator<Offset>(stop - start + 1), fun)
+                );
+                this->state_ = fun(stop - start);
+            }
+
+            Out out_;
+            Value zero_;
+            Alpha decay_;
+            Result state_;
+            Offset offset_;
+        };
+
+        // A dense or sparse series of arithmetic values without pre- or
+        // post-runs is averaged straight from its arrays, and written to the
+        // inserter in one block. Returns false if the series must go through
+        // ewma_inserter.
+        template<typename Result, typename Series, typename Alpha, typename Out>
+        bool ewma_fast(Series const &, Alpha, Out &)
+        {
+            return false;
+        }
+
+        template<typename Result, typename Value, typename Discretization, typename Allocator, typename Alpha, typename Out>
+        bool ewma_fast(dense_series<Value, Discretization, Allocator> const &series, Alpha alpha, Out &out)
+        {
+            storage::dense_array<Value, Allocator> const &data = time_series_facade_access::data(series);
+            if(!is_arithmetic<Value>::value
+            || data.pre().second != -inf
+            || data.post().first != inf)
+            {
+                return false;
+            }
+
+            Alpha const decay = 1 - alpha;
+            std::vector<Result> results(data.begin(), data.end());
+            Result state = implicit_cast<Value const &>(data.zero());
+            for(std::size_t i = 0; i != results.size(); ++i)
+            {
+                results[i] = state = alpha * results[i] + decay * state;
+            }
+
+            out.set_at_range(data.offset(), results.begin(), results.end());
+            return true;
+        }
+
+        template<typename Result, typename Value, typename Discretization, typename Offset, typename Allocator, typename Alpha, typename Out>
+        bool ewma_fast(sparse_series<Value, Discretization, Offset, Allocator> const &series, Alpha alpha, Out &out)
+        {
+            storage::sparse_array<Value, Offset, Allocator> const &data = time_series_facade_access::data(series);
+            if(!is_arithmetic<Value>::value
+            || !is_integral<Offset>::value
+            || data.pre().second != -inf
+            || data.post().first != inf)
+            {
+                return false;
+            }
+
+            Alpha const decay = 1 - alpha;
+            Value const zero = data.zero();
+            std::vector<Result> results(data.values_begin(), data.values_end());
+            Result state = zero;
+            typename storage::sparse_array<Value, Offset, Allocator>::const_iterator offset = data.begin();
+            for(std::size_t i = 0; i != results.size(); ++i, ++offset)
+            {
+                if(0 != i && *offset != offset[-1] + 1)
+                {
+                    state = detail::ewma_advance<Result>(state, zero, decay, *offset - offset[-1] - 1);
+                }
+                results[i] = state = alpha * results[i] + decay * state;
+            }
+
+            out.set_at_offsets(data.begin(), data.end(), results.begin());
+            return true;
+        }
+
+        // Like ewma_fast, but the averages in the gaps of a sparse series are
+        // written too. Every offset of a dense series is already written.
+        template<typename Result, typename Series, typename Alpha, typename Out>
+        bool ewma_filled_fast(Series const &, Alpha, Out &)
+        {
+            return false;
+        }
+
+        template<typename Result, typename Value, typename Discretization, typename Allocator, typename Alpha, typename Out>
+        bool ewma_filled_fast(dense_series<Value, Discretization, Allocator> const &series, Alpha alpha, Out &out)
+        {
+            return detail::ewma_fast<Result>(series, alpha, out);
+        }
+
+        template<typename Result, typename Value, typename Discretization, typename Offset, typename Allocator, typename Alpha, typename Out>
+        bool ewma_filled_fast(sparse_series<Value, Discretization, Offset, Allocator> const &series, Alpha alpha, Out &out)
+        {
+            storage::sparse_array<Value, Offset, Allocator> const &data = time_series_facade_access::data(series);
+            if(!is_arithmetic<Value>::value
+            || !is_integral<Offset>::value
+            || data.pre().second != -inf
+            || data.post().first != inf)
+            {
+                return false;
+            }
+
+            if(data.begin() == data.end())
+            {
+                return true;
+            }
+
+            Alpha const decay = 1 - alpha;
+            Result const zero = implicit_cast<Value const &>(data.zero());
+            Offset const first = *data.begin();
+            std::vector<Result> results(data.end()[-1] - first + 1);
+            Result state = zero;
+            typename storage::sparse_array<Value, Offset, Allocator>::const_iterator offset = data.begin();
+            typename storage::sparse_array<Value, Offset, Allocator>::values_type::const_iterator value = data.values_begin();
+            for(std::size_t i = 0; i != results.size(); ++i)
+            {
+                if(first + implicit_cast<Offset>(i) == *offset)
+                {
+                    state = alpha * *value + decay * state;
+                    ++offset;
+                    ++value;
+                }
+                else
+                {
+                    state = alpha * zero + decay * state;
+                }
+                results[i] = state;
+            }
+
+            out.set_at_range(first, results.begin(), results.end());
+            return true;
+        }
+    }
+
+    /// \brief Calculate the exponentially weighted moving average of a series.
+    ///
+    /// The average at offset \em i is <tt>alpha * series[i] + (1 - alpha) * a</tt>,
+    ///     where \em a is the average at offset \em i-1, and the average before
+    ///     the first run is the zero of the series. The gaps between runs count
+    ///     as the zero of the series.
+    ///
+    /// Across a run of length \em L with value \em x, the average at the
+    ///     \em k-th offset of the run, counting from 1, is
+    ///     <tt>x + pow(1 - alpha, k) * (a - x)</tt>, where \em a is the average
+    ///     before the run. The state is carried from run to run in constant
+    ///     time, and the averages within a run are written as one block.
+    ///
+    /// The average is written at every offset from the start of the first run
+    ///     of \c series to the end of its last run, including the offsets in
+    ///     the gaps between runs. Before the first run the average is the zero
+    ///     of the series. After the last run the average decays towards zero
+    ///     and is not written; use \c ewma_at_run_ends() for the state at the
+    ///     end of each run alone.
+    ///
+    /// A dense or sparse series of arithmetic values with no pre- or post-runs
+    ///     is averaged straight from its arrays and written to \c out in one block.
+    ///
+    /// \param series The input series.
+    /// \param alpha The weight of the newest value.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre \c Series is a model of the \c TimeSeries concept, with integral offsets.
+    /// \pre \c Out is a model of the \c OrderedInserter concept.
+    /// \pre <tt>0 < alpha && alpha <= 1</tt>
+    /// \pre <tt>series[-inf] == range_run_storage::zero(series)</tt>
+    /// \pre <tt>series[inf] == range_run_storage::zero(series)</tt>
+    /// \return A \c dense_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Alpha, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    ewma(Series const &series, Alpha alpha, ordered_inserter<Out> out)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef typename series_concept::value_type value_type;
+        typedef typename series_concept::offset_type offset_type;
+        typedef typename numeric::functional::multiplies<Alpha, value_type>::result_type result_type;
+
+        BOOST_MPL_ASSERT((is_integral<offset_type>));
+
+        if(detail::ewma_filled_fast<result_type>(series, alpha, out))
+        {
+            return out;
+        }
+
+        detail::ewma_filled_inserter<ordered_inserter<Out>, result_type, value_type, Alpha, offset_type> o(
+            out
+          , implicit_cast<value_type const &>(range_run_storage::zero(series))
+          , alpha
+        );
+
+        return range_run_storage::copy(series, o).finalize();
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Alpha>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (dense_series<
+        typename numeric::functional::multiplies<
+            Alpha
+          , typename concepts::TimeSeries<Series const>::value_type
+        >::result_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , typename detail::series_result_allocator<
+            typename numeric::functional::multiplies<
+                Alpha
+              , typename concepts::TimeSeries<Series const>::value_type
+            >::result_type
+          , Series
+        >::type
+    >))
+    ewma(Series const &series, Alpha alpha)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef typename numeric::functional::multiplies<
+            Alpha
+          , typename series_concept::value_type
+        >::result_type result_type;
+        typedef typename detail::series_result_allocator<result_type, Series>::type allocator_type;
+
+        dense_series<
+            result_type
+          , typename series_concept::discretization_type
+          , allocator_type
+        > result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::ewma(series, alpha, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+    /// \brief Calculate the exponentially weighted moving average of a series
+    ///     at the last offset of each of its runs.
+    ///
+    /// The average at offset \em i is <tt>alpha * series[i] + (1 - alpha) * a</tt>,
+    ///     where \em a is the average at offset \em i-1, and the average before
+    ///     the first run is the zero of the series. The gaps between runs count
+    ///     as the zero of the series.
+    ///
+    /// Across a run of length \em L with value \em x, the average moves from
+    ///     \em a to <tt>x + pow(1 - alpha, L) * (a - x)</tt>, so each run costs
+    ///     constant time whatever its length. For that reason only the average
+    ///     at the last offset of each run is written; the average at the
+    ///     \em k-th offset of the run, counting from 1, is
+    ///     <tt>x + pow(1 - alpha, k) * (a - x)</tt>. For a dense series every
+    ///     offset is the last offset of its run, so the result holds the
+    ///     average at every offset. \c ewma() writes the average at every
+    ///     offset of any series.
+    ///
+    /// A dense or sparse series of arithmetic values with no pre- or post-runs
+    ///     is averaged straight from its arrays and written to \c out in one block.
+    ///
+    /// \param series The input series.
+    /// \param alpha The weight of the newest value.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre \c Series is a model of the \c TimeSeries concept, with integral offsets.
+    /// \pre \c Out is a model of the \c OrderedInserter concept.
+    /// \pre <tt>0 < alpha && alpha <= 1</tt>
+    /// \pre <tt>series[-inf] == range_run_storage::zero(series)</tt>
+    /// \pre <tt>series[inf] == range_run_storage::zero(series)</tt>
+    /// \return A \c sparse_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter. Either way the result has values
+    ///     only at the last offset of each run of \c series; at every other
+    ///     offset it holds zero, not the average.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Alpha, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    ewma_at_run_ends(Series const &series, Alpha alpha, ordered_inserter<Out> out)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef typename series_concept::value_type value_type;
+        typedef typename series_concept::offset_type offset_type;
+        typedef typename numeric::functional::multiplies<Alpha, value_type>::result_type result_type;
+
+        BOOST_MPL_ASSERT((is_integral<offset_type>));
+
+        if(detail::ewma_fast<result_type>(series, alpha, out))
+        {
+            return out;
+        }
+
+        detail::ewma_inserter<ordered_inserter<Out>, result_type, value_type, Alpha, offset_type> o(
+            out
+          , implicit_cast<value_type const &>(range_run_storage::zero(series))
+          , alpha
+        );
+
+        return range_run_storage::copy(series, o).finalize();
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Alpha>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (sparse_series<
+        typename numeric::functional::multiplies<
+            Alpha
+          , typename concepts::TimeSeries<Series const>::value_type
+        >::result_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , typename concepts::TimeSeries<Series const>::offset_type
+      , typename detail::series_result_allocator<
+            typename numeric::functional::multiplies<
+                Alpha
+              , typename concepts::TimeSeries<Series const>::value_type
+            >::result_type
+          , Series
+        >::type
+    >))
+    ewma_at_run_ends(Series const &series, Alpha alpha)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef typename numeric::functional::multiplies<
+            Alpha
+          , typename series_concept::value_type
+        >::result_type result_type;
+        typedef typename detail::series_result_allocator<result_type, Series>::type allocator_type;
+
+        sparse_series<
+            result_type
+          , typename series_concept::discretization_type
+          , typename series_concept::offset_type
+          , allocator_type
+        > result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::ewma_at_run_ends(series, alpha, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_EWMA_EAN_10_18_2026
@@ -5,13 +5,18 @@
 #ifndef BOOST_TIME_SERIES_NUMERIC_FINE_GRAIN_060614_HPP
 # define BOOST_TIME_SERIES_NUMERIC_FINE_GRAIN_060614_HPP
 
+#include <memory>
+#include <cstddef>
 #include <boost/concept/requires.hpp>
+#include <boost/mpl/apply_wrap.hpp>
 #include <boost/detail/pod_singleton.hpp>
 #include <boost/range_run_storage/algorithm/for_each.hpp>
 #include <boost/time_series/concepts.hpp>
 #include <boost/time_series/sparse_series.hpp>
 #include <boost/time_series/piecewise_constant_series.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/traits/allocator_type.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 
 namespace boost { namespace time_series
 {
@@ -34,10 +39,10 @@ namespace boost { namespace time_series
         struct piecewise_upsample
           : sampler_base<piecewise_upsample>
         {
-            template <typename ValueType, typename Discretization>
+            template <typename ValueType, typename Discretization, typename Allocator = std::allocator<ValueType> >
             struct apply
             {
-                typedef piecewise_constant_series<ValueType, Discretization> type;
+                typedef piecewise_constant_series<ValueType, Discretization, std::ptrdiff_t, Allocator> type;
             };
 
             template <typename Value, typename Offset, typename Out>
@@ -53,10 +58,10 @@ namespace boost { namespace time_series
         struct sparse_upsample
           : sampler_base<sparse_upsample>
         {
-            template <typename ValueType, typename Discretization>
+            template <typename ValueType, typename Discretization, typename Allocator = std::allocator<ValueType> >
             struct apply
             {
-                typedef sparse_series<ValueType, Discretization> type;
+                typedef sparse_series<ValueType, Discretization, std::ptrdiff_t, Allocator> type;
             };
 
             template <typename Value, typename Offset, typename Out>
@@ -120,6 +125,8 @@ namespace boost { namespace time_series
     ///     value is a <tt>sparse_series\<\></tt> containing the finer-grained series. Otherwise,
     ///     if you specify the \c piecewise_upsample, the return value is a
     ///     <tt>piecewise_constant_series\<\></tt> containing the finer-grained series.
+    ///     A returned series gets a copy of the allocator of \c series, if it
+    ///     has one.
     /// \attention If using the version that takes an \c OrderedInserter, you must call
     ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
     /// \pre The coarser discretization is a multiple of the finer discretization.
@@ -172,10 +179,14 @@ namespace boost { namespace time_series
     template<typename Series, typename Discretization, typename UpSampler>
     BOOST_CONCEPT_REQUIRES(
         ((concepts::TimeSeries<Series const>)),
-    (typename mpl::apply_wrap2<
+    (typename mpl::apply_wrap3<
         UpSampler
       , typename concepts::TimeSeries<Series const>::value_type
       , Discretization
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >::type))
     fine_grain(
         Series const &series
@@ -188,13 +199,18 @@ namespace boost { namespace time_series
         BOOST_ASSERT(series.discretization() > discretization);
         BOOST_ASSERT(series.discretization() % discretization == 0);
 
-        typedef typename mpl::apply_wrap2<
+        typedef typename mpl::apply_wrap3<
             UpSampler
           , value_type
           , Discretization
+          , typename detail::series_result_allocator<value_type, Series>::type
         >::type result_type;
+        typedef typename traits::allocator_type<result_type>::type allocator_type;
 
-        result_type result(time_series::discretization = discretization);
+        result_type result(
+            time_series::discretization = discretization
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
 
         time_series::fine_grain(
             series
@@ -211,10 +227,14 @@ namespace boost { namespace time_series
     template <typename Series, typename Discretization>
     BOOST_CONCEPT_REQUIRES(
         ((concepts::TimeSeries<Series const>)),
-    (typename mpl::apply_wrap2<
+    (typename mpl::apply_wrap3<
         samplers::piecewise_upsample
       , typename concepts::TimeSeries<Series const>::value_type
       , Discretization
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >::type))
     fine_grain(Series const &series, Discretization discretization)
     {
@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file integral_index.hpp
+/// A cumulative-sum index over a series, for answering the sum over any
+/// range of offsets with two searches
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_INTEGRAL_INDEX_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_INTEGRAL_INDEX_EAN_10_18_2026
+
+#include <vector>
+#include <algorithm>
+#include <boost/concept/requires.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/result_iterator.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+
+namespace boost { namespace time_series
+{
+
+    /// \brief The running sum of a series, for answering the sum over any
+    ///     range of offsets in logarithmic time.
+    ///
+    /// An \c integral_index\<\> records the runs of a series and the sum of
+    ///     <tt>value * length</tt> over all the runs before each one. The sum
+    ///     of the series over <tt>[start, stop)</tt> is then the difference
+    ///     of two running sums, each found by a binary search. This pays off
+    ///     when the same series is summed over many different ranges or
+    ///     period grids; the \c variable_period_sums() and
+    ///     \c shifted_variable_period_sums() members answer the same queries
+    ///     as the algorithms of those names.
+    ///
+    /// The index is a snapshot: it holds its own copy of the runs, and must
+    ///     be rebuilt to see later changes to the series. As with
+    ///     \c variable_period_sums(), the zero of the series does not
+    ///     contribute to the sums, and a range that reaches into a non-zero
+    ///     infinite pre- or post-run has no finite sum.
+    template<typename Value, typename Discretization = int, typename Offset = std::ptrdiff_t>
+    struct integral_index
+    {
+        typedef Value value_type;
+        typedef Discretization discretization_type;
+        typedef Offset offset_type;
+
+        /// Records the runs of \c series
+        ///
+        /// \param series The series to index.
+        /// \pre \c Series is a model of the \c TimeSeries concept, with
+        ///     offsets and values convertible to \c Offset and \c Value.
+        template<typename Series>
+        explicit integral_index(Series const &series)
+          : discretization_(series.discretization())
+          , starts_()
+          , ends_()
+          , values_()
+          , sums_(1, numeric::zero<Value>::value)
+          , pre_end_(-inf)
+          , pre_value_(numeric::zero<Value>::value)
+          , post_start_(inf)
+          , post_value_(numeric::zero<Value>::value)
+        {
+            namespace rrs = range_run_storage;
+            typedef concepts::TimeSeries<Series const> series_concept;
+            typename series_concept::runs runs = rrs::runs(series);
+            typename series_concept::elements elements = sequence::elements(series);
+            typename series_concept::cursor begin = sequence::begin(series);
+            typename series_concept::cursor end = sequence::end(series);
+
+            this->add_(rrs::pre_run(series), rrs::pre_value(series));
+            for(; begin != end; ++begin)
+            {
+                this->add_(runs(*begin), elements(*begin));
+            }
+            this->add_(rrs::post_run(series), rrs::post_value(series));
+        }
+
+        /// \return The sum of <tt>value * length</tt> over the parts of the
+        ///     runs that lie within <tt>[start, stop)</tt>.
+        /// \pre <tt>start <= stop</tt>
+        Value sum(Offset start, Offset stop) const
+        {
+            return this->running_sum(stop) - this->running_sum(start);
+        }
+
+        /// \return <tt>this->sum(start, stop)</tt>, multiplied by the discretization
+        ///     of the series.
+        /// \pre <tt>start <= stop</tt>
+        Value integral(Offset start, Offset stop) const
+        {
+            return this->sum(start, stop) * this->discretization_;
+        }
+
+        /// \return The running sum of the series up to \c offset. Only the
+        ///     difference between two running sums is meaningful.
+        Value running_sum(Offset offset) const
+        {
+            // The runs that end at or before offset count in full, and the
+            // next one counts in part.
+            std::size_t i = std::upper_bound(this->ends_.begin(), this->ends_.end(), offset)
+                          - this->ends_.begin();
+
+            Value result = this->sums_[i];
+            if(i != this->starts_.size() && this->starts_[i] < offset)
+            {
+                result += this->values_[i] * (offset - this->starts_[i]);
+            }
+
+            // Infinite runs are measured from their finite end.
+            if(-inf != this->pre_end_ && offset < this->pre_end_)
+            {
+                result += this->pre_value_ * (offset - this->pre_end_);
+            }
+
+            if(inf != this->post_start_ && this->post_start_ < offset)
+            {
+                result += this->post_value_ * (offset - this->post_start_);
+            }
+
+            return result;
+        }
+
+        /// \return The discretization of the indexed series
+        ///
+        Discretization discretization() const
+        {
+            return this->discretization_;
+        }
+
+        /// Same as <tt>time_series::variable_period_sums(series, periods, out)</tt>
+        ///     for the indexed series, but each sum costs two binary searches
+        ///     instead of a pass over the series.
+        ///
+        /// \param periods The periods over which to calculate the sums.
+        /// \param out The inserter into which to write the new series.
+        /// \pre \c Periods is a model of the \c RandomAccessRange concept.
+        /// \pre \c Out is a model of the \c OrderedInserter concept.
+        template<typename Periods, typename Out>
+        ordered_inserter<Out> variable_period_sums(Periods const &periods, ordered_inserter<Out> out) const
+        {
+            return this->period_sums_(periods, static_cast<Periods const *>(0), out);
+        }
+
+        /// \overload
+        ///
+        template<typename Periods>
+        sparse_series<Value, Discretization, Offset> variable_period_sums(Periods const &periods) const
+        {
+            sparse_series<Value, Discretization, Offset> result(
+                time_series::discretization = this->discretization_
+            );
+            this->variable_period_sums(periods, time_series::make_ordered_inserter(result)).commit();
+            return result;
+        }
+
+        /// Same as <tt>time_series::shifted_variable_period_sums(series, periods, shifts, out)</tt>
+        ///     for the indexed series, but each sum costs two binary searches
+        ///     instead of a pass over the series.
+        ///
+        /// \param periods The periods over which to calculate the sums.
+        /// \param shifts The shift offsets for each period.
+        /// \param out The inserter into which to write the new series.
+        /// \pre \c Periods is a model of the \c RandomAccessRange concept.
+        /// \pre \c Shifts is a model of the \c RandomAccessRange concept.
+        /// \pre \c Out is a model of the \c OrderedInserter concept.
+        /// \pre <tt> \verbatim boost::size(periods) == boost::size(shifts) \endverbatim </tt>
+        template<typename Periods, typename Shifts, typename Out>
+        ordered_inserter<Out> shifted_variable_period_sums(Periods const &periods, Shifts const &shifts, ordered_inserter<Out> out) const
+        {
+            return this->period_sums_(periods, &shifts, out);
+        }
+
+        /// \overload
+        ///
+        template<typename Periods, typename Shifts>
+        sparse_series<Value, Discretization, Offset> shifted_variable_period_sums(Periods const &periods, Shifts const &shifts) const
+        {
+            sparse_series<Value, Discretization, Offset> result(
+                time_series::discretization = this->discretization_
+            );
+            this->shifted_variable_period_sums(periods, shifts, time_series::make_ordered_inserter(result)).commit();
+            return result;
+        }
+
+    private:
+        // The sum over each period is the difference of the running sums at
+        // its ends.
+        template<typename Periods, typename Shifts, typename Out>
+        Out period_sums_(Periods const &periods, Shifts const *shifts, Out out) const
+        {
+            typedef typename range_result_iterator<Periods const>::type iterator;
+            iterator begin = boost::begin(periods), end = boost::end(periods);
+            if(begin == end)
+            {
+                return out;
+            }
+
+            Value prev = this->running_sum(*begin);
+            for(std::size_t i = 0; begin != end; ++begin, ++i)
+            {
+                iterator next = begin + 1;
+                Value sum = this->running_sum(next != end ? Offset(*next) : Offset(inf));
+                Offset offset = *begin;
+                if(shifts)
+                {
+                    offset += *(boost::begin(*shifts) + i);
+                }
+                out(sum - prev, offset);
+                prev = sum;
+            }
+
+            return out;
+        }
+
+        template<typename Run, typename V>
+        void add_(Run const &run, V const &v)
+        {
+            namespace rrs = range_run_storage;
+            if(rrs::empty(run))
+            {
+                return;
+            }
+
+            Value const &value = v;
+            Offset start = rrs::offset(run);
+            Offset stop = rrs::end_offset(run);
+
+            if(-inf == start)
+            {
+                this->pre_end_ = stop;
+                this->pre_value_ = value;
+            }
+            else if(inf == stop)
+            {
+                this->post_start_ = start;
+                this->post_value_ = value;
+            }
+            else
+            {
+                this->starts_.push_back(start);
+                this->ends_.push_back(stop);
+                this->values_.push_back(value);
+                this->sums_.push_back(this->sums_.back() + value * (stop - start));
+            }
+        }
+
+        Discretization discretization_;
+        std::vector<Offset> starts_;
+        std::vector<Offset> ends_;
+        std::vector<Value> values_;
+        std::vector<Value> sums_;   // sums_[i] is the sum of the runs before run i
+        Offset pre_end_;
+        Value pre_value_;
+        Offset post_start_;
+        Value post_value_;
+    };
+
+    /// \brief Builds an \c integral_index\<\> for a series.
+    ///
+    /// \param series The series to index.
+    /// \return <tt>integral_index\<value_type, discretization_type, offset_type\>(series)</tt>
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (integral_index<
+        typename concepts::TimeSeries<Series const>::value_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , typename concepts::TimeSeries<Series const>::offset_type
+    >))
+    make_integral_index(Series const &series)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        return integral_index<
+            typename series_concept::value_type
+          , typename series_concept::discretization_type
+          , typename series_concept::offset_type
+        >(series);
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_INTEGRAL_INDEX_EAN_10_18_2026
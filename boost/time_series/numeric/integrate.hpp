@@ -9,17 +9,92 @@
 #ifndef BOOST_TIME_SERIES_NUMERIC_INTEGRATE_EAN_06_14_2006
 #define BOOST_TIME_SERIES_NUMERIC_INTEGRATE_EAN_06_14_2006
 
+#include <cmath>
+#include <cstddef>
+#include <numeric>
 #include <boost/implicit_cast.hpp>
 #include <boost/concept/requires.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
 #include <boost/range_run_storage/algorithm/copy.hpp>
 #include <boost/time_series/concepts.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
 #include <boost/time_series/utility/time_series_base.hpp>
 
 namespace boost { namespace time_series
 {
     namespace detail
     {
+        // Adds x to sum, and the rounding error of the addition to carry
+        // (Neumaier's variant of Kahan summation). Written without branches
+        // so that the lanes of compensated_sum() can be vectorized.
         template<typename Value>
+        void compensated_add(Value &sum, Value &carry, Value x)
+        {
+            Value const total = sum + x;
+            bool const sum_is_bigger = std::abs(sum) >= std::abs(x);
+            Value const big = sum_is_bigger ? sum : x;
+            Value const small = sum_is_bigger ? x : sum;
+            carry += (big - total) + small;
+            sum = total;
+        }
+
+        // The compensated sum of the random-access range [begin, end) and
+        // init, accumulated in four independent lanes so that each
+        // addition does not wait on the last.
+        template<typename Iter, typename Value>
+        Value compensated_sum(Iter begin, Iter end, Value init)
+        {
+            Value sum[4] = {init, Value(), Value(), Value()};
+            Value carry[4] = {Value(), Value(), Value(), Value()};
+
+            std::ptrdiff_t const size = end - begin;
+            std::ptrdiff_t i = 0;
+            for(; i + 4 <= size; i += 4)
+            {
+                for(int lane = 0; lane < 4; ++lane)
+                {
+                    detail::compensated_add(sum[lane], carry[lane], begin[i + lane]);
+                }
+            }
+            for(; i < size; ++i)
+            {
+                detail::compensated_add(sum[0], carry[0], begin[i]);
+            }
+
+            Value total = sum[0];
+            Value total_carry = carry[0];
+            for(int lane = 1; lane < 4; ++lane)
+            {
+                detail::compensated_add(total, total_carry, sum[lane]);
+                total_carry += carry[lane];
+            }
+            return total + total_carry;
+        }
+
+        // The sum of [begin, end) and init; compensated for floating-point values
+        template<typename Iter, typename Value>
+        Value sum_values(Iter begin, Iter end, Value init, mpl::true_)
+        {
+            return detail::compensated_sum(begin, end, init);
+        }
+
+        template<typename Iter, typename Value>
+        Value sum_values(Iter begin, Iter end, Value init, mpl::false_)
+        {
+            return std::accumulate(begin, end, init);
+        }
+
+        template<typename Iter, typename Value>
+        Value sum_values(Iter begin, Iter end, Value init)
+        {
+            return detail::sum_values(begin, end, init, is_floating_point<Value>());
+        }
+
+        template<typename Value, bool Compensate = is_floating_point<Value>::value>
         struct integrate_inserter
         {
             explicit integrate_inserter(Value const &value)
@@ -39,6 +114,73 @@ namespace boost { namespace time_series
         private:
             Value value_;
         };
+
+        // Floating-point runs are summed with compensation
+        template<typename Value>
+        struct integrate_inserter<Value, true>
+        {
+            explicit integrate_inserter(Value const &value)
+              : value_(value)
+              , carry_()
+              , total_(value)
+            {}
+
+            template<typename Run>
+            void set_at(Run const &run, Value const &value)
+            {
+                detail::compensated_add(this->value_, this->carry_, Value(value * range_run_storage::length(run)));
+                this->total_ = this->value_ + this->carry_;
+            }
+
+            Value const &value() const
+            {
+                return this->total_;
+            }
+        private:
+            Value value_;
+            Value carry_;
+            Value total_;
+        };
+
+        // Every run of a sparse series with integral offsets has length 1, so
+        // unless it has pre- or post-runs, its sum is the sum of its values
+        // array. The same goes for the buffer of a dense series.
+        template<typename Series, typename Value>
+        bool integrate_values(Series const &, Value &)
+        {
+            return false;
+        }
+
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        bool integrate_values(sparse_series<Value, Discretization, Offset, Allocator> const &series, Value &value)
+        {
+            storage::sparse_array<Value, Offset, Allocator> const &data = time_series_facade_access::data(series);
+            if(!is_arithmetic<Value>::value
+            || !is_integral<Offset>::value
+            || data.pre().first != data.pre().second
+            || data.post().first != data.post().second)
+            {
+                return false;
+            }
+
+            value = detail::sum_values(data.values_begin(), data.values_end(), value);
+            return true;
+        }
+
+        template<typename Value, typename Discretization, typename Allocator>
+        bool integrate_values(dense_series<Value, Discretization, Allocator> const &series, Value &value)
+        {
+            storage::dense_array<Value, Allocator> const &data = time_series_facade_access::data(series);
+            if(!is_arithmetic<Value>::value
+            || data.pre().second != -inf
+            || data.post().first != inf)
+            {
+                return false;
+            }
+
+            value = detail::sum_values(data.begin(), data.end(), value);
+            return true;
+        }
     }
 
     /// \brief Calculates the integral of the series. 
@@ -57,6 +199,11 @@ namespace boost { namespace time_series
     ///     multiplied by the series discretization.
     /// \attention Currently assumes the zeros of the series do not participate
     ///     in the integral.
+    /// \note Floating-point values are summed with Neumaier compensation, so the
+    ///     rounding error does not grow with the number of runs. The buffer of a
+    ///     dense or sparse series is summed directly, in several independent
+    ///     accumulators. Compiling with options that let the compiler reassociate
+    ///     floating-point arithmetic, such as \c -ffast-math, defeats the compensation.
     template<typename Series>
     BOOST_CONCEPT_REQUIRES(
         ((concepts::TimeSeries<Series const>)),
@@ -65,8 +212,13 @@ namespace boost { namespace time_series
     {
         typedef typename concepts::TimeSeries<Series const>::value_type value_type;
 
-        detail::integrate_inserter<value_type> o(
-            implicit_cast<value_type const &>(range_run_storage::zero(series)));
+        value_type value = implicit_cast<value_type const &>(range_run_storage::zero(series));
+        if(detail::integrate_values(series, value))
+        {
+            return value * series.discretization();
+        }
+
+        detail::integrate_inserter<value_type> o(value);
         range_run_storage::copy(series, o);
         return o.value() * series.discretization();
     }
@@ -14,6 +14,7 @@
 #include <boost/numeric/functional.hpp>
 #include <boost/time_series/concepts.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 #include <boost/range_run_storage/algorithm/transform.hpp>
 
 namespace boost { namespace time_series
@@ -57,9 +58,11 @@ namespace boost { namespace time_series
     (Series const))
     invert_elements(Series const &series)
     {
-        Series result(constructors::construct<Series>(
-            time_series::discretization = series.discretization()
-          , time_series::zero = range_run_storage::zero(series)
+        Series result(detail::make_result<Series>(
+            series
+          , series
+          , series.discretization()
+          , range_run_storage::zero(series)
         ));
         
         time_series::invert_elements(
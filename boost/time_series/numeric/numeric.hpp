@@ -18,10 +18,13 @@
 #include <boost/range_run_storage/algorithm/transform.hpp>
 #include <boost/time_series/time_series_fwd.hpp>
 #include <boost/time_series/concepts.hpp>
+#include <boost/time_series/traits/allocator_type.hpp>
 #include <boost/time_series/traits/generate_series.hpp>
 #include <boost/time_series/traits/promotion.hpp>
 #include <boost/time_series/scaled_series.hpp>
 #include <boost/time_series/numeric/detail/zero.hpp>
+#include <boost/time_series/numeric/detail/dense_bin_op.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 #include <boost/detail/construct.hpp>
 
 namespace boost { namespace time_series
@@ -37,6 +40,11 @@ namespace boost { namespace time_series
         template<typename Out, typename Left, typename Right, typename BinOp>
         Out &run_bin_op_union(Out &out, Left &left, Right &right, BinOp const &binop)
         {
+            if(detail::dense_bin_op(out, left, right, binop, true, is_dense_bin_op<Out, Left, Right>()))
+            {
+                return out;
+            }
+
             typename Mutable_TimeSeries<Out>::ordered_inserter_type
                 o(rrs::ordered_inserter(out));
 
@@ -51,6 +59,11 @@ namespace boost { namespace time_series
         template<typename Out, typename Left, typename Right, typename BinOp>
         Out &run_bin_op_intersection(Out &out, Left &left, Right &right, BinOp const &binop)
         {
+            if(detail::dense_bin_op(out, left, right, binop, false, is_dense_bin_op<Out, Left, Right>()))
+            {
+                return out;
+            }
+
             typename Mutable_TimeSeries<Out>::ordered_inserter_type
                 o(rrs::ordered_inserter(out));
 
@@ -78,8 +91,12 @@ namespace boost { namespace time_series
             BOOST_MPL_ASSERT((is_same<offset1_type, offset2_type>)); // is there a better option?
             typedef offset1_type offset_type;
             
+            typedef typename series_result_allocator<
+                value_type, S1, S2
+            >::type allocator_type;
+
             typedef typename traits::generate_series<
-                storage_category, value_type, Disc, offset_type
+                storage_category, value_type, Disc, offset_type, allocator_type
             >::type result_type;
         };
 
@@ -159,11 +176,11 @@ namespace boost { namespace time_series
         typedef detail::operation_traits<Left, Right, traits::plus<_, _>, numeric::op::plus> op_traits;
         typedef typename op_traits::result_type result_type;
 
-        result_type result(constructors::construct<result_type>(
-            time_series::discretization
-              = detail::make_discretization(left.cast().discretization(), right.cast().discretization())
-          , time_series::zero
-              = detail::make_zero(left.cast(), right.cast(), numeric::plus)
+        result_type result(detail::make_result<result_type>(
+            left.cast()
+          , right.cast()
+          , detail::make_discretization(left.cast().discretization(), right.cast().discretization())
+          , detail::make_zero(left.cast(), right.cast(), numeric::plus)
         ));
 
         return detail::run_bin_op_union(result, left.cast(), right.cast(), numeric::plus);
@@ -178,11 +195,11 @@ namespace boost { namespace time_series
         typedef detail::operation_traits<Left, Right, traits::minus<_, _>, numeric::op::minus> op_traits;
         typedef typename op_traits::result_type result_type;
 
-        result_type result(constructors::construct<result_type>(
-            time_series::discretization
-              = detail::make_discretization(left.cast().discretization(), right.cast().discretization())
-          , time_series::zero
-              = detail::make_zero(left.cast(), right.cast(), numeric::minus)
+        result_type result(detail::make_result<result_type>(
+            left.cast()
+          , right.cast()
+          , detail::make_discretization(left.cast().discretization(), right.cast().discretization())
+          , detail::make_zero(left.cast(), right.cast(), numeric::minus)
         ));
 
         return detail::run_bin_op_union(result, left.cast(), right.cast(), numeric::minus);
@@ -197,11 +214,11 @@ namespace boost { namespace time_series
         typedef detail::operation_traits<Left, Right, traits::multiplies<_, _>, numeric::op::multiplies> op_traits;
         typedef typename op_traits::result_type result_type;
 
-        result_type result(constructors::construct<result_type>(
-            time_series::discretization
-              = detail::make_discretization(left.cast().discretization(), right.cast().discretization())
-          , time_series::zero
-              = detail::make_zero(left.cast(), right.cast(), numeric::multiplies)
+        result_type result(detail::make_result<result_type>(
+            left.cast()
+          , right.cast()
+          , detail::make_discretization(left.cast().discretization(), right.cast().discretization())
+          , detail::make_zero(left.cast(), right.cast(), numeric::multiplies)
         ));
 
         return detail::run_bin_op_intersection(result, left.cast(), right.cast(), numeric::multiplies);
@@ -217,11 +234,11 @@ namespace boost { namespace time_series
         typedef typename op_traits::result_type result_type;
 
         // BUGBUG possible divide by zero, so use multiplies instead of divides here ...
-        result_type result(constructors::construct<result_type>(
-            time_series::discretization
-              = detail::make_discretization(left.cast().discretization(), right.cast().discretization())
-          , time_series::zero
-              = detail::make_zero(left.cast(), right.cast(), numeric::multiplies)
+        result_type result(detail::make_result<result_type>(
+            left.cast()
+          , right.cast()
+          , detail::make_discretization(left.cast().discretization(), right.cast().discretization())
+          , detail::make_zero(left.cast(), right.cast(), numeric::multiplies)
         ));
 
         return detail::run_bin_op_intersection(result, left.cast(), right.cast(), numeric::divides);
@@ -270,11 +287,11 @@ namespace boost { namespace time_series
         BOOST_ASSERT(left.cast().discretization() == right.cast().discretization());
 
         // BUGBUG not optimal
-        Left result(constructors::construct<Left>(
-            time_series::discretization
-              = detail::make_discretization(left.cast().discretization(), right.cast().discretization())
-          , time_series::zero
-              = detail::make_zero(left.cast(), right.cast(), numeric::multiplies)
+        Left result(detail::make_result<Left>(
+            left.cast()
+          , right.cast()
+          , detail::make_discretization(left.cast().discretization(), right.cast().discretization())
+          , detail::make_zero(left.cast(), right.cast(), numeric::multiplies)
         ));
 
         left.cast().swap(detail::run_bin_op_intersection(result, left.cast(), right.cast(), numeric::multiplies));
@@ -299,11 +316,11 @@ namespace boost { namespace time_series
 
         // BUGBUG not optimal
         // BUGBUG possible divide by zero, so use multiplies instead of divides here ...
-        Left result(constructors::construct<Left>(
-            time_series::discretization
-              = detail::make_discretization(left.cast().discretization(), right.cast().discretization())
-          , time_series::zero
-              = detail::make_zero(left.cast(), right.cast(), numeric::multiplies)
+        Left result(detail::make_result<Left>(
+            left.cast()
+          , right.cast()
+          , detail::make_discretization(left.cast().discretization(), right.cast().discretization())
+          , detail::make_zero(left.cast(), right.cast(), numeric::multiplies)
         ));
 
         left.cast().swap(detail::run_bin_op_intersection(result, left.cast(), right.cast(), numeric::divides));
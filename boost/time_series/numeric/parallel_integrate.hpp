@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file parallel_integrate.hpp
+/// Multi-threaded version of \c integrate
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_PARALLEL_INTEGRATE_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_PARALLEL_INTEGRATE_EAN_10_18_2026
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <boost/implicit_cast.hpp>
+#include <boost/concept/requires.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/range_run_storage/algorithm/parallel.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/numeric/integrate.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        // The sum of one block of a buffer
+        template<typename Iter, typename Value>
+        struct integrate_block_task
+        {
+            integrate_block_task(Iter begin, Iter end, Value *total)
+              : begin_(begin), end_(end), total_(total)
+            {}
+
+            void operator ()() const
+            {
+                *this->total_ = detail::sum_values(this->begin_, this->end_, Value());
+            }
+
+        private:
+            Iter begin_;
+            Iter end_;
+            Value *total_;
+        };
+
+        // Sums [begin, end) in one block per thread, then sums the totals
+        // of the blocks, in order, on the calling thread
+        template<typename Iter, typename Value>
+        Value parallel_sum_values(Iter begin, Iter end, Value init, std::size_t threads)
+        {
+            std::ptrdiff_t const size = end - begin;
+            std::size_t const blocks = (std::max<std::size_t>)(1, (std::min<std::size_t>)(threads, size));
+
+            std::vector<Value> totals(blocks);
+            std::vector<integrate_block_task<Iter, Value> > tasks;
+            for(std::size_t i = 0; i != blocks; ++i)
+            {
+                std::ptrdiff_t const first = size * static_cast<std::ptrdiff_t>(i) / static_cast<std::ptrdiff_t>(blocks);
+                std::ptrdiff_t const last = size * static_cast<std::ptrdiff_t>(i + 1) / static_cast<std::ptrdiff_t>(blocks);
+                tasks.push_back(integrate_block_task<Iter, Value>(begin + first, begin + last, &totals[i]));
+            }
+            range_run_storage::detail::run_tasks(tasks);
+
+            return detail::sum_values(totals.begin(), totals.end(), init);
+        }
+
+        // Returns false if the series must go through integrate().
+        template<typename Series, typename Value>
+        bool parallel_integrate_values(Series const &, Value &, std::size_t)
+        {
+            return false;
+        }
+
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        bool parallel_integrate_values(sparse_series<Value, Discretization, Offset, Allocator> const &series, Value &value, std::size_t threads)
+        {
+            storage::sparse_array<Value, Offset, Allocator> const &data = time_series_facade_access::data(series);
+            if(!is_arithmetic<Value>::value
+            || !is_integral<Offset>::value
+            || data.pre().first != data.pre().second
+            || data.post().first != data.post().second)
+            {
+                return false;
+            }
+
+            value = detail::parallel_sum_values(data.values_begin(), data.values_end(), value, threads);
+            return true;
+        }
+
+        template<typename Value, typename Discretization, typename Allocator>
+        bool parallel_integrate_values(dense_series<Value, Discretization, Allocator> const &series, Value &value, std::size_t threads)
+        {
+            storage::dense_array<Value, Allocator> const &data = time_series_facade_access::data(series);
+            if(!is_arithmetic<Value>::value
+            || data.pre().second != -inf
+            || data.post().first != inf)
+            {
+                return false;
+            }
+
+            value = detail::parallel_sum_values(data.begin(), data.end(), value, threads);
+            return true;
+        }
+    }
+
+    /// \brief Multi-threaded \c integrate().
+    ///
+    /// Computes the same result as \c integrate(), using up to \c threads threads
+    ///     for a \c dense_series\<\> or \c sparse_series\<\> of arithmetic values
+    ///     without pre- or post-runs. The buffer is split into one block per thread,
+    ///     each block is summed on its own thread, and the totals of the blocks are
+    ///     summed in order on the calling thread. Floating-point values are summed
+    ///     with compensation within and across the blocks, so the result may differ
+    ///     from that of \c integrate() only in the last bits. Other series are
+    ///     integrated by \c integrate() on the calling thread.
+    ///
+    /// \param series The input series.
+    /// \param threads The number of threads to use.
+    ///
+    /// \pre The preconditions of \c integrate().
+    /// \return A \c value_type holding the integral of the series.
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (typename concepts::TimeSeries<Series const>::value_type))
+    parallel_integrate(Series const &series, std::size_t threads)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+
+        value_type value = implicit_cast<value_type const &>(range_run_storage::zero(series));
+        if(detail::parallel_integrate_values(series, value, threads))
+        {
+            return value * series.discretization();
+        }
+
+        return time_series::integrate(series);
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_PARALLEL_INTEGRATE_EAN_10_18_2026
@@ -0,0 +1,368 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file parallel_partial_sum.hpp
+/// Multi-threaded version of \c partial_sum
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_PARALLEL_PARTIAL_SUM_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_PARALLEL_PARTIAL_SUM_EAN_10_18_2026
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <boost/concept/requires.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/range_run_storage/algorithm/parallel.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/partial_sum.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        // The first pass of the block scan: the sum of one block
+        template<typename Value>
+        struct block_sum_task
+        {
+            block_sum_task(Value const *begin, Value const *end, Value *total)
+              : begin_(begin), end_(end), total_(total)
+            {}
+
+            void operator ()() const
+            {
+                Value sum = Value();
+                std::ptrdiff_t const size = this->end_ - this->begin_;
+                for(std::ptrdiff_t i = 0; i < size; ++i)
+                {
+                    sum += this->begin_[i];
+                }
+                *this->total_ = sum;
+            }
+
+        private:
+            Value const *begin_;
+            Value const *end_;
+            Value *total_;
+        };
+
+        // The second pass of the block scan: the partial sums of one block,
+        // starting from the total of the blocks before it
+        template<typename Value>
+        struct block_scan_task
+        {
+            block_scan_task(Value const *begin, Value const *end, Value const &carry, Value *out)
+              : begin_(begin), end_(end), carry_(carry), out_(out)
+            {}
+
+            void operator ()() const
+            {
+                Value sum = this->carry_;
+                std::ptrdiff_t const size = this->end_ - this->begin_;
+                for(std::ptrdiff_t i = 0; i < size; ++i)
+                {
+                    this->out_[i] = (sum += this->begin_[i]);
+                }
+            }
+
+        private:
+            Value const *begin_;
+            Value const *end_;
+            Value carry_;
+            Value *out_;
+        };
+
+        // A dense series of arithmetic values without pre- or post-runs is
+        // scanned straight from its buffer, in two passes over one block per
+        // thread. Returns false if the series must go through partial_sum().
+        template<typename Series, typename Out>
+        bool dense_partial_sum(Series const &, Out &, std::size_t)
+        {
+            return false;
+        }
+
+        template<typename Value, typename Discretization, typename Allocator, typename Out>
+        bool dense_partial_sum(dense_series<Value, Discretization, Allocator> const &series, Out &out, std::size_t threads)
+        {
+            storage::dense_array<Value, Allocator> const &data = time_series_facade_access::data(series);
+            std::ptrdiff_t const offset = data.offset();
+            std::ptrdiff_t const size = data.end_offset() - offset;
+            if(!is_arithmetic<Value>::value
+            || 0 == size
+            || data.pre().second != -inf
+            || data.post().first != inf)
+            {
+                return false;
+            }
+
+            Value const *const buffer = &*data.begin();
+            std::size_t const blocks = (std::max<std::size_t>)(1, (std::min<std::size_t>)(threads, size));
+            std::vector<std::ptrdiff_t> bounds(1, 0);
+            for(std::size_t i = 1; i <= blocks; ++i)
+            {
+                bounds.push_back(size * static_cast<std::ptrdiff_t>(i) / static_cast<std::ptrdiff_t>(blocks));
+            }
+
+            std::vector<Value> totals(blocks);
+            std::vector<block_sum_task<Value> > sum_tasks;
+            for(std::size_t i = 0; i != blocks; ++i)
+            {
+                sum_tasks.push_back(block_sum_task<Value>(buffer + bounds[i], buffer + bounds[i + 1], &totals[i]));
+            }
+            range_run_storage::detail::run_tasks(sum_tasks);
+
+            std::vector<Value> sums(size);
+            std::vector<block_scan_task<Value> > scan_tasks;
+            Value const zero = range_run_storage::zero(series);
+            Value carry = zero;
+            for(std::size_t i = 0; i != blocks; ++i)
+            {
+                scan_tasks.push_back(block_scan_task<Value>(buffer + bounds[i], buffer + bounds[i + 1], carry, &sums[bounds[i]]));
+                carry += totals[i];
+            }
+            range_run_storage::detail::run_tasks(scan_tasks);
+
+            out(zero, -inf, offset);
+            out.set_at_range(offset, sums.begin(), sums.end());
+            out(sums.back(), offset + size, inf);
+            return true;
+        }
+
+        // The first pass of the run scan: the sum of the runs of one block.
+        // A run of zeros adds nothing, whatever its length, so an infinite
+        // run of zeros is never measured.
+        template<typename Run, typename Value>
+        struct run_block_sum_task
+        {
+            run_block_sum_task(Run const *begin, Run const *end, Value *total)
+              : begin_(begin), end_(end), total_(total)
+            {}
+
+            void operator ()() const
+            {
+                Value sum = Value();
+                for(Run const *run = this->begin_; run != this->end_; ++run)
+                {
+                    if(run->value != Value())
+                    {
+                        sum += run->value * static_cast<Value>(run->second - run->first);
+                    }
+                }
+                *this->total_ = sum;
+            }
+
+        private:
+            Run const *begin_;
+            Run const *end_;
+            Value *total_;
+        };
+
+        // The second pass of the run scan: the partial sums over the runs of
+        // one block, and over the gaps before them, starting from the total
+        // of the blocks before it and the end of the run before the block.
+        // They are saved in a buffer, in the runs partial_sum() would write.
+        template<typename Run, typename Value, typename Offset>
+        struct run_block_scan_task
+        {
+            typedef range_run_storage::detail::run_buffer<Offset, Value> buffer_type;
+
+            run_block_scan_task(Run const *begin, Run const *end, Offset end_before, Value const &carry, buffer_type *out)
+              : begin_(begin), end_(end), end_before_(end_before), carry_(carry), out_(out)
+            {}
+
+            void operator ()() const
+            {
+                Value sum = this->carry_;
+                Offset offset = this->end_before_;
+                for(Run const *run = this->begin_; run != this->end_; ++run)
+                {
+                    if(offset != run->first)
+                    {
+                        this->write_(sum, offset, run->first);
+                    }
+
+                    if(run->value == Value())
+                    {
+                        this->write_(sum, run->first, run->second);
+                    }
+                    else
+                    {
+                        for(Offset i = run->first; i != run->second; ++i)
+                        {
+                            this->write_(sum += run->value, i, i + 1);
+                        }
+                    }
+
+                    offset = run->second;
+                }
+            }
+
+        private:
+            void write_(Value value, Offset offset, Offset endoff) const
+            {
+                std::pair<Offset, Offset> run(offset, endoff);
+                this->out_->set_at(run, value);
+            }
+
+            Run const *begin_;
+            Run const *end_;
+            Offset end_before_;
+            Value carry_;
+            buffer_type *out_;
+        };
+
+        // A piecewise constant series of arithmetic values with integral
+        // offsets is scanned straight from its runs, in two passes over one
+        // block of runs per thread. Returns false if the series must go
+        // through partial_sum().
+        template<typename Series, typename Out>
+        bool piecewise_partial_sum(Series const &, Out &, std::size_t)
+        {
+            return false;
+        }
+
+        template<typename Value, typename Discretization, typename Offset, typename Allocator, typename Out>
+        bool piecewise_partial_sum(piecewise_constant_series<Value, Discretization, Offset, Allocator> const &series, Out &out, std::size_t threads)
+        {
+            typedef storage::piecewise_constant_array<Value, Offset, Allocator> array_type;
+            typedef typename array_type::run_value_type run_type;
+            typedef run_block_scan_task<run_type, Value, Offset> scan_task_type;
+
+            array_type const &data = time_series_facade_access::data(series);
+            std::size_t const size = data.data().size();
+            if(!is_arithmetic<Value>::value
+            || !is_integral<Offset>::value
+            || 0 == size)
+            {
+                return false;
+            }
+
+            run_type const *const runs = &data.data()[0];
+            std::size_t const blocks = (std::max<std::size_t>)(1, (std::min<std::size_t>)(threads, size));
+            std::vector<std::size_t> bounds(1, 0);
+            for(std::size_t i = 1; i <= blocks; ++i)
+            {
+                bounds.push_back(size * i / blocks);
+            }
+
+            std::vector<Value> totals(blocks);
+            std::vector<run_block_sum_task<run_type, Value> > sum_tasks;
+            for(std::size_t i = 0; i != blocks; ++i)
+            {
+                sum_tasks.push_back(run_block_sum_task<run_type, Value>(runs + bounds[i], runs + bounds[i + 1], &totals[i]));
+            }
+            range_run_storage::detail::run_tasks(sum_tasks);
+
+            std::vector<typename scan_task_type::buffer_type> buffers(blocks);
+            std::vector<scan_task_type> scan_tasks;
+            Value carry = range_run_storage::zero(series);
+            for(std::size_t i = 0; i != blocks; ++i)
+            {
+                Offset const end_before = 0 == i ? Offset(-inf) : runs[bounds[i] - 1].second;
+                scan_tasks.push_back(scan_task_type(runs + bounds[i], runs + bounds[i + 1], end_before, carry, &buffers[i]));
+                carry += totals[i];
+            }
+            range_run_storage::detail::run_tasks(scan_tasks);
+
+            for(std::size_t i = 0; i != blocks; ++i)
+            {
+                buffers[i].flush(out);
+            }
+
+            Offset const last = runs[size - 1].second;
+            if(inf != last)
+            {
+                out(carry, last, inf);
+            }
+            return true;
+        }
+    }
+
+    /// \brief Multi-threaded \c partial_sum().
+    ///
+    /// Computes the same result as \c partial_sum(), using up to \c threads threads
+    ///     for a \c dense_series\<\> of arithmetic values. The buffer is split into
+    ///     one block per thread; the first pass sums each block, and the second
+    ///     computes the partial sums of each block starting from the total of the
+    ///     blocks before it. The sums are then written to \c out in order on the
+    ///     calling thread.
+    ///
+    /// A \c piecewise_constant_series\<\> of arithmetic values with integral
+    ///     offsets is scanned the same way, with one block of runs per thread.
+    ///     The first pass adds up the value times the length of each run, so a
+    ///     long run costs no more than a short one; the second computes the runs
+    ///     of sums that \c partial_sum() would write for the block, and these are
+    ///     then written to \c out in order on the calling thread.
+    ///
+    /// Other series, and dense series with pre- or post-runs, are summed by
+    ///     \c partial_sum() on the calling thread. For floating-point values, the
+    ///     sums may differ from those of \c partial_sum() by rounding.
+    ///
+    /// \param series The input series.
+    /// \param out The ordered inserter to receive the partial sums.
+    /// \param threads The number of threads to use.
+    ///
+    /// \pre The preconditions of \c partial_sum().
+    /// \return A \c piecewise_constant_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    parallel_partial_sum(Series const &series, ordered_inserter<Out> out, std::size_t threads)
+    {
+        if(detail::dense_partial_sum(series, out, threads)
+        || detail::piecewise_partial_sum(series, out, threads))
+        {
+            return out;
+        }
+
+        return time_series::partial_sum(series, out);
+    }
+
+    /// \overload
+    ///
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (piecewise_constant_series<
+        typename concepts::TimeSeries<Series const>::value_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , std::ptrdiff_t
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
+    >))
+    parallel_partial_sum(Series const &series, std::size_t threads)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
+
+        piecewise_constant_series<value_type, discretization_type, std::ptrdiff_t, allocator_type> result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::parallel_partial_sum(
+            series
+          , time_series::make_ordered_inserter(result)
+          , threads
+        ).commit();
+
+        return result;
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_PARALLEL_PARTIAL_SUM_EAN_10_18_2026
@@ -11,14 +11,20 @@
 
 #include <boost/implicit_cast.hpp>
 #include <boost/concept/requires.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/mpl/assert.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
 #include <boost/range_run_storage/traits/is_unit_run.hpp>
 #include <boost/range_run_storage/algorithm/copy.hpp>
 #include <boost/time_series/time_series_fwd.hpp>
 #include <boost/time_series/concepts.hpp>
 #include <boost/time_series/piecewise_constant_series.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 
 namespace boost { namespace time_series
 {
@@ -27,6 +33,39 @@ namespace boost { namespace time_series
     {
         namespace rrs = range_run_storage;
 
+        // The k-th partial sum within a run of constant value
+        template<typename Value, typename Offset>
+        struct run_progression
+        {
+            typedef Value result_type;
+
+            run_progression(Value const &sum, Value const &value)
+              : sum_(sum)
+              , value_(value)
+            {}
+
+            Value operator ()(Offset k) const
+            {
+                return this->sum_ + this->value_ * k;
+            }
+
+        private:
+            Value sum_;
+            Value value_;
+        };
+
+        // True if Out writes into a dense series, whose inserter takes a block
+        // of consecutive values at once through set_at_range()
+        template<typename Out>
+        struct is_dense_inserter
+          : mpl::false_
+        {};
+
+        template<typename Series>
+        struct is_dense_inserter<ordered_inserter<Series> >
+          : is_same<typename concepts::TimeSeries<Series>::storage_category, dense_storage_tag>
+        {};
+
         // partial_sum_inserter
         template<typename Out, typename Series>
         struct partial_sum_inserter
@@ -66,15 +105,51 @@ namespace boost { namespace time_series
             void partial_sum_run(value_type const &value, Run const &run, mpl::false_)
             {
                 BOOST_MPL_ASSERT((is_integral<offset_type>)); // TODO
-                offset_type offset = rrs::offset(run);
-                offset_type endoff = rrs::end_offset(run);
+                this->partial_sum_run_(value, rrs::offset(run), rrs::end_offset(run), is_arithmetic<value_type>());
+            }
 
+            void partial_sum_run_(value_type const &value, offset_type offset, offset_type endoff, mpl::false_)
+            {
                 for(; offset != endoff; ++offset)
                 {
                     this->out_(this->sum_ += value, offset);
                 }
             }
 
+            // A run of zeros leaves the sum as it is, and is written as a single
+            // run. Otherwise the sums differ at every offset and are written one
+            // value per offset, as a block if the result is dense.
+            void partial_sum_run_(value_type const &value, offset_type offset, offset_type endoff, mpl::true_)
+            {
+                if(value == value_type())
+                {
+                    this->out_(this->sum_, offset, endoff);
+                    return;
+                }
+
+                this->partial_sum_block_(value, offset, endoff, is_dense_inserter<Out>());
+            }
+
+            void partial_sum_block_(value_type const &value, offset_type offset, offset_type endoff, mpl::false_)
+            {
+                this->partial_sum_run_(value, offset, endoff, mpl::false_());
+            }
+
+            // The sums over the run form an arithmetic progression, which the
+            // dense inserter copies into its buffer in one go.
+            void partial_sum_block_(value_type const &value, offset_type offset, offset_type endoff, mpl::true_)
+            {
+                typedef run_progression<value_type, offset_type> progression;
+                typedef transform_iterator<progression, counting_iterator<offset_type> > iterator;
+                progression const fun(this->sum_, value);
+                this->out_.set_at_range(
+                    offset
+                  , iterator(counting_iterator<offset_type>(1), fun)
+                  , iterator(counting_iterator<offset_type>(endoff - offset + 1), fun)
+                );
+                this->sum_ = fun(endoff - offset);
+            }
+
             template<typename Run>
             void partial_sum_run(value_type const &value, Run const &run, mpl::true_)
             {
@@ -99,6 +174,10 @@ namespace boost { namespace time_series
     /// sums, and that the series does not have non-zero positive or negative infinite
     /// runs.
     ///
+    /// The sums over a run of zeros are written as a single run. The sums over any
+    /// other run differ at every offset, so a piecewise constant result holds one
+    /// run per offset; a dense result receives them as one block.
+    ///
     /// \param series The input series.
     /// \param out The ordered inserter to receive the adjacent difference result.
     ///
@@ -133,15 +212,22 @@ namespace boost { namespace time_series
     (piecewise_constant_series<
         typename concepts::TimeSeries<Series const>::value_type
       , typename concepts::TimeSeries<Series const>::discretization_type
+      , std::ptrdiff_t
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >))
     partial_sum(Series const &series)
     {
         typedef typename concepts::TimeSeries<Series const>::value_type value_type;
         typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
 
         // The partial differences are held in a piecewise constant array.
-        piecewise_constant_series<value_type, discretization_type> result(
+        piecewise_constant_series<value_type, discretization_type, std::ptrdiff_t, allocator_type> result(
             time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
         );
 
         time_series::partial_sum(
@@ -0,0 +1,393 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file period_stats.hpp
+/// Calculate the count, sum, mean, minimum, maximum, first and last values
+/// within fixed-width ranges in a series, in a single pass
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_PERIOD_STATS_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_PERIOD_STATS_EAN_10_18_2026
+
+#include <cstddef>
+#include <ostream>
+#include <algorithm>
+#include <boost/implicit_cast.hpp>
+#include <boost/concept/requires.hpp>
+#include <boost/assert.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/range_run_storage/traits/is_unit_run.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/find_period.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
+
+namespace boost { namespace time_series
+{
+
+    /// \brief The statistics of the values within one period.
+    ///
+    /// A run of length \c n counts as \c n samples of its value. The \c first,
+    ///     \c last, \c min and \c max members are the open, close, low and high
+    ///     of the period. A default-constructed \c period_summary\<\> has a
+    ///     \c count of 0 and is the zero of a series of them.
+    template<typename Value>
+    struct period_summary
+    {
+        typedef Value value_type;
+
+        period_summary()
+          : count(0)
+          , sum()
+          , min()
+          , max()
+          , first()
+          , last()
+        {}
+
+        /// Adds \c n samples of \c value
+        ///
+        void add(Value const &value, std::ptrdiff_t n)
+        {
+            if(0 == this->count)
+            {
+                this->sum = value * n;
+                this->min = this->max = this->first = value;
+            }
+            else
+            {
+                this->sum += value * n;
+                numeric::min_assign(this->min, value);
+                numeric::max_assign(this->max, value);
+            }
+            this->count += n;
+            this->last = value;
+        }
+
+        /// Adds one sample of each value in <tt>[begin, end)</tt>
+        ///
+        /// \pre <tt>begin != end</tt>
+        void add(Value const *begin, Value const *end)
+        {
+            BOOST_ASSERT(begin != end);
+            if(0 == this->count)
+            {
+                this->sum = this->min = this->max = this->first = *begin++;
+                this->count = 1;
+            }
+
+            // Accumulated in four independent lanes, as in compensated_sum(),
+            // so that each step does not wait on the last and the lanes of a
+            // block can be computed together.
+            Value sum[4] = {this->sum, Value(), Value(), Value()};
+            Value lo[4] = {this->min, this->min, this->min, this->min};
+            Value hi[4] = {this->max, this->max, this->max, this->max};
+
+            std::ptrdiff_t const size = end - begin;
+            std::ptrdiff_t i = 0;
+            for(; i + 4 <= size; i += 4)
+            {
+                for(int lane = 0; lane < 4; ++lane)
+                {
+                    Value const value = begin[i + lane];
+                    sum[lane] += value;
+                    lo[lane] = value < lo[lane] ? value : lo[lane];
+                    hi[lane] = hi[lane] < value ? value : hi[lane];
+                }
+            }
+            for(; i < size; ++i)
+            {
+                sum[0] += begin[i];
+                lo[0] = begin[i] < lo[0] ? begin[i] : lo[0];
+                hi[0] = hi[0] < begin[i] ? begin[i] : hi[0];
+            }
+
+            for(int lane = 1; lane < 4; ++lane)
+            {
+                sum[0] += sum[lane];
+                lo[0] = lo[lane] < lo[0] ? lo[lane] : lo[0];
+                hi[0] = hi[0] < hi[lane] ? hi[lane] : hi[0];
+            }
+
+            this->sum = sum[0];
+            this->min = lo[0];
+            this->max = hi[0];
+            this->count += size;
+            this->last = end[-1];
+        }
+
+        /// \return <tt>sum / count</tt>, promoted to \c double for integral values.
+        ///
+        typename numeric::functional::average<Value, std::size_t>::result_type mean() const
+        {
+            return numeric::average(this->sum, this->count);
+        }
+
+        std::size_t count;  ///< The number of samples
+        Value sum;          ///< The sum of the samples
+        Value min;          ///< The least sample
+        Value max;          ///< The greatest sample
+        Value first;        ///< The earliest sample
+        Value last;         ///< The latest sample
+    };
+
+    /// INTERNAL ONLY
+    template<typename Value>
+    bool operator ==(period_summary<Value> const &left, period_summary<Value> const &right)
+    {
+        return left.count == right.count
+            && (0 == left.count
+             || (numeric::promote<bool>(left.sum == right.sum)
+              && numeric::promote<bool>(left.min == right.min)
+              && numeric::promote<bool>(left.max == right.max)
+              && numeric::promote<bool>(left.first == right.first)
+              && numeric::promote<bool>(left.last == right.last)));
+    }
+
+    /// INTERNAL ONLY
+    template<typename Value>
+    bool operator !=(period_summary<Value> const &left, period_summary<Value> const &right)
+    {
+        return !(left == right);
+    }
+
+    /// INTERNAL ONLY
+    template<typename Char, typename Traits, typename Value>
+    std::basic_ostream<Char, Traits> &
+    operator <<(std::basic_ostream<Char, Traits> &sout, period_summary<Value> const &s)
+    {
+        return sout << '{' << s.count << ',' << s.sum << ',' << s.min << ','
+                    << s.max << ',' << s.first << ',' << s.last << '}';
+    }
+
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+
+        // period_stats_inserter
+        //   Like period_sums_inserter, but accumulates a period_summary.
+        template<typename Out, typename Series, typename Offset, typename Length>
+        struct period_stats_inserter
+        {
+            typedef typename concepts::TimeSeries<Series>::value_type value_type;
+            typedef period_summary<value_type> summary_type;
+
+            typedef Offset offset_type;
+            typedef Length length_type;
+            typedef std::pair<offset_type, offset_type> period_type;
+
+            period_stats_inserter(Out const &out, offset_type start, length_type length)
+              : out_(out)
+              , summary_()
+              , period_(start, static_cast<offset_type>(start + length))
+              , start_(start)
+              , length_(length)
+            {}
+
+            template<typename Run>
+            void set_at(Run const &run, value_type const &value)
+            {
+                if(this->start_ < rrs::end_offset(run))
+                {
+                    if(rrs::less(this->period_, run))
+                    {
+                        this->flush_();
+                        this->period_ = detail::find_period(run, this->start_, this->length_);
+                    }
+                    this->set_at_(run, value, rrs::traits::is_unit_run<Run>());
+                }
+            }
+
+            Out const &finalize()
+            {
+                this->flush_();
+                return this->out_;
+            }
+
+        private:
+            void flush_()
+            {
+                if(0 != this->summary_.count)
+                {
+                    this->out_(this->summary_, this->period_.first);
+                    this->summary_ = summary_type();
+                }
+            }
+
+            template<typename Run>
+            void set_at_(Run const &, value_type const &value, mpl::true_)
+            {
+                this->summary_.add(value, 1);
+            }
+
+            template<typename Run>
+            void set_at_(Run const &run, value_type const &value, mpl::false_)
+            {
+                typedef typename result_of<rrs::op::subrun(Run)>::type subrun_type;
+                typedef typename result_of<rrs::op::overlap(subrun_type, period_type)>::type overlap_type;
+                subrun_type subrun(rrs::subrun(run));
+
+                for(;;)
+                {
+                    overlap_type overlap(rrs::overlap(subrun, this->period_));
+                    this->summary_.add(value, static_cast<std::ptrdiff_t>(rrs::length(overlap)));
+                    rrs::advance_to(subrun, rrs::end_offset(overlap));
+
+                    if(!rrs::has_leftover(subrun))
+                        break;
+
+                    this->flush_();
+                    this->period_.first = this->period_.second;
+                    this->period_.second += this->length_;
+                }
+            }
+
+            Out out_;
+            summary_type summary_;
+            period_type period_;
+            offset_type start_;
+            length_type length_;
+        };
+
+        // A dense series of arithmetic values without pre- or post-runs is
+        // summarized straight from its buffer, one contiguous slice per period.
+        // Returns false if the series must go through period_stats_inserter.
+        template<typename Series, typename Offset, typename Length, typename Out>
+        bool dense_period_stats(Series const &, Offset, Length, Out &)
+        {
+            return false;
+        }
+
+        template<typename Value, typename Discretization, typename Allocator, typename Offset, typename Length, typename Out>
+        bool dense_period_stats(dense_series<Value, Discretization, Allocator> const &series, Offset start, Length length, Out &out)
+        {
+            storage::dense_array<Value, Allocator> const &data = time_series_facade_access::data(series);
+            if(!is_arithmetic<Value>::value
+            || data.pre().second != -inf
+            || data.post().first != inf)
+            {
+                return false;
+            }
+
+            std::ptrdiff_t const lo = (std::max<std::ptrdiff_t>)(data.offset(), start);
+            std::ptrdiff_t const hi = data.end_offset();
+            if(lo >= hi)
+            {
+                return true;
+            }
+
+            Value const *const buffer = &*data.begin();
+            std::ptrdiff_t const offset = data.offset();
+            std::ptrdiff_t period = lo - (lo - start) % length;
+            for(; period < hi; period += length)
+            {
+                period_summary<Value> summary;
+                summary.add(
+                    buffer + ((std::max)(period, lo) - offset)
+                  , buffer + ((std::min<std::ptrdiff_t>)(period + length, hi) - offset)
+                );
+                out(summary, static_cast<Offset>(period));
+            }
+
+            return true;
+        }
+    }
+
+    /// \brief Calculate the count, sum, minimum, maximum, first and last value
+    ///     within fixed-width ranges in a series in a single pass, and store
+    ///     the results at the start of each range.
+    ///
+    /// Calculate a \c period_summary\<\> for each fixed-width range in a series
+    ///     and store it at the start of the range. Each summary holds everything
+    ///     needed for the sum, mean, count, and open/high/low/close of the range,
+    ///     so one scan serves all of them. Ranges without any runs are skipped.
+    ///
+    /// The runs of the series are what is summarized; offsets that the series
+    ///     leaves at its zero value do not count as samples. As with
+    ///     \c period_sums(), the series must not have a non-zero positive
+    ///     infinite run, and \c start must not be \c -inf. A dense series of
+    ///     arithmetic values is summarized directly from its buffer.
+    ///
+    /// \param series The input series.
+    /// \param start The offset of the first period. Must be integral.
+    /// \param length The length of the periods. Must be integral.
+    /// \param out The ordered inserter to receive the summaries.
+    ///
+    /// \pre \c Series is a model of the \c TimeSeries concept, with integral offsets.
+    /// \pre \c Out is a model of the \c OrderedInserter concept whose value type
+    ///     is <tt>period_summary\<value_type\></tt>.
+    /// \pre \c Offset is integral.
+    /// \pre \c Length is integral.
+    /// \pre <tt>start != -inf</tt>
+    /// \pre <tt>series[inf] == range_run_storage::zero(series)</tt>
+    /// \return A \c sparse_series\<\> of \c period_summary\<\> if no ordered
+    ///     inserter is specified; otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Offset, typename Length, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    period_stats(Series const &series, Offset start, Length length, ordered_inserter<Out> out)
+    {
+        BOOST_MPL_ASSERT((is_integral<Offset>));
+        BOOST_MPL_ASSERT((is_integral<Length>));
+        BOOST_MPL_ASSERT((is_integral<typename concepts::TimeSeries<Series const>::offset_type>));
+
+        if(detail::dense_period_stats(series, start, length, out))
+        {
+            return out;
+        }
+
+        detail::period_stats_inserter<ordered_inserter<Out>, Series const, Offset, Length>
+            o(out, start, length);
+
+        return range_run_storage::copy(series, o).finalize();
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Offset, typename Length>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (sparse_series<
+        period_summary<typename concepts::TimeSeries<Series const>::value_type>
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , Offset
+      , typename detail::series_result_allocator<
+            period_summary<typename concepts::TimeSeries<Series const>::value_type>
+          , Series
+        >::type
+    >))
+    period_stats(Series const &series, Offset start, Length length)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<period_summary<value_type>, Series>::type allocator_type;
+
+        sparse_series<period_summary<value_type>, discretization_type, Offset, allocator_type> result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::period_stats(
+            series
+          , start
+          , length
+          , time_series::make_ordered_inserter(result)
+        ).commit();
+
+        return result;
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_PERIOD_STATS_EAN_10_18_2026
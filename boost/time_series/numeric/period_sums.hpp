@@ -20,6 +20,7 @@
 #include <boost/time_series/sparse_series.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
 #include <boost/time_series/numeric/detail/find_period.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 
 namespace boost { namespace time_series
 {
@@ -165,16 +166,22 @@ namespace boost { namespace time_series
         typename concepts::TimeSeries<Series const>::value_type
       , typename concepts::TimeSeries<Series const>::discretization_type
       , Offset
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >))
     period_sums(Series const &series, Offset start, Length length)
     {
         typedef typename concepts::TimeSeries<Series const>::value_type value_type;
         typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
 
         // The periodic sums are held in a sparse array. The sums are
         // stored at the start of their associated periods.
-        sparse_series<value_type, discretization_type, Offset> result(
+        sparse_series<value_type, discretization_type, Offset, allocator_type> result(
             time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
         );
 
         time_series::period_sums(
@@ -20,6 +20,7 @@
 #include <boost/time_series/piecewise_constant_series.hpp>
 #include <boost/time_series/numeric/detail/tagged_ops.hpp>
 #include <boost/time_series/numeric/piecewise_sample.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 
 namespace boost { namespace time_series
 {
@@ -152,16 +153,22 @@ namespace boost { namespace time_series
         typename concepts::TimeSeries<Series const>::value_type
       , typename concepts::TimeSeries<Series const>::discretization_type
       , typename concepts::RandomAccessRange<XPeriods /*const*/>::value_type
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >))
     piecewise_surface_sample(Series const &series, XPeriods const &x_periods, YPeriods const &y_periods)
     {
         typedef typename concepts::TimeSeries<Series const>::value_type value_type;
         typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
         typedef typename concepts::RandomAccessRange<XPeriods /*const*/>::value_type offset_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
 
-        piecewise_constant_series<value_type, discretization_type, offset_type> result(
+        piecewise_constant_series<value_type, discretization_type, offset_type, allocator_type> result(
             time_series::discretization = series.discretization()
           , time_series::zero = range_run_storage::zero(series)
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
         );
 
         time_series::piecewise_surface_sample(
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file quantile.hpp
+/// Exact quantiles of the values of a series, weighted by the lengths of
+/// their runs
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_QUANTILE_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_QUANTILE_EAN_10_18_2026
+
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/concept/requires.hpp>
+#include <boost/range_run_storage/offset.hpp>
+#include <boost/range_run_storage/end_offset.hpp>
+#include <boost/range_run_storage/length.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+
+        // weighted_value_inserter
+        //   Collects the value of each run with the length of the run as its
+        //   weight, so a run of length L is stored once rather than L times.
+        template<typename Value>
+        struct weighted_value_inserter
+        {
+            typedef std::vector<std::pair<Value, double> > buffer_type;
+
+            explicit weighted_value_inserter(buffer_type &buffer)
+              : buffer_(buffer)
+            {}
+
+            template<typename Run>
+            void set_at(Run const &run, Value const &value)
+            {
+                BOOST_ASSERT(-inf != rrs::offset(run) && inf != rrs::end_offset(run));
+                double const weight = static_cast<double>(rrs::length(run));
+                if(0 < weight)
+                {
+                    this->buffer_.push_back(std::make_pair(value, weight));
+                }
+            }
+
+        private:
+            buffer_type &buffer_;
+        };
+
+        struct less_value
+        {
+            template<typename Pair>
+            bool operator ()(Pair const &left, Pair const &right) const
+            {
+                return left.first < right.first;
+            }
+        };
+
+        // The smallest value whose cumulative weight reaches target, found by
+        // narrowing the buffer with nth_element around its middle element.
+        // Expected linear time; the buffer is reordered.
+        template<typename Iter>
+        typename std::iterator_traits<Iter>::value_type::first_type
+        weighted_select(Iter begin, Iter end, double target)
+        {
+            while(1 < end - begin)
+            {
+                Iter middle = begin + (end - begin) / 2;
+                std::nth_element(begin, middle, end, less_value());
+
+                double left = 0;
+                for(Iter i = begin; i != middle; ++i)
+                {
+                    left += i->second;
+                }
+
+                if(target <= left)
+                {
+                    end = middle;
+                }
+                else if(target <= left + middle->second)
+                {
+                    return middle->first;
+                }
+                else if(middle + 1 == end)
+                {
+                    // target was rounded past the total weight
+                    return middle->first;
+                }
+                else
+                {
+                    target -= left + middle->second;
+                    begin = middle + 1;
+                }
+            }
+
+            return begin->first;
+        }
+    }
+
+    /// \brief The quantile of the values of a series, with each value weighted
+    ///     by the length of its run.
+    ///
+    /// Returns the smallest value \em v such that the runs with values no
+    ///     greater than \em v cover at least the fraction \c q of the total
+    ///     length of the runs. A run of length \em L counts as \em L samples
+    ///     of its value, but is stored only once: the values of the runs are
+    ///     collected into a buffer of (value, length) pairs, which is then
+    ///     narrowed with \c std::nth_element, in expected linear time in the
+    ///     number of runs.
+    ///
+    /// \param series The input series.
+    /// \param q The fraction, between 0 and 1.
+    /// \pre \c Series is a model of the \c TimeSeries concept, with no infinite
+    ///     runs and at least one run of non-zero length.
+    /// \pre <tt>0 <= q && q <= 1</tt>
+    /// \return The weighted quantile of the values of the runs.
+    /// \attention As with \c integrate(), the zeros between the runs of the
+    ///     series do not participate.
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (typename concepts::TimeSeries<Series const>::value_type))
+    quantile(Series const &series, double q)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        BOOST_ASSERT(0 <= q && q <= 1);
+
+        typename detail::weighted_value_inserter<value_type>::buffer_type buffer;
+        detail::weighted_value_inserter<value_type> o(buffer);
+        range_run_storage::copy(series, o);
+        BOOST_ASSERT(!buffer.empty());
+
+        double total = 0;
+        for(std::size_t i = 0; i != buffer.size(); ++i)
+        {
+            total += buffer[i].second;
+        }
+
+        return detail::weighted_select(buffer.begin(), buffer.end(), q * total);
+    }
+
+    /// \brief The median of the values of a series, with each value weighted
+    ///     by the length of its run.
+    ///
+    /// \param series The input series.
+    /// \pre The preconditions of \c quantile().
+    /// \return <tt>quantile(series, 0.5)</tt>
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (typename concepts::TimeSeries<Series const>::value_type))
+    median(Series const &series)
+    {
+        return time_series::quantile(series, 0.5);
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_QUANTILE_EAN_10_18_2026
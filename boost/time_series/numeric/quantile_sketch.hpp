@@ -0,0 +1,363 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file quantile_sketch.hpp
+/// A streaming sketch of the distribution of the values of a series, for
+/// approximate quantiles in bounded memory
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_QUANTILE_SKETCH_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_QUANTILE_SKETCH_EAN_10_18_2026
+
+#include <cmath>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/concept/requires.hpp>
+#include <boost/range_run_storage/offset.hpp>
+#include <boost/range_run_storage/end_offset.hpp>
+#include <boost/range_run_storage/length.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+
+namespace boost { namespace time_series
+{
+
+    /// \brief A t-digest of weighted values, for approximate quantiles in
+    ///     bounded memory.
+    ///
+    /// The sketch summarizes the values it has seen as at most about
+    ///     \c compression centroids, each the mean and the total weight of a
+    ///     group of neighbouring values. The groups are small near the
+    ///     extremes of the distribution and large near the median, so the
+    ///     error of a quantile is smallest in the tails, where percentiles
+    ///     such as the 99th are taken.
+    ///
+    /// New values are buffered, and merged into the centroids in one sorted
+    ///     pass when the buffer fills, so adding a value costs amortized
+    ///     logarithmic time. Two sketches can be merged, so a long history may
+    ///     be sketched in pieces. The const members never write to the sketch:
+    ///     a query while values are buffered merges them into a temporary
+    ///     copy of the centroids, so concurrent queries are safe.
+    ///
+    /// A sketch is also a sink for \c range_run_storage::copy(): it adds the
+    ///     value of each run with the length of the run as its weight, so a
+    ///     run of length \em L counts as \em L samples at the cost of one.
+    template<typename Value = double>
+    struct quantile_sketch
+    {
+        typedef Value value_type;
+
+        /// \param compression Bounds the number of centroids; higher is
+        ///     more accurate and uses more memory.
+        /// \pre <tt>0 < compression</tt>
+        explicit quantile_sketch(double compression = 100)
+          : compression_(compression)
+          , centroids_()
+          , buffer_()
+          , weight_(0)
+          , min_(0)
+          , max_(0)
+        {
+            BOOST_ASSERT(0 < compression);
+            this->buffer_.reserve(this->buffer_size_());
+        }
+
+        /// Adds \c value with weight \c weight
+        ///
+        /// \pre <tt>0 <= weight</tt>
+        void add(Value const &value, double weight = 1)
+        {
+            BOOST_ASSERT(0 <= weight);
+            if(0 == weight)
+            {
+                return;
+            }
+
+            if(0 == this->weight_ || value < this->min_)
+            {
+                this->min_ = value;
+            }
+            if(0 == this->weight_ || this->max_ < value)
+            {
+                this->max_ = value;
+            }
+
+            this->weight_ += weight;
+            this->buffer_.push_back(centroid(value, weight));
+            if(this->buffer_.size() >= this->buffer_size_())
+            {
+                this->compress_();
+            }
+        }
+
+        /// Adds the value of \c run, with the length of \c run as its weight
+        ///
+        /// \pre \c run is finite.
+        template<typename Run>
+        void set_at(Run const &run, Value const &value)
+        {
+            BOOST_ASSERT(-inf != range_run_storage::offset(run) && inf != range_run_storage::end_offset(run));
+            this->add(value, static_cast<double>(range_run_storage::length(run)));
+        }
+
+        /// Adds the values seen by \c that
+        ///
+        void merge(quantile_sketch const &that)
+        {
+            if(0 == that.weight_)
+            {
+                return;
+            }
+
+            if(&that == this)
+            {
+                // The buffer would be inserted into itself
+                quantile_sketch const copy(that);
+                this->merge(copy);
+                return;
+            }
+
+            if(0 == this->weight_ || that.min_ < this->min_)
+            {
+                this->min_ = that.min_;
+            }
+            if(0 == this->weight_ || this->max_ < that.max_)
+            {
+                this->max_ = that.max_;
+            }
+
+            this->weight_ += that.weight_;
+            this->buffer_.insert(this->buffer_.end(), that.centroids_.begin(), that.centroids_.end());
+            this->buffer_.insert(this->buffer_.end(), that.buffer_.begin(), that.buffer_.end());
+            this->compress_();
+        }
+
+        /// \return The approximate smallest value \em v such that the values
+        ///     no greater than \em v have at least the fraction \c q of the
+        ///     total weight. Between the centroids, the quantile is
+        ///     interpolated linearly.
+        /// \pre <tt>!this->empty()</tt>
+        /// \pre <tt>0 <= q && q <= 1</tt>
+        Value quantile(double q) const
+        {
+            BOOST_ASSERT(!this->empty());
+            BOOST_ASSERT(0 <= q && q <= 1);
+            std::vector<centroid> merged;
+            std::vector<centroid> const &centroids = this->merged_centroids_(merged);
+
+            // The inverse of the distribution is drawn through knots at the
+            // middle of the weight of each centroid, and at the least and
+            // greatest values seen. A centroid of a single value, such as
+            // that of one long run, holds its value across all of its weight.
+            double const target = q * this->weight_;
+            knot previous(0, this->min_);
+            Value result = this->max_;
+            double below = 0;
+            for(std::size_t i = 0; i != centroids.size(); ++i)
+            {
+                centroid const &c = centroids[i];
+                if(c.single)
+                {
+                    if(this->step_(target, previous, knot(below, c.mean), result)
+                    || this->step_(target, previous, knot(below + c.weight, c.mean), result))
+                    {
+                        return result;
+                    }
+                }
+                else if(this->step_(target, previous, knot(below + c.weight / 2, c.mean), result))
+                {
+                    return result;
+                }
+                below += c.weight;
+            }
+
+            this->step_(target, previous, knot(this->weight_, this->max_), result);
+            return result;
+        }
+
+        /// \return <tt>this->quantile(0.5)</tt>
+        ///
+        Value median() const
+        {
+            return this->quantile(0.5);
+        }
+
+        /// \return The total weight of the values added
+        ///
+        double weight() const
+        {
+            return this->weight_;
+        }
+
+        /// \return The number of centroids, after merging in the buffered values
+        ///
+        std::size_t size() const
+        {
+            std::vector<centroid> merged;
+            return this->merged_centroids_(merged).size();
+        }
+
+        /// \return <tt>0 == this->weight()</tt>
+        ///
+        bool empty() const
+        {
+            return 0 == this->weight_;
+        }
+
+    private:
+        struct centroid
+        {
+            centroid(Value const &mean_, double weight_)
+              : mean(mean_)
+              , weight(weight_)
+              , single(true)
+            {}
+
+            Value mean;
+            double weight;
+            bool single;    // all the values in the centroid are equal
+        };
+
+        struct less_mean
+        {
+            bool operator ()(centroid const &left, centroid const &right) const
+            {
+                return left.mean < right.mean;
+            }
+        };
+
+        // A point of the inverse of the distribution: (weight, value)
+        typedef std::pair<double, Value> knot;
+
+        // If target lies between previous and next, interpolates the value
+        // at target into result; otherwise moves previous to next.
+        static bool step_(double target, knot &previous, knot const &next, Value &result)
+        {
+            if(next.first < target)
+            {
+                previous = next;
+                return false;
+            }
+
+            double const width = next.first - previous.first;
+            result = width <= 0 || !(previous.first < target)
+              ? (width <= 0 ? next.second : previous.second)
+              : static_cast<Value>(previous.second + (next.second - previous.second) * ((target - previous.first) / width));
+            return true;
+        }
+
+        std::size_t buffer_size_() const
+        {
+            return static_cast<std::size_t>(5 * this->compression_) + 10;
+        }
+
+        // The scale function that sets the size of the groups: its value
+        // grows by at most 1 across each centroid.
+        double scale_(double q) const
+        {
+            double const pi = 3.14159265358979323846;
+            return this->compression_ / (2 * pi) * std::asin(2 * q - 1);
+        }
+
+        double inverse_scale_(double k) const
+        {
+            double const pi = 3.14159265358979323846;
+            double const x = k * 2 * pi / this->compression_;
+            return x >= pi / 2 ? 1 : (std::sin(x) + 1) / 2;
+        }
+
+        // Merges the buffer and the centroids into the centroids, and
+        // empties the buffer.
+        void compress_()
+        {
+            if(this->buffer_.empty())
+            {
+                return;
+            }
+
+            std::vector<centroid> out;
+            this->buffer_.insert(this->buffer_.end(), this->centroids_.begin(), this->centroids_.end());
+            this->merge_centroids_(this->buffer_, out);
+            this->centroids_.swap(out);
+            this->buffer_.clear();
+        }
+
+        // The centroids with the buffer merged in: the centroids themselves
+        // if the buffer is empty, or else a merged copy, built in merged.
+        std::vector<centroid> const &merged_centroids_(std::vector<centroid> &merged) const
+        {
+            if(this->buffer_.empty())
+            {
+                return this->centroids_;
+            }
+
+            std::vector<centroid> in(this->buffer_);
+            in.insert(in.end(), this->centroids_.begin(), this->centroids_.end());
+            this->merge_centroids_(in, merged);
+            return merged;
+        }
+
+        // Sorts in, and merges it, in order of the means, into as few
+        // centroids as the scale function allows, in out.
+        void merge_centroids_(std::vector<centroid> &in, std::vector<centroid> &out) const
+        {
+            std::sort(in.begin(), in.end(), less_mean());
+
+            out.reserve(static_cast<std::size_t>(this->compression_) + 1);
+            centroid current = in[0];
+            double done = 0;
+            double limit = this->weight_ * this->inverse_scale_(this->scale_(0) + 1);
+            for(std::size_t i = 1; i != in.size(); ++i)
+            {
+                if(done + current.weight + in[i].weight <= limit)
+                {
+                    current.single = current.single && in[i].single && !(current.mean < in[i].mean);
+                    current.weight += in[i].weight;
+                    current.mean = static_cast<Value>(current.mean + (in[i].mean - current.mean) * (in[i].weight / current.weight));
+                }
+                else
+                {
+                    out.push_back(current);
+                    done += current.weight;
+                    limit = this->weight_ * this->inverse_scale_(this->scale_(done / this->weight_) + 1);
+                    current = in[i];
+                }
+            }
+            out.push_back(current);
+        }
+
+        double compression_;
+        std::vector<centroid> centroids_;
+        std::vector<centroid> buffer_;
+        double weight_;
+        Value min_;
+        Value max_;
+    };
+
+    /// \brief Sketch the distribution of the values of a series, with each
+    ///     value weighted by the length of its run.
+    ///
+    /// \param series The input series.
+    /// \param compression The compression of the sketch.
+    /// \pre \c Series is a model of the \c TimeSeries concept, with no infinite runs.
+    /// \return A \c quantile_sketch\<\> of the values of the runs of \c series.
+    /// \attention As with \c integrate(), the zeros between the runs of the
+    ///     series do not participate.
+    template<typename Series>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (quantile_sketch<typename concepts::TimeSeries<Series const>::value_type>))
+    make_quantile_sketch(Series const &series, double compression = 100)
+    {
+        quantile_sketch<typename concepts::TimeSeries<Series const>::value_type> sketch(compression);
+        range_run_storage::copy(series, sketch);
+        return sketch;
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_QUANTILE_SKETCH_EAN_10_18_2026
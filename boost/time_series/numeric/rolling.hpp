@@ -0,0 +1,681 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file rolling.hpp
+/// Calculate the sum, mean, minimum, maximum and variance over a window
+/// that slides across a series
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_NUMERIC_ROLLING_EAN_10_18_2026
+#define BOOST_TIME_SERIES_NUMERIC_ROLLING_EAN_10_18_2026
+
+#include <deque>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <boost/implicit_cast.hpp>
+#include <boost/concept/requires.hpp>
+#include <boost/assert.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+#include <boost/time_series/concepts.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
+
+namespace boost { namespace time_series
+{
+
+    namespace detail
+    {
+        namespace rrs = range_run_storage;
+
+        // rolling_inserter
+        //   Slides a window of the given width across the runs of a series,
+        //   with the gaps between them, and the window's width before the first
+        //   and after the last, filled with zeros. The offsets are cut into
+        //   segments within which the value entering the window and the value
+        //   leaving it are both constant, and the Stat is handed one segment
+        //   at a time, so that a long run costs a few segments rather than a
+        //   step per offset.
+        template<typename Out, typename Stat, typename Value, typename Offset>
+        struct rolling_inserter
+        {
+            typedef Value value_type;
+            typedef Offset offset_type;
+
+            rolling_inserter(Out const &out, Stat const &stat, value_type const &zero, offset_type window)
+              : out_(out)
+              , stat_(stat)
+              , zero_(zero)
+              , window_(window)
+              , offset_(-inf)
+              , pieces_()
+            {
+                BOOST_ASSERT(0 < window);
+            }
+
+            template<typename Run>
+            void set_at(Run const &run, value_type const &value)
+            {
+                offset_type start = rrs::offset(run);
+                offset_type stop = rrs::end_offset(run);
+
+                if(-inf == this->offset_)
+                {
+                    this->pieces_.push_back(piece(this->zero_, start - this->window_, start));
+                    this->stat_.init(this->zero_, start);
+                }
+                else if(this->offset_ != start)
+                {
+                    this->enter_(this->zero_, this->offset_, start);
+                }
+
+                this->enter_(value, start, stop);
+                this->offset_ = stop;
+            }
+
+            Out const &finalize()
+            {
+                // After this, the window holds nothing but zeros.
+                if(-inf != this->offset_)
+                {
+                    this->enter_(this->zero_, this->offset_, this->offset_ + this->window_ - 1);
+                }
+                return this->out_;
+            }
+
+        private:
+            struct piece
+            {
+                piece(value_type const &value, offset_type start, offset_type stop)
+                  : value(value), start(start), stop(stop)
+                {}
+
+                value_type value;
+                offset_type start;
+                offset_type stop;
+            };
+
+            void enter_(value_type const &value, offset_type start, offset_type stop)
+            {
+                this->pieces_.push_back(piece(value, start, stop));
+                while(start != stop)
+                {
+                    // The piece holding the offset that leaves the window at start
+                    offset_type const leaving = start - this->window_;
+                    while(this->pieces_.front().stop <= leaving)
+                    {
+                        this->pieces_.pop_front();
+                    }
+
+                    piece const &left = this->pieces_.front();
+                    offset_type const next = (std::min)(stop, static_cast<offset_type>(left.stop + this->window_));
+                    this->stat_.segment(value, left.value, start, next, this->out_);
+                    start = next;
+                }
+            }
+
+            Out out_;
+            Stat stat_;
+            value_type zero_;
+            offset_type window_;
+            offset_type offset_;
+            std::deque<piece> pieces_;
+        };
+
+        template<typename Value>
+        struct rolling_identity
+        {
+            typedef Value result_type;
+
+            Value const &operator ()(Value const &sum) const
+            {
+                return sum;
+            }
+        };
+
+        template<typename Value>
+        struct rolling_average
+        {
+            typedef typename numeric::functional::average<Value, std::size_t>::result_type result_type;
+
+            explicit rolling_average(std::size_t window)
+              : window_(window)
+            {}
+
+            result_type operator ()(Value const &sum) const
+            {
+                return numeric::average(sum, this->window_);
+            }
+
+        private:
+            std::size_t window_;
+        };
+
+        // The sums through a segment form an arithmetic progression
+        template<typename Value, typename Offset, typename Finish>
+        struct rolling_progression
+        {
+            typedef typename Finish::result_type result_type;
+
+            rolling_progression(Value const &sum, Value const &step, Finish const &finish)
+              : sum_(sum), step_(step), finish_(finish)
+            {}
+
+            result_type operator ()(Offset k) const
+            {
+                return this->finish_(this->sum_ + this->step_ * k);
+            }
+
+        private:
+            Value sum_;
+            Value step_;
+            Finish finish_;
+        };
+
+        // The window sum, passed through Finish
+        template<typename Value, typename Offset, typename Finish>
+        struct rolling_sum_stat
+        {
+            rolling_sum_stat(Value const &zero, Finish const &finish)
+              : sum_(zero), finish_(finish)
+            {}
+
+            void init(Value const &, Offset)
+            {}
+
+            template<typename Out>
+            void segment(Value const &in, Value const &out, Offset start, Offset stop, Out &o)
+            {
+                if(in == out)
+                {
+                    o(this->finish_(this->sum_), start, stop);
+                }
+                else
+                {
+                    this->segment_(in - out, start, stop, o, is_arithmetic<Value>());
+                }
+            }
+
+        private:
+            template<typename Out>
+            void segment_(Value const &step, Offset start, Offset stop, Out &o, mpl::false_)
+            {
+                for(; start != stop; ++start)
+                {
+                    this->sum_ = this->sum_ + step;
+                    o(this->finish_(this->sum_), start);
+                }
+            }
+
+            template<typename Out>
+            void segment_(Value const &step, Offset start, Offset stop, Out &o, mpl::true_)
+            {
+                typedef rolling_progression<Value, Offset, Finish> progression;
+                typedef transform_iterator<progression, counting_iterator<Offset> > iterator;
+                progression const fun(this->sum_, step, this->finish_);
+                o.set_at_range(
+                    start
+                  , iterator(counting_iterator<Offset>(1), fun)
+                  , iterator(counting_iterator<Offset>(stop - start + 1), fun)
+                );
+                this->sum_ = this->sum_ + step * (stop - start);
+            }
+
+            Value sum_;
+            Finish finish_;
+        };
+
+        // The population variance of the window, updated as one value
+        // replaces another with Welford's recurrence
+        template<typename Value, typename Offset>
+        struct rolling_var_stat
+        {
+            typedef typename numeric::functional::average<Value, std::size_t>::result_type result_type;
+
+            explicit rolling_var_stat(std::size_t window)
+              : window_(window), mean_(), m2_()
+            {}
+
+            void init(Value const &, Offset)
+            {}
+
+            template<typename Out>
+            void segment(Value const &in, Value const &out, Offset start, Offset stop, Out &o)
+            {
+                if(in == out)
+                {
+                    o(this->variance_(), start, stop);
+                    return;
+                }
+
+                result_type const x = in, y = out;
+                for(; start != stop; ++start)
+                {
+                    result_type const mean = this->mean_ + (x - y) / this->window_;
+                    this->m2_ += (x - y) * (x - mean + y - this->mean_);
+                    this->mean_ = mean;
+                    o(this->variance_(), start);
+                }
+            }
+
+        private:
+            result_type variance_() const
+            {
+                // Rounding can leave a window of equal values a hair below zero
+                return this->m2_ < result_type() ? result_type() : this->m2_ / this->window_;
+            }
+
+            std::size_t window_;
+            result_type mean_;
+            result_type m2_;
+        };
+
+        // The least (or greatest) value in the window, from a deque of the
+        // values that may yet become it, each with the last offset at which
+        // it is in the window. Within a segment, the window only loses the
+        // leaving value at the segment's last offset.
+        template<typename Value, typename Offset, typename Before>
+        struct rolling_extremum_stat
+        {
+            explicit rolling_extremum_stat(Offset window)
+              : window_(window), candidates_()
+            {}
+
+            void init(Value const &zero, Offset start)
+            {
+                this->candidates_.push_back(std::make_pair(zero, start - 1));
+            }
+
+            template<typename Out>
+            void segment(Value const &in, Value const &, Offset start, Offset stop, Out &o)
+            {
+                this->expire_(start);
+                while(!this->candidates_.empty() && !Before()(this->candidates_.back().first, in))
+                {
+                    this->candidates_.pop_back();
+                }
+                this->candidates_.push_back(std::make_pair(in, stop - 1));
+
+                if(start + 1 != stop)
+                {
+                    o(this->candidates_.front().first, start, stop - 1);
+                }
+                this->expire_(stop - 1);
+                o(this->candidates_.front().first, stop - 1);
+            }
+
+        private:
+            void expire_(Offset offset)
+            {
+                while(!this->candidates_.empty() && this->candidates_.front().second <= offset - this->window_)
+                {
+                    this->candidates_.pop_front();
+                }
+            }
+
+            Offset window_;
+            std::deque<std::pair<Value, Offset> > candidates_;
+        };
+
+        template<typename Series, typename Length, typename Stat, typename Out>
+        Out rolling(Series const &series, Length window, Stat const &stat, Out const &out)
+        {
+            typedef concepts::TimeSeries<Series const> series_concept;
+            typedef typename series_concept::value_type value_type;
+            typedef typename series_concept::offset_type offset_type;
+
+            BOOST_MPL_ASSERT((is_integral<offset_type>));
+            BOOST_MPL_ASSERT((is_integral<Length>));
+
+            rolling_inserter<Out, Stat, value_type, offset_type> o(
+                out
+              , stat
+              , implicit_cast<value_type const &>(rrs::zero(series))
+              , static_cast<offset_type>(window)
+            );
+
+            return rrs::copy(series, o).finalize();
+        }
+    }
+
+    /// \brief Calculate the sum of the values within a window that slides
+    ///     across a series.
+    ///
+    /// The result at offset \em i is the sum of the input over the offsets
+    ///     <em>[i-window+1, i]</em>, counting the offsets the series leaves at
+    ///     its zero as zeros. Where the window lies within one constant run
+    ///     the sum does not change, so a run of length \em L costs constant time
+    ///     plus the offsets at which the result does change. The result is
+    ///     written in offset order to \c out.
+    ///
+    /// \param series The input series.
+    /// \param window The width of the window. Must be integral.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre \c Series is a model of the \c TimeSeries concept, with integral offsets.
+    /// \pre \c Out is a model of the \c OrderedInserter concept.
+    /// \pre <tt>window > 0</tt>
+    /// \pre For variables \c x and \c y of the series' \c value_type, the expressions
+    ///     \c (x+y) and \c (x-y) must be convertible to \c value_type.
+    /// \pre <tt>series[-inf] == range_run_storage::zero(series)</tt>
+    /// \pre <tt>series[inf] == range_run_storage::zero(series)</tt>
+    /// \return A \c piecewise_constant_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Length, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    rolling_sum(Series const &series, Length window, ordered_inserter<Out> out)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef typename series_concept::value_type value_type;
+        typedef detail::rolling_identity<value_type> finish_type;
+        typedef detail::rolling_sum_stat<value_type, typename series_concept::offset_type, finish_type> stat_type;
+
+        stat_type stat(range_run_storage::zero(series), finish_type());
+        return detail::rolling(series, window, stat, out);
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Length>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (piecewise_constant_series<
+        typename concepts::TimeSeries<Series const>::value_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , std::ptrdiff_t
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
+    >))
+    rolling_sum(Series const &series, Length window)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
+
+        piecewise_constant_series<value_type, discretization_type, std::ptrdiff_t, allocator_type> result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::rolling_sum(series, window, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+    /// \brief Calculate the mean of the values within a window that slides
+    ///     across a series.
+    ///
+    /// The result at offset \em i is <tt>numeric::average(s, window)</tt>,
+    ///     where \em s is the result of \c rolling_sum() at \em i.
+    ///
+    /// \param series The input series.
+    /// \param window The width of the window. Must be integral.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre The preconditions of \c rolling_sum().
+    /// \return A \c piecewise_constant_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Length, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    rolling_mean(Series const &series, Length window, ordered_inserter<Out> out)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef typename series_concept::value_type value_type;
+        typedef detail::rolling_average<value_type> finish_type;
+        typedef detail::rolling_sum_stat<value_type, typename series_concept::offset_type, finish_type> stat_type;
+
+        stat_type stat(range_run_storage::zero(series), finish_type(window));
+        return detail::rolling(series, window, stat, out);
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Length>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (piecewise_constant_series<
+        typename numeric::functional::average<
+            typename concepts::TimeSeries<Series const>::value_type
+          , std::size_t
+        >::result_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , std::ptrdiff_t
+      , typename detail::series_result_allocator<
+            typename numeric::functional::average<
+                typename concepts::TimeSeries<Series const>::value_type
+              , std::size_t
+            >::result_type
+          , Series
+        >::type
+    >))
+    rolling_mean(Series const &series, Length window)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename numeric::functional::average<value_type, std::size_t>::result_type result_type;
+        typedef typename detail::series_result_allocator<result_type, Series>::type allocator_type;
+
+        piecewise_constant_series<result_type, discretization_type, std::ptrdiff_t, allocator_type> result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::rolling_mean(series, window, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+    /// \brief Calculate the population variance of the values within a window
+    ///     that slides across a series.
+    ///
+    /// The result at offset \em i is the variance of the \c window values at
+    ///     offsets <em>[i-window+1, i]</em>, with divisor \c window. Take its
+    ///     square root for the standard deviation. It is updated in constant
+    ///     time per offset as each value enters and another leaves the window,
+    ///     and in constant time for a stretch in which the two are equal.
+    ///
+    /// \param series The input series.
+    /// \param window The width of the window. Must be integral.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre The preconditions of \c rolling_sum().
+    /// \pre The series' \c value_type is arithmetic.
+    /// \return A \c piecewise_constant_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Length, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    rolling_var(Series const &series, Length window, ordered_inserter<Out> out)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef detail::rolling_var_stat<
+            typename series_concept::value_type
+          , typename series_concept::offset_type
+        > stat_type;
+
+        return detail::rolling(series, window, stat_type(window), out);
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Length>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (piecewise_constant_series<
+        typename numeric::functional::average<
+            typename concepts::TimeSeries<Series const>::value_type
+          , std::size_t
+        >::result_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , std::ptrdiff_t
+      , typename detail::series_result_allocator<
+            typename numeric::functional::average<
+                typename concepts::TimeSeries<Series const>::value_type
+              , std::size_t
+            >::result_type
+          , Series
+        >::type
+    >))
+    rolling_var(Series const &series, Length window)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename numeric::functional::average<value_type, std::size_t>::result_type result_type;
+        typedef typename detail::series_result_allocator<result_type, Series>::type allocator_type;
+
+        piecewise_constant_series<result_type, discretization_type, std::ptrdiff_t, allocator_type> result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::rolling_var(series, window, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+    /// \brief Calculate the least value within a window that slides across
+    ///     a series.
+    ///
+    /// The result at offset \em i is the least of the values at offsets
+    ///     <em>[i-window+1, i]</em>, counting the offsets the series leaves at
+    ///     its zero as zeros. The candidates for the least value are kept in
+    ///     a monotonic deque with one entry per run, so each run costs constant
+    ///     amortized time, whatever its length.
+    ///
+    /// \param series The input series.
+    /// \param window The width of the window. Must be integral.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre \c Series is a model of the \c TimeSeries concept, with integral offsets.
+    /// \pre \c Out is a model of the \c OrderedInserter concept.
+    /// \pre <tt>window > 0</tt>
+    /// \pre The series' \c value_type is LessThanComparable.
+    /// \pre <tt>series[-inf] == range_run_storage::zero(series)</tt>
+    /// \pre <tt>series[inf] == range_run_storage::zero(series)</tt>
+    /// \return A \c piecewise_constant_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Length, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    rolling_min(Series const &series, Length window, ordered_inserter<Out> out)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef typename series_concept::value_type value_type;
+        typedef typename series_concept::offset_type offset_type;
+        typedef detail::rolling_extremum_stat<value_type, offset_type, std::less<value_type> > stat_type;
+
+        return detail::rolling(series, window, stat_type(static_cast<offset_type>(window)), out);
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Length>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (piecewise_constant_series<
+        typename concepts::TimeSeries<Series const>::value_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , std::ptrdiff_t
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
+    >))
+    rolling_min(Series const &series, Length window)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
+
+        piecewise_constant_series<value_type, discretization_type, std::ptrdiff_t, allocator_type> result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::rolling_min(series, window, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+    /// \brief Calculate the greatest value within a window that slides across
+    ///     a series.
+    ///
+    /// Same as \c rolling_min(), but for the greatest value.
+    ///
+    /// \param series The input series.
+    /// \param window The width of the window. Must be integral.
+    /// \param out The ordered inserter to receive the result.
+    ///
+    /// \pre The preconditions of \c rolling_min().
+    /// \return A \c piecewise_constant_series\<\> if no ordered inserter is specified;
+    ///     otherwise, the ordered inserter.
+    /// \attention If using the version that takes an \c OrderedInserter, you must call
+    ///     <tt>.commit()</tt> on the returned \c OrderedInserter when you are done with it.
+    template<typename Series, typename Length, typename Out>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (ordered_inserter<Out>))
+    rolling_max(Series const &series, Length window, ordered_inserter<Out> out)
+    {
+        typedef concepts::TimeSeries<Series const> series_concept;
+        typedef typename series_concept::value_type value_type;
+        typedef typename series_concept::offset_type offset_type;
+        typedef detail::rolling_extremum_stat<value_type, offset_type, std::greater<value_type> > stat_type;
+
+        return detail::rolling(series, window, stat_type(static_cast<offset_type>(window)), out);
+    }
+
+    /// \overload
+    ///
+    template<typename Series, typename Length>
+    BOOST_CONCEPT_REQUIRES(
+        ((concepts::TimeSeries<Series const>)),
+    (piecewise_constant_series<
+        typename concepts::TimeSeries<Series const>::value_type
+      , typename concepts::TimeSeries<Series const>::discretization_type
+      , std::ptrdiff_t
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
+    >))
+    rolling_max(Series const &series, Length window)
+    {
+        typedef typename concepts::TimeSeries<Series const>::value_type value_type;
+        typedef typename concepts::TimeSeries<Series const>::discretization_type discretization_type;
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
+
+        piecewise_constant_series<value_type, discretization_type, std::ptrdiff_t, allocator_type> result(
+            time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
+        );
+
+        time_series::rolling_max(series, window, time_series::make_ordered_inserter(result)).commit();
+        return result;
+    }
+
+}}
+
+#endif // BOOST_TIME_SERIES_NUMERIC_ROLLING_EAN_10_18_2026
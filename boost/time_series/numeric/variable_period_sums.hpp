@@ -21,6 +21,7 @@
 #include <boost/time_series/ordered_inserter.hpp>
 #include <boost/time_series/numeric/detail/tagged_ops.hpp>
 #include <boost/time_series/numeric/detail/periods_adaptors.hpp>
+#include <boost/time_series/numeric/detail/result_allocator.hpp>
 
 namespace boost { namespace time_series
 {
@@ -145,6 +146,10 @@ namespace boost { namespace time_series
         typename concepts::TimeSeries<Series const>::value_type
       , typename concepts::TimeSeries<Series const>::discretization_type
       , typename concepts::TimeSeries<Series const>::offset_type
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >))
     variable_period_sums(Series const &series, Periods const &periods)
     {
@@ -155,10 +160,13 @@ namespace boost { namespace time_series
 
         BOOST_MPL_ASSERT((is_same<offset_type, periods_offset_type>));
 
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
+
         // The periodic sums are held in a sparse array. The sums are
         // stored at the start of their associated periods.
-        sparse_series<value_type, discretization_type, offset_type> result(
+        sparse_series<value_type, discretization_type, offset_type, allocator_type> result(
             time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
         );
 
         time_series::variable_period_sums(
@@ -236,6 +244,10 @@ namespace boost { namespace time_series
         typename concepts::TimeSeries<Series const>::value_type
       , typename concepts::TimeSeries<Series const>::discretization_type
       , typename concepts::TimeSeries<Series const>::offset_type
+      , typename detail::series_result_allocator<
+            typename concepts::TimeSeries<Series const>::value_type
+          , Series
+        >::type
     >))
     shifted_variable_period_sums(Series const &series, Periods const &periods, Shifts const &shifts)
     {
@@ -246,10 +258,13 @@ namespace boost { namespace time_series
 
         BOOST_MPL_ASSERT((is_same<offset_type, periods_offset_type>));
 
+        typedef typename detail::series_result_allocator<value_type, Series>::type allocator_type;
+
         // The periodic sums are held in a sparse array. The sums are
         // stored at the start of their associated periods.
-        sparse_series<value_type, discretization_type, offset_type> result(
+        sparse_series<value_type, discretization_type, offset_type, allocator_type> result(
             time_series::discretization = series.discretization()
+          , time_series::allocator = detail::get_result_allocator<allocator_type>(series)
         );
 
         time_series::shifted_variable_period_sums(
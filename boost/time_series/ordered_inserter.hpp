@@ -17,6 +17,8 @@
 #include <boost/compressed_pair.hpp>
 #include <boost/utility/result_of.hpp>
 #include <boost/sequence/tag.hpp>
+#include <boost/range_run_storage/set_at_range.hpp>
+#include <boost/range_run_storage/set_at_offsets.hpp>
 #include <boost/time_series/concepts.hpp>
 #include <boost/time_series/time_series_fwd.hpp>
 
@@ -74,6 +76,18 @@ namespace boost { namespace time_series
           , inserter_(range_run_storage::ordered_inserter(series))
         {}
 
+        /// Initializes \c this->inserter_ to \c inserter
+        ///
+        /// \param inserter An \c OrderedInserter for a \c Series, such as one
+        ///     that appends to the series rather than replacing its contents.
+        /// \param offset The offset of the first run written into this inserter,
+        ///     if the offset of that run is not otherwise specified.
+        /// \post <tt>this->offset_ == offset</tt>
+        explicit ordered_inserter(inserter_type const &inserter, offset_type offset = -inf)
+          : offset_(offset)
+          , inserter_(inserter)
+        {}
+
         /// \return \c *this
         ordered_inserter &operator *()
         {
@@ -207,6 +221,48 @@ namespace boost { namespace time_series
             return *this;
         }
 
+        /// Calls <tt>range_run_storage::set_at_range(this->inserter_, offset, begin, end)</tt>,
+        ///     which writes the values in <tt>[begin, end)</tt> as unit runs at
+        ///     consecutive offsets starting at \c offset. Storages that can take
+        ///     the whole block at once copy it in a single operation.
+        ///
+        /// \pre <tt>offset >= this->offset_</tt>
+        /// \pre \c Iter is a Forward Iterator whose value type is implicitly
+        ///     convertible to \c value_type
+        /// \post <tt>this->offset_ == offset + std::distance(begin, end)</tt>
+        /// \return \c *this
+        template<typename Iter>
+        ordered_inserter &set_at_range(offset_type offset, Iter begin, Iter end)
+        {
+            BOOST_ASSERT(offset >= this->offset_);
+            range_run_storage::set_at_range(this->inserter_, offset, begin, end);
+            this->offset_ = offset + std::distance(begin, end);
+            return *this;
+        }
+
+        /// Calls <tt>range_run_storage::set_at_offsets(this->inserter_, begin, end, values)</tt>,
+        ///     which writes a unit run at each offset in <tt>[begin, end)</tt>,
+        ///     with the corresponding value in the sequence starting at \c values.
+        ///
+        /// \pre The offsets in <tt>[begin, end)</tt> are strictly increasing,
+        ///     and the first is <tt>>= this->offset_</tt>
+        /// \pre \c OffsetIter is a Forward Iterator
+        /// \post If <tt>begin != end</tt>, \c this->offset_ is one past the last offset.
+        /// \return \c *this
+        template<typename OffsetIter, typename ValueIter>
+        ordered_inserter &set_at_offsets(OffsetIter begin, OffsetIter end, ValueIter values)
+        {
+            if(begin != end)
+            {
+                BOOST_ASSERT(*begin >= this->offset_);
+                OffsetIter last = begin;
+                std::advance(last, std::distance(begin, end) - 1);
+                range_run_storage::set_at_offsets(this->inserter_, begin, end, values);
+                this->offset_ = *last + 1;
+            }
+            return *this;
+        }
+
         /// Calls <tt>range_run_storage::commit(this->inserter_)</tt>
         ///
         void commit()
@@ -277,6 +333,30 @@ namespace boost { namespace range_run_storage { namespace impl
         }
     };
 
+    /// INTERNAL ONLY
+    template<typename S, typename O, typename I, typename J>
+    struct set_at_range<S, O, I, J, sequence::impl::time_series_ordered_inserter_tag>
+    {
+        typedef void result_type;
+
+        void operator ()(S &s, O &offset, I &begin, J &end) const
+        {
+            s.set_at_range(offset, begin, end);
+        }
+    };
+
+    /// INTERNAL ONLY
+    template<typename S, typename I, typename J, typename V>
+    struct set_at_offsets<S, I, J, V, sequence::impl::time_series_ordered_inserter_tag>
+    {
+        typedef void result_type;
+
+        void operator ()(S &s, I &begin, J &end, V &values) const
+        {
+            s.set_at_offsets(begin, end, values);
+        }
+    };
+
     /// INTERNAL ONLY
     template<typename S>
     struct commit<S, sequence::impl::time_series_ordered_inserter_tag>
@@ -11,6 +11,7 @@
 
 #include <boost/time_series/time_series_facade.hpp>
 #include <boost/time_series/storage/piecewise_constant_array.hpp>
+#include <boost/time_series/traits/allocator_type.hpp>
 
 namespace boost { namespace time_series
 {
@@ -22,52 +23,79 @@ namespace boost { namespace time_series
     /// The named parameters for the constructor are, in order:
     ///   -# \c discretization, with a default of \c Discretization(1)
     ///   -# \c zero, with a default of \c Value(0)
-    template<typename Value, typename Discretization, typename Offset>
+    ///   -# \c allocator, with a default of \c Allocator()
+    template<typename Value, typename Discretization, typename Offset, typename Allocator>
     struct piecewise_constant_series
       : time_series_facade<
-            piecewise_constant_series<Value, Discretization, Offset>
-          , storage::piecewise_constant_array<Value, Offset>
+            piecewise_constant_series<Value, Discretization, Offset, Allocator>
+          , storage::piecewise_constant_array<Value, Offset, Allocator>
           , Discretization
         >
     {
         typedef time_series_facade<
-            piecewise_constant_series<Value, Discretization, Offset>
-          , storage::piecewise_constant_array<Value, Offset>
+            piecewise_constant_series<Value, Discretization, Offset, Allocator>
+          , storage::piecewise_constant_array<Value, Offset, Allocator>
           , Discretization
         > base_type;
 
+        typedef Allocator allocator_type;
+
         using base_type::operator=;
 
         BOOST_TIME_SERIES_DEFINE_CTORS(piecewise_constant_series)
+
+        /// \return A copy of the allocator of the series' storage.
+        /// \throw nothrow
+        allocator_type get_allocator() const
+        {
+            return allocator_type(detail::time_series_facade_access::data(*this).get_allocator());
+        }
+
+        /// Builds an index of the ends of the runs, which speeds up random lookups
+        /// into a large series until it is next changed. A change drops the
+        /// index; lookups never build it, so they are safe to make from
+        /// several threads at once.
+        /// \throw std::bad_alloc
+        void build_index()
+        {
+            detail::time_series_facade_access::data(*this).build_index();
+        }
     };
 
     namespace traits
     {
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct storage_category<piecewise_constant_series<Value, Discretization, Offset> >
-          : storage_category<storage::piecewise_constant_array<Value, Offset> >
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct storage_category<piecewise_constant_series<Value, Discretization, Offset, Allocator> >
+          : storage_category<storage::piecewise_constant_array<Value, Offset, Allocator> >
         {};
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct discretization_type<piecewise_constant_series<Value, Discretization, Offset> >
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct discretization_type<piecewise_constant_series<Value, Discretization, Offset, Allocator> >
         {
             typedef Discretization type;
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct offset_type<piecewise_constant_series<Value, Discretization, Offset> >
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct offset_type<piecewise_constant_series<Value, Discretization, Offset, Allocator> >
         {
             typedef Offset type;
         };
 
         /// INTERNAL ONLY
-        template<typename Value, typename Discretization, typename Offset>
-        struct generate_series<piecewise_constant_storage_tag, Value, Discretization, Offset>
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct allocator_type<piecewise_constant_series<Value, Discretization, Offset, Allocator> >
+        {
+            typedef Allocator type;
+        };
+
+        /// INTERNAL ONLY
+        template<typename Value, typename Discretization, typename Offset, typename Allocator>
+        struct generate_series<piecewise_constant_storage_tag, Value, Discretization, Offset, Allocator>
         {
-            typedef piecewise_constant_series<Value, Discretization, Offset> type;
+            typedef piecewise_constant_series<Value, Discretization, Offset, Allocator> type;
         };
     }
 
@@ -76,8 +104,8 @@ namespace boost { namespace time_series
 namespace boost { namespace sequence { namespace impl
 {
     /// INTERNAL ONLY
-    template<typename Value, typename Discretization, typename Offset>
-    struct tag<time_series::piecewise_constant_series<Value, Discretization, Offset> >
+    template<typename Value, typename Discretization, typename Offset, typename Allocator>
+    struct tag<time_series::piecewise_constant_series<Value, Discretization, Offset, Allocator> >
     {
         typedef time_series_tag type;
     };
@@ -89,8 +117,8 @@ namespace boost { namespace constructors { namespace impl
     struct piecewise_constant_series_tag;
 
     /// INTERNAL ONLY
-    template<typename Value, typename Discretization, typename Offset>
-    struct tag<time_series::piecewise_constant_series<Value, Discretization, Offset> >
+    template<typename Value, typename Discretization, typename Offset, typename Allocator>
+    struct tag<time_series::piecewise_constant_series<Value, Discretization, Offset, Allocator> >
     {
         typedef piecewise_constant_series_tag type;
     };
@@ -103,6 +131,7 @@ namespace boost { namespace constructors { namespace impl
         typedef parameter::parameters<
             parameter::optional<time_series::tag::discretization>
           , parameter::optional<time_series::tag::zero>
+          , parameter::optional<time_series::tag::allocator>
         > args_type;
     };
 
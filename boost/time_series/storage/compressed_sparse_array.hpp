@@ -0,0 +1,701 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file compressed_sparse_array.hpp
+/// A compressed sparse array that satisfies the \c InfiniteRangeRunStorage
+/// concept
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_STORAGE_COMPRESSED_SPARSE_ARRAY_EAN_10_18_2026
+#define BOOST_TIME_SERIES_STORAGE_COMPRESSED_SPARSE_ARRAY_EAN_10_18_2026
+
+#include <boost/time_series/time_series_fwd.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/detail/construct.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/implicit_cast.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/parameter/parameters.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/range_run_storage/algorithm/transform.hpp>
+#include <boost/range_run_storage/utility/infinite_run.hpp>
+#include <boost/time_series/detail/ref_counted_object.hpp>
+#include <boost/time_series/traits/storage_category.hpp>
+#include <boost/time_series/utility/is_zero.hpp>
+#include <boost/time_series/storage/sparse_array.hpp>
+#include <boost/time_series/storage/characteristic_array.hpp>
+#include <boost/time_series/storage/detail/compressed_stream.hpp>
+
+namespace boost { namespace time_series { namespace storage
+{
+    namespace rrs = range_run_storage;
+    using rrs::concepts::Run;
+
+    template<typename Value, typename Offset = std::ptrdiff_t>
+    struct compressed_sparse_array;
+
+    namespace detail
+    {
+        // The header of a block of a compressed_sparse_array: the first offset
+        // and value of the block, where the encoding of the rest begins in
+        // the bit stream, and how many there are in all.
+        template<typename Offset>
+        struct compressed_block
+        {
+            Offset offset;
+            boost::uint64_t bits;
+            std::size_t position;
+            std::size_t size;
+        };
+
+        template<typename Offset>
+        struct block_before
+        {
+            bool operator ()(Offset offset, compressed_block<Offset> const &block) const
+            {
+                return offset < block.offset;
+            }
+        };
+
+        template<typename Value>
+        boost::uint64_t value_to_bits(Value const &value)
+        {
+            boost::uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(Value));
+            return bits;
+        }
+
+        template<typename Value>
+        Value bits_to_value(boost::uint64_t bits)
+        {
+            Value value;
+            std::memcpy(&value, &bits, sizeof(Value));
+            return value;
+        }
+
+        // compressed_sparse_iterator
+        //   Walks the offsets of a compressed_sparse_array, decoding each in
+        //   turn with its value.
+        template<typename Value, typename Offset>
+        struct compressed_sparse_iterator
+          : iterator_facade<
+                compressed_sparse_iterator<Value, Offset>
+              , Offset const
+              , std::forward_iterator_tag
+            >
+        {
+            compressed_sparse_iterator()
+              : block_(0)
+              , end_(0)
+              , index_(0)
+              , words_(0)
+              , reader_()
+              , offsets_()
+              , values_()
+              , offset_()
+            {}
+
+            compressed_sparse_iterator(
+                compressed_block<Offset> const *block
+              , compressed_block<Offset> const *end
+              , boost::uint64_t const *words
+            )
+              : block_(block)
+              , end_(end)
+              , index_(0)
+              , words_(words)
+              , reader_()
+              , offsets_()
+              , values_()
+              , offset_()
+            {
+                this->load_();
+            }
+
+            Value value() const
+            {
+                return detail::bits_to_value<Value>(this->values_.bits());
+            }
+
+        private:
+            friend class boost::iterator_core_access;
+
+            Offset const &dereference() const
+            {
+                return this->offset_;
+            }
+
+            void increment()
+            {
+                if(++this->index_ == this->block_->size)
+                {
+                    ++this->block_;
+                    this->index_ = 0;
+                    this->load_();
+                }
+                else
+                {
+                    this->offset_ = static_cast<Offset>(this->offsets_.decode(this->reader_));
+                    this->values_.decode(this->reader_);
+                }
+            }
+
+            bool equal(compressed_sparse_iterator const &that) const
+            {
+                return this->block_ == that.block_ && this->index_ == that.index_;
+            }
+
+            void load_()
+            {
+                if(this->block_ != this->end_)
+                {
+                    this->reader_ = bit_reader(this->words_, this->block_->position);
+                    this->offsets_ = offset_codec(this->block_->offset);
+                    this->values_ = value_codec(this->block_->bits);
+                    this->offset_ = this->block_->offset;
+                }
+            }
+
+            compressed_block<Offset> const *block_;
+            compressed_block<Offset> const *end_;
+            std::size_t index_;
+            boost::uint64_t const *words_;
+            bit_reader reader_;
+            offset_codec offsets_;
+            value_codec values_;
+            Offset offset_;
+        };
+    }
+
+    template<typename Value>
+    struct msvc_result_compressed_elements_map
+    {
+        template<typename K>
+        struct result;
+
+        template<typename This, typename K>
+        struct result<This(K)>
+        {
+            typedef Value type;
+        };
+
+        template<typename This, typename K, typename V>
+        struct result<This(K, V)>
+        {
+            typedef void type;
+        };
+    };
+
+    // compressed_elements_map
+    //   The cursors of a compressed_sparse_array walk its decoding iterator,
+    //   which carries the value that goes with the offset. A value cannot be
+    //   changed in place, since the encoding of the values after it depends
+    //   on it; write through the ordered inserter instead.
+    template<typename Value>
+    struct compressed_elements_map
+      : msvc_result_compressed_elements_map<Value>
+    {
+        template<typename K>
+        Value operator ()(K const &k) const
+        {
+            return k.value();
+        }
+
+        template<typename K, typename V>
+        void operator ()(K const &, V const &) const
+        {
+            BOOST_ASSERT(false);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // compressed_sparse_ordered_inserter
+    template<typename Value, typename Offset>
+    struct compressed_sparse_ordered_inserter
+    {
+        typedef Value value_type;
+        typedef Offset offset_type;
+
+        explicit compressed_sparse_ordered_inserter(compressed_sparse_array<Value, Offset> &that)
+          : old_(that)
+          , new_(time_series::detail::ref_counted_object<compressed_sparse_array<Value, Offset> >::create(
+                std::allocator<compressed_sparse_array<Value, Offset> >()
+              , constructors::construct<compressed_sparse_array<Value, Offset> >(
+                    time_series::zero = rrs::zero(that)
+                )
+            ))
+        {}
+
+        template<typename R, typename V>
+        void set_at(R &run, V &value)
+        {
+            compressed_sparse_array<Value, Offset> &that = this->new_->get();
+            if(time_series::detail::is_zero(that, value))
+            {
+                return;
+            }
+
+            typename Run<R>::offset_type off = rrs::offset(run);
+            typename Run<R>::offset_type endoff = rrs::end_offset(run);
+            if(off == -inf)
+            {
+                that.pre_.set(run, value);
+            }
+            else if(endoff == inf)
+            {
+                that.post_.set(run, value);
+            }
+            else
+            {
+                BOOST_ASSERT(off < endoff);
+                do
+                {
+                    that.push_back(value, off);
+                }
+                while(++off < endoff);
+            }
+        }
+
+        void commit()
+        {
+            compressed_sparse_array<Value, Offset> &that = this->new_->get();
+            that.shrink_to_fit_();
+            that.swap(this->old_);
+        }
+
+    private:
+        compressed_sparse_array<Value, Offset> &old_;
+        intrusive_ptr<time_series::detail::ref_counted_object<compressed_sparse_array<Value, Offset> > > new_;
+    };
+
+    // The compressed_sparse_array
+    //   The offsets and values are encoded as in Gorilla: each offset as the
+    //   change in the distance from the offset before, each value as the XOR
+    //   of its bits with those of the value before. The encodings go into a
+    //   single bit stream, in blocks of block_size with a header each that
+    //   holds the first offset and value in the clear. Random access finds
+    //   its block by binary search over the headers, and decodes at most
+    //   block_size entries from there.
+    //
+    //   Regular ticks with slowly changing values cost a few bits per entry
+    //   rather than the sizeof(Offset) + sizeof(Value) bytes of a sparse_array.
+    template<typename Value, typename Offset>
+    struct compressed_sparse_array
+    {
+        BOOST_MPL_ASSERT((is_pod<Value>));
+        BOOST_MPL_ASSERT_RELATION(sizeof(Value), <=, sizeof(boost::uint64_t));
+        BOOST_MPL_ASSERT((is_integral<Offset>));
+
+        typedef Value value_type;
+        typedef Offset offset_type;
+
+        typedef rrs::infinite_run_value<Value, Offset> pre_type;
+        typedef rrs::infinite_run_value<Value, Offset> post_type;
+
+        typedef typename pre_type::run_type pre_run_type;
+        typedef typename post_type::run_type post_run_type;
+
+        typedef std::size_t size_type;
+        typedef detail::compressed_sparse_iterator<Value, Offset> iterator;
+        typedef detail::compressed_sparse_iterator<Value, Offset> const_iterator;
+
+        typedef Value const_reference;
+        typedef Value reference;
+
+        // The number of entries in a block
+        static std::size_t const block_size = 128;
+
+        friend struct compressed_sparse_ordered_inserter<Value, Offset>;
+
+        template<typename Args>
+        explicit compressed_sparse_array(Args const &args)
+          : blocks_()
+          , words_()
+          , bits_(0)
+          , size_(0)
+          , last_offset_()
+          , offsets_()
+          , values_()
+          , zero_(implicit_cast<Value const &>(args[time_series::zero | numeric::zero<Value>()]))
+          , pre_(args[time_series::zero | numeric::zero<Value>()])
+          , post_(args[time_series::zero | numeric::zero<Value>()])
+        {
+            this->pre_.first = this->pre_.second = -inf;
+            this->post_.first = this->post_.second = inf;
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this->blocks_begin_(), this->blocks_end_(), this->words_begin_());
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this->blocks_end_(), this->blocks_end_(), this->words_begin_());
+        }
+
+        size_type size() const
+        {
+            return this->size_;
+        }
+
+        bool empty() const
+        {
+            return 0 == this->size_;
+        }
+
+        // The number of bytes taken by the block headers and the bit stream
+        std::size_t encoded_size() const
+        {
+            return this->blocks_.size() * sizeof(detail::compressed_block<Offset>)
+                + this->words_.size() * sizeof(boost::uint64_t);
+        }
+
+        void swap(compressed_sparse_array &that)
+        {
+            using std::swap;
+            swap(this->blocks_, that.blocks_);
+            swap(this->words_, that.words_);
+            swap(this->bits_, that.bits_);
+            swap(this->size_, that.size_);
+            swap(this->last_offset_, that.last_offset_);
+            swap(this->offsets_, that.offsets_);
+            swap(this->values_, that.values_);
+            swap(this->zero_, that.zero_);
+            swap(this->pre_, that.pre_);
+            swap(this->post_, that.post_);
+        }
+
+        reference operator [](offset_type i) const
+        {
+            if(i < this->pre_.second)
+            {
+                return this->pre_.value;
+            }
+            else if(i >= this->post_.first)
+            {
+                return this->post_.value;
+            }
+
+            detail::compressed_block<Offset> const *block = std::upper_bound(
+                this->blocks_begin_()
+              , this->blocks_end_()
+              , i
+              , detail::block_before<Offset>()
+            );
+
+            if(block != this->blocks_begin_())
+            {
+                const_iterator where(block - 1, this->blocks_end_(), this->words_begin_());
+                const_iterator const end(block, this->blocks_end_(), this->words_begin_());
+                for(; where != end && *where < i; ++where)
+                {}
+
+                if(where != end && !(i < *where))
+                {
+                    return where.value();
+                }
+            }
+
+            return this->zero();
+        }
+
+        template<typename Run, typename Val>
+        void set_at(Run &run, Val &val)
+        {
+            Value const &v(val), &z(this->zero());
+            compressed_sparse_ordered_inserter<Value, Offset> o(*this);
+            rrs::transform(as_characteristic(run, v, z), *this, rrs::_1, rrs::_1, rrs::_1, o);
+            rrs::commit(o);
+        }
+
+        reference zero() const
+        {
+            return this->zero_;
+        }
+
+        void set_zero(Value const &z)
+        {
+            this->zero_ = z;
+        }
+
+        pre_type &pre() { return this->pre_; }
+        post_type &post() { return this->post_; }
+        pre_type const &pre() const { return this->pre_; }
+        post_type const &post() const { return this->post_; }
+
+    private:
+        void push_back(Value const &value, Offset offset)
+        {
+            BOOST_ASSERT(this->blocks_.empty() || this->last_offset_ < offset);
+            boost::uint64_t const bits = detail::value_to_bits(value);
+            if(this->blocks_.empty() || block_size == this->blocks_.back().size)
+            {
+                detail::compressed_block<Offset> const block = {offset, bits, this->bits_, 1};
+                this->blocks_.push_back(block);
+                this->offsets_ = detail::offset_codec(offset);
+                this->values_ = detail::value_codec(bits);
+            }
+            else
+            {
+                detail::bit_writer out(this->words_, this->bits_);
+                this->offsets_.encode(out, offset);
+                this->values_.encode(out, bits);
+                ++this->blocks_.back().size;
+            }
+
+            ++this->size_;
+            this->last_offset_ = offset;
+        }
+
+        void shrink_to_fit_()
+        {
+            std::vector<detail::compressed_block<Offset> >(this->blocks_).swap(this->blocks_);
+            std::vector<boost::uint64_t>(this->words_).swap(this->words_);
+        }
+
+        detail::compressed_block<Offset> const *blocks_begin_() const
+        {
+            return this->blocks_.empty() ? 0 : &this->blocks_[0];
+        }
+
+        detail::compressed_block<Offset> const *blocks_end_() const
+        {
+            return this->blocks_begin_() + this->blocks_.size();
+        }
+
+        boost::uint64_t const *words_begin_() const
+        {
+            return this->words_.empty() ? 0 : &this->words_[0];
+        }
+
+        std::vector<detail::compressed_block<Offset> > blocks_;
+        std::vector<boost::uint64_t> words_;
+        std::size_t bits_;
+        std::size_t size_;
+        Offset last_offset_;            // the offset of the last entry, to check the order
+        detail::offset_codec offsets_;  // the state of the encoder, for appending
+        detail::value_codec values_;
+        Value zero_;
+        pre_type pre_;
+        post_type post_;
+    };
+
+    template<typename Value, typename Offset>
+    void swap(compressed_sparse_array<Value, Offset> &left, compressed_sparse_array<Value, Offset> &right)
+    {
+        left.swap(right);
+    }
+}}}
+
+namespace boost
+{
+    namespace sequence { namespace impl
+    {
+        struct compressed_sparse_array_tag;
+        struct compressed_sparse_ordered_inserter_tag;
+
+        template<typename Value, typename Offset>
+        struct tag<time_series::storage::compressed_sparse_array<Value, Offset> >
+        {
+            typedef compressed_sparse_array_tag type;
+        };
+
+        template<typename Value, typename Offset>
+        struct tag<time_series::storage::compressed_sparse_ordered_inserter<Value, Offset> >
+        {
+            typedef compressed_sparse_ordered_inserter_tag type;
+        };
+
+        template<typename S>
+        struct elements<S, compressed_sparse_array_tag>
+        {
+            typedef time_series::storage::compressed_elements_map<typename S::value_type> result_type;
+
+            result_type operator ()(S &) const
+            {
+                return result_type();
+            }
+        };
+    }}
+
+    namespace range_run_storage { namespace impl
+    {
+        template<typename S>
+        struct runs<S, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef typename S::offset_type offset_type;
+            typedef time_series::storage::sparse_runs_map<offset_type> result_type;
+
+            result_type operator ()(S &) const
+            {
+                return result_type();
+            }
+        };
+
+        template<typename S, typename I>
+        struct get_at<S, I, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef typename S::const_reference result_type;
+
+            result_type operator ()(S &s, I &i) const
+            {
+                return s[i];
+            }
+        };
+
+        template<typename S>
+        struct zero<S, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef typename S::reference result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.zero();
+            }
+        };
+
+        template<typename S, typename V>
+        struct set_zero<S, V, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, V &v) const
+            {
+                return s.set_zero(v);
+            }
+        };
+
+        template<typename S>
+        struct pre_run<S, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef typename S::pre_run_type result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.pre();
+            }
+        };
+
+        template<typename S>
+        struct pre_value<S, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef typename S::value_type const &result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.pre().value;
+            }
+        };
+
+        template<typename S, typename V>
+        struct set_pre_value<S, V, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, V &v) const
+            {
+                s.pre().value = v;
+            }
+        };
+
+        template<typename S>
+        struct post_run<S, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef typename S::post_run_type result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.post();
+            }
+        };
+
+        template<typename S>
+        struct post_value<S, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef typename S::value_type const &result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.post().value;
+            }
+        };
+
+        template<typename S, typename V>
+        struct set_post_value<S, V, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, V &v) const
+            {
+                s.post().value = v;
+            }
+        };
+
+        template<typename S>
+        struct ordered_inserter<S, sequence::impl::compressed_sparse_array_tag>
+        {
+            typedef time_series::storage::compressed_sparse_ordered_inserter<
+                typename S::value_type
+              , typename S::offset_type
+            > result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return result_type(s);
+            }
+        };
+
+        template<typename S>
+        struct commit<S, sequence::impl::compressed_sparse_ordered_inserter_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s) const
+            {
+                return s.commit();
+            }
+        };
+    }}
+}
+
+namespace boost { namespace time_series { namespace traits
+{
+    template<typename Value, typename Offset>
+    struct storage_category<storage::compressed_sparse_array<Value, Offset> >
+    {
+        typedef compressed_sparse_storage_tag type;
+    };
+}}}
+
+namespace boost { namespace constructors { namespace impl
+{
+    template<typename Value, typename Offset>
+    struct tag<time_series::storage::compressed_sparse_array<Value, Offset> >
+    {
+        typedef sequence::impl::compressed_sparse_array_tag type;
+    };
+
+    template<typename T>
+    struct construct<T, sequence::impl::compressed_sparse_array_tag>
+      : arg_pack_construct
+    {
+        typedef parameter::parameters<
+            parameter::optional<time_series::tag::zero>
+        > args_type;
+    };
+
+}}}
+
+#endif // BOOST_TIME_SERIES_STORAGE_COMPRESSED_SPARSE_ARRAY_EAN_10_18_2026
@@ -11,18 +11,27 @@
 
 #include <boost/time_series/time_series_fwd.hpp>
 #include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <iterator>
 #include <boost/implicit_cast.hpp>
 #include <boost/mpl/assert.hpp>
 #include <boost/detail/construct.hpp>
 #include <boost/parameter/parameters.hpp>
 #include <boost/range_run_storage/concepts.hpp>
 #include <boost/range_run_storage/difference1.hpp>
+#include <boost/range_run_storage/set_at_range.hpp>
+#include <boost/range_run_storage/set_at_offsets.hpp>
+#include <boost/range_run_storage/utility/unit_run.hpp>
 #include <boost/range_run_storage/utility/infinite_run.hpp>
 #include <boost/range_run_storage/algorithm/transform.hpp>
 #include <boost/time_series/detail/ref_counted_object.hpp>
 #include <boost/time_series/traits/storage_category.hpp>
 #include <boost/time_series/storage/detail/offset_runs.hpp>
 #include <boost/time_series/storage/detail/indirect_copy_and_swap_inserter.hpp>
+#include <boost/time_series/storage/detail/default_allocator.hpp>
 #include <boost/time_series/storage/characteristic_array.hpp>
 #include <boost/serialization/vector.hpp>
 
@@ -31,30 +40,102 @@ namespace boost { namespace time_series { namespace storage
     namespace rrs = range_run_storage;
     using rrs::concepts::Run;
 
-    template<typename Value>
+    template<typename Value, typename Allocator = std::allocator<Value> >
     struct dense_array;
 
+    ///////////////////////////////////////////////////////////////////////////////
+    // append_mode
+    //   Passed to the dense_ordered_inserter constructor to request that the
+    //   existing elements be kept and new runs be appended after them.
+    struct append_mode_t {};
+    append_mode_t const append_mode = {};
+
     ///////////////////////////////////////////////////////////////////////////////
     // dense_ordered_inserter
-    template<typename Value>
+    //   By default, the runs are written into a new dense_array which replaces
+    //   the old one on commit(). In append mode, runs that land at or after the
+    //   end of the dense region are staged in a tail, which commit() splices
+    //   onto the end of the existing vector; the first run that touches earlier
+    //   data falls back to copy-and-swap. The old array is then copied once,
+    //   and that run and the ones after it are staged in order and written
+    //   into the copy in a single pass on commit(). Either way the old array
+    //   is left alone until commit(). The new arrays are allocated with the
+    //   allocator of the old one.
+    template<typename Value, typename Allocator = std::allocator<Value> >
     struct dense_ordered_inserter
     {
         typedef Value value_type;
 
-        explicit dense_ordered_inserter(dense_array<Value> &that)
+        explicit dense_ordered_inserter(dense_array<Value, Allocator> &that)
           : old_(that)
-          , new_(new time_series::detail::ref_counted_object<dense_array<Value> >(
-                constructors::construct<dense_array<Value> >(
+          , new_(object_type::create(
+                that.get_allocator()
+              , constructors::construct<dense_array<Value, Allocator> >(
                     time_series::start = static_cast<std::ptrdiff_t>(inf)
                   , time_series::zero = rrs::zero(that)
+                  , time_series::allocator = that.get_allocator()
+                )
+            ))
+          , append_(false)
+        {}
+
+        dense_ordered_inserter(dense_array<Value, Allocator> &that, append_mode_t)
+          : old_(that)
+          , new_()
+          , tail_(object_type::create(
+                that.get_allocator()
+              , constructors::construct<dense_array<Value, Allocator> >(
+                    time_series::zero = rrs::zero(that)
+                  , time_series::allocator = that.get_allocator()
                 )
             ))
+          , append_(true)
         {}
 
         template<typename R, typename V>
         void set_at(R &run, V &value)
         {
-            dense_array<Value> &that = this->new_->get();
+            if(this->append_)
+            {
+                if(!this->new_ && this->can_stage_(rrs::offset(run), rrs::end_offset(run)))
+                {
+                    this->tail_->get().append(run, value);
+                    return;
+                }
+
+                if(!this->new_)
+                {
+                    this->new_ = object_type::create(this->old_.get_allocator(), this->old_);
+                    this->new_->get().splice(this->tail_->get());
+                    this->runs_ = runs_object_type::create(
+                        this->old_.get_allocator()
+                      , runs_type(typename runs_type::allocator_type(this->old_.get_allocator()))
+                    );
+                }
+
+                std::ptrdiff_t off = rrs::offset(run);
+                std::ptrdiff_t endoff = rrs::end_offset(run);
+                dense_array<Value, Allocator> &that = this->new_->get();
+                if(off != -inf
+                && endoff != inf
+                && off >= that.pre_.second
+                && endoff <= that.post_.first)
+                {
+                    this->runs_->get().push_back(std::make_pair(
+                        std::make_pair(off, endoff)
+                      , implicit_cast<Value const &>(value)
+                    ));
+                    return;
+                }
+
+                // Runs that touch the pre- or post-run are rare, and are
+                // written at once. They do not overlap the staged runs, so
+                // the order in which the two are written does not matter.
+                that.set_at(run, value);
+                return;
+            }
+
+            dense_array<Value, Allocator> &that = this->new_->get();
             typename Run<R>::offset_type off = rrs::offset(run);
             typename Run<R>::offset_type endoff = rrs::end_offset(run);
             BOOST_ASSERT(off < endoff);
@@ -69,21 +150,167 @@ namespace boost { namespace time_series { namespace storage
             else
             {
                 that.offset_ = std::min<std::ptrdiff_t>(that.offset_, off);
-                that.reserve(endoff - that.offset_);
                 that.resize(off - that.offset_, implicit_cast<Value const &>(rrs::zero(that)));
                 that.resize(endoff - that.offset_, value);
             }
         }
 
+        // Consecutive values starting at off. A block that lands past the end
+        // of the dense region is copied into the vector in one go.
+        template<typename Iter>
+        void set_at_range(std::ptrdiff_t off, Iter begin, Iter end)
+        {
+            if(begin == end)
+            {
+                return;
+            }
+
+            std::ptrdiff_t endoff = off + std::distance(begin, end);
+            dense_array<Value, Allocator> *that = this->block_target_(off, endoff);
+            if(that)
+            {
+                that->append_range(off, begin, end);
+                return;
+            }
+
+            for(; begin != end; ++begin, ++off)
+            {
+                rrs::unit_run<std::ptrdiff_t> run(off);
+                Value const value = *begin;
+                this->set_at(run, value);
+            }
+        }
+
+        // Unit runs at the ascending offsets in [begin, end), with the values
+        // in values. Gaps between the offsets are filled with zero.
+        template<typename OffsetIter, typename ValueIter>
+        void set_at_offsets(OffsetIter begin, OffsetIter end, ValueIter values)
+        {
+            if(begin == end)
+            {
+                return;
+            }
+
+            OffsetIter last = begin;
+            std::advance(last, std::distance(begin, end) - 1);
+            dense_array<Value, Allocator> *that = this->block_target_(*begin, *last + 1);
+            if(that)
+            {
+                that->append_offsets(begin, end, values, *last + 1);
+                return;
+            }
+
+            for(; begin != end; ++begin, ++values)
+            {
+                rrs::unit_run<std::ptrdiff_t> run(*begin);
+                Value const value = *values;
+                this->set_at(run, value);
+            }
+        }
+
         void commit()
         {
-            dense_array<Value> &that = this->new_->get();
-            that.swap(this->old_);
+            if(this->new_)
+            {
+                dense_array<Value, Allocator> &that = this->new_->get();
+                if(this->runs_)
+                {
+                    this->write_runs_(that);
+                }
+                that.swap(this->old_);
+            }
+            else if(this->tail_)
+            {
+                this->old_.splice(this->tail_->get());
+            }
         }
 
     private:
-        dense_array<Value> &old_;
-        intrusive_ptr<time_series::detail::ref_counted_object<dense_array<Value> > > new_;
+        // True if [off, endoff) lies at or after the end of the dense region,
+        // including anything staged so far, and clear of the pre- and post-runs.
+        bool can_stage_(std::ptrdiff_t off, std::ptrdiff_t endoff) const
+        {
+            std::ptrdiff_t end = !this->tail_->get().empty()
+              ? this->tail_->get().end_offset()
+              : this->old_.end_offset();
+            return off != -inf
+                && endoff != inf
+                && off >= end
+                && off >= this->old_.pre_.second
+                && endoff <= this->old_.post_.first;
+        }
+
+        // The array that [off, endoff) can be appended to without touching
+        // earlier data, or 0 if it must be written run by run.
+        dense_array<Value, Allocator> *block_target_(std::ptrdiff_t off, std::ptrdiff_t endoff)
+        {
+            if(this->append_)
+            {
+                return !this->new_ && this->can_stage_(off, endoff)
+                  ? &this->tail_->get()
+                  : 0;
+            }
+
+            dense_array<Value, Allocator> &that = this->new_->get();
+            return off != -inf
+                && endoff != inf
+                && (that.empty() || off >= that.end_offset())
+                && off >= that.pre_.second
+                && endoff <= that.post_.first
+              ? &that
+              : 0;
+        }
+
+        // Writes the staged runs into that, growing its dense region once to
+        // cover them all.
+        void write_runs_(dense_array<Value, Allocator> &that) const
+        {
+            runs_type const &runs = this->runs_->get();
+            if(runs.empty())
+            {
+                return;
+            }
+
+            std::ptrdiff_t const lo = runs.front().first.first;
+            std::ptrdiff_t const hi = runs.back().first.second;
+            if(that.base().empty())
+            {
+                that.offset_ = lo;
+            }
+            else if(lo < that.offset_)
+            {
+                that.base().insert(that.base().begin(), static_cast<std::size_t>(that.offset_ - lo), that.zero_);
+                that.offset_ = lo;
+            }
+            if(hi > that.end_offset())
+            {
+                that.base().resize(hi - that.offset_, that.zero_);
+            }
+
+            typename runs_type::const_iterator begin = runs.begin(), end = runs.end();
+            for(; begin != end; ++begin)
+            {
+                std::fill(
+                    that.base().begin() + (begin->first.first - that.offset_)
+                  , that.base().begin() + (begin->first.second - that.offset_)
+                  , begin->second
+                );
+            }
+        }
+
+        typedef time_series::detail::ref_counted_object<dense_array<Value, Allocator>, Allocator> object_type;
+        typedef std::pair<std::pair<std::ptrdiff_t, std::ptrdiff_t>, Value> run_value_type;
+        typedef std::vector<
+            run_value_type
+          , typename Allocator::template rebind<run_value_type>::other
+        > runs_type;
+        typedef time_series::detail::ref_counted_object<runs_type, Allocator> runs_object_type;
+
+        dense_array<Value, Allocator> &old_;
+        intrusive_ptr<object_type> new_;
+        intrusive_ptr<object_type> tail_;
+        intrusive_ptr<runs_object_type> runs_;
+        bool append_;
     };
 
     namespace detail
@@ -103,9 +330,9 @@ namespace boost { namespace time_series { namespace storage
 
     ///////////////////////////////////////////////////////////////////////////////
     // dense_array
-    template<typename Value>
+    template<typename Value, typename Allocator>
     struct dense_array
-      : private std::vector<Value>
+      : private std::vector<Value, Allocator>
     {
         // TODO return by reference
         typedef rrs::infinite_run_value<Value> pre_type;
@@ -114,21 +341,23 @@ namespace boost { namespace time_series { namespace storage
         typedef typename pre_type::run_type pre_run_type;
         typedef typename post_type::run_type post_run_type;
 
-        typedef typename std::vector<Value>::size_type size_type;
-        typedef typename std::vector<Value>::value_type value_type;
-        typedef typename std::vector<Value>::iterator iterator;
-        typedef typename std::vector<Value>::const_iterator const_iterator;
+        typedef typename std::vector<Value, Allocator>::size_type size_type;
+        typedef typename std::vector<Value, Allocator>::value_type value_type;
+        typedef typename std::vector<Value, Allocator>::allocator_type allocator_type;
+        typedef typename std::vector<Value, Allocator>::iterator iterator;
+        typedef typename std::vector<Value, Allocator>::const_iterator const_iterator;
 
-        typedef typename std::vector<Value>::const_reference const_reference;
-        typedef typename std::vector<Value>::const_reference reference;
+        typedef typename std::vector<Value, Allocator>::const_reference const_reference;
+        typedef typename std::vector<Value, Allocator>::const_reference reference;
 
-        friend struct dense_ordered_inserter<Value>;
+        friend struct dense_ordered_inserter<Value, Allocator>;
 
         template<typename Args>
         explicit dense_array(Args const &args)
-          : std::vector<Value>(
+          : std::vector<Value, Allocator>(
                 detail::get_size(args[time_series::stop | numeric::zero<std::ptrdiff_t>()], args[time_series::start | 0])
               , args[time_series::value | args[time_series::zero | numeric::zero<Value>()]]
+              , args[time_series::allocator || detail::default_allocator<Allocator>()]
             )
           , offset_(args[time_series::start | 0])
           , zero_(implicit_cast<Value const &>(args[time_series::zero | numeric::zero<Value>()]))
@@ -139,11 +368,12 @@ namespace boost { namespace time_series { namespace storage
             this->post_.first = this->post_.second = inf;
         }
 
-        using std::vector<Value>::begin;
-        using std::vector<Value>::end;
-        using std::vector<Value>::size;
-        using std::vector<Value>::empty;
-        using std::vector<Value>::max_size;
+        using std::vector<Value, Allocator>::begin;
+        using std::vector<Value, Allocator>::end;
+        using std::vector<Value, Allocator>::size;
+        using std::vector<Value, Allocator>::empty;
+        using std::vector<Value, Allocator>::max_size;
+        using std::vector<Value, Allocator>::get_allocator;
 
         reference operator [](std::ptrdiff_t i) const
         {
@@ -168,7 +398,7 @@ namespace boost { namespace time_series { namespace storage
             return this->zero();
         }
 
-        void swap(dense_array<Value> &that)
+        void swap(dense_array<Value, Allocator> &that)
         {
             using std::swap;
             this->base().swap(that);
@@ -188,9 +418,13 @@ namespace boost { namespace time_series { namespace storage
                 std::ptrdiff_t endoff = rrs::end_offset(run) - this->offset_;
                 std::fill(this->begin() + off, this->begin() + endoff, v);
             }
+            else if(this->can_append(run))
+            {
+                this->append(run, v);
+            }
             else
             {
-                dense_ordered_inserter<Value> o(*this);
+                dense_ordered_inserter<Value, Allocator> o(*this);
                 rrs::transform(as_characteristic(run, v, z), *this, rrs::_1, rrs::_1, rrs::_1, o);
                 rrs::commit(o);
             }
@@ -224,6 +458,104 @@ namespace boost { namespace time_series { namespace storage
     private:
         friend class boost::serialization::access;
 
+        // True if run lies at or after the end of the dense region, and
+        // clear of the pre- and post-runs, so that it can be written by
+        // growing the vector in place.
+        template<typename Run>
+        bool can_append(Run &run) const
+        {
+            std::ptrdiff_t off = rrs::offset(run);
+            std::ptrdiff_t endoff = rrs::end_offset(run);
+            return off != -inf
+                && endoff != inf
+                && off >= this->end_offset()
+                && off >= this->pre_.second
+                && endoff <= this->post_.first;
+        }
+
+        template<typename Run>
+        void append(Run &run, Value const &v)
+        {
+            std::ptrdiff_t off = rrs::offset(run);
+            if(this->base().empty())
+            {
+                this->offset_ = off;
+            }
+            this->base().resize(off - this->offset_, this->zero_);
+            this->base().resize(rrs::end_offset(run) - this->offset_, v);
+        }
+
+        // Like append(), for a block of consecutive values starting at off
+        template<typename Iter>
+        void append_range(std::ptrdiff_t off, Iter begin, Iter end)
+        {
+            if(this->base().empty())
+            {
+                this->offset_ = off;
+            }
+            this->base().resize(off - this->offset_, this->zero_);
+            this->base().insert(this->base().end(), begin, end);
+        }
+
+        // Like append(), for a value at each of the ascending offsets in
+        // [begin, end), the last of which ends at endoff
+        template<typename OffsetIter, typename ValueIter>
+        void append_offsets(OffsetIter begin, OffsetIter end, ValueIter values, std::ptrdiff_t endoff)
+        {
+            if(this->base().empty())
+            {
+                this->offset_ = *begin;
+            }
+            // At least double the capacity, so that many small batches are
+            // not each copied into a buffer of exactly the right size
+            std::size_t const size = static_cast<std::size_t>(endoff - this->offset_);
+            if(size > this->base().capacity())
+            {
+                this->base().reserve((std::max)(size, 2 * this->base().capacity()));
+            }
+            for(; begin != end; ++begin, ++values)
+            {
+                this->base().resize(*begin - this->offset_, this->zero_);
+                this->base().push_back(*values);
+            }
+        }
+
+        // Appends the dense region of tail, which starts at or after the end
+        // of this one. If that throws, this array is left unchanged.
+        void splice(dense_array const &tail)
+        {
+            if(tail.base().empty())
+            {
+                return;
+            }
+
+            std::size_t const size = this->base().size();
+            std::ptrdiff_t const offset = this->offset_;
+            if(this->base().empty())
+            {
+                this->offset_ = tail.offset_;
+            }
+
+            try
+            {
+                // Grow geometrically, as append_offsets() does, so that many
+                // small appends are not each copied into an exact-size buffer
+                std::size_t const new_size = static_cast<std::size_t>(tail.end_offset() - this->offset_);
+                if(new_size > this->base().capacity())
+                {
+                    this->base().reserve((std::max)(new_size, 2 * this->base().capacity()));
+                }
+                this->base().resize(tail.offset_ - this->offset_, this->zero_);
+                this->base().insert(this->base().end(), tail.base().begin(), tail.base().end());
+            }
+            catch(...)
+            {
+                this->base().erase(this->base().begin() + size, this->base().end());
+                this->offset_ = offset;
+                throw;
+            }
+        }
+
         template<typename Archive>
         void serialize(Archive &ar, unsigned int const version)
         {
@@ -234,8 +566,8 @@ namespace boost { namespace time_series { namespace storage
             ar & this->post_;
         }
 
-        std::vector<Value> &base() { return *this; }
-        std::vector<Value> const &base() const { return *this; }
+        std::vector<Value, Allocator> &base() { return *this; }
+        std::vector<Value, Allocator> const &base() const { return *this; }
 
         std::ptrdiff_t offset_;
         Value zero_;
@@ -243,8 +575,8 @@ namespace boost { namespace time_series { namespace storage
         post_type post_;
     };
 
-    template<typename Value>
-    void swap(dense_array<Value> &left, dense_array<Value> &right)
+    template<typename Value, typename Allocator>
+    void swap(dense_array<Value, Allocator> &left, dense_array<Value, Allocator> &right)
     {
         left.swap(right);
     }
@@ -258,14 +590,14 @@ namespace boost
         struct dense_array_tag;
         struct dense_ordered_inserter_tag;
 
-        template<typename T>
-        struct tag<time_series::storage::dense_array<T> >
+        template<typename T, typename A>
+        struct tag<time_series::storage::dense_array<T, A> >
         {
             typedef dense_array_tag type;
         };
 
-        template<typename T>
-        struct tag<time_series::storage::dense_ordered_inserter<T> >
+        template<typename T, typename A>
+        struct tag<time_series::storage::dense_ordered_inserter<T, A> >
         {
             typedef dense_ordered_inserter_tag type;
         };
@@ -396,7 +728,10 @@ namespace boost
         template<typename S>
         struct ordered_inserter<S, sequence::impl::dense_array_tag>
         {
-            typedef time_series::storage::dense_ordered_inserter<typename S::value_type> result_type;
+            typedef time_series::storage::dense_ordered_inserter<
+                typename S::value_type
+              , typename S::allocator_type
+            > result_type;
 
             result_type operator ()(S &s) const
             {
@@ -414,12 +749,34 @@ namespace boost
                 return s.commit();
             }
         };
+
+        template<typename S, typename O, typename I, typename J>
+        struct set_at_range<S, O, I, J, sequence::impl::dense_ordered_inserter_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, O &offset, I &begin, J &end) const
+            {
+                s.set_at_range(offset, begin, end);
+            }
+        };
+
+        template<typename S, typename I, typename J, typename V>
+        struct set_at_offsets<S, I, J, V, sequence::impl::dense_ordered_inserter_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, I &begin, J &end, V &values) const
+            {
+                s.set_at_offsets(begin, end, values);
+            }
+        };
     }}
 
     namespace time_series { namespace traits
     {
-        template<typename Value>
-        struct storage_category<storage::dense_array<Value> >
+        template<typename Value, typename Allocator>
+        struct storage_category<storage::dense_array<Value, Allocator> >
         {
             typedef dense_storage_tag type;
         };
@@ -428,8 +785,8 @@ namespace boost
 
 namespace boost { namespace constructors { namespace impl
 {
-    template<typename Value>
-    struct tag<time_series::storage::dense_array<Value> >
+    template<typename Value, typename Allocator>
+    struct tag<time_series::storage::dense_array<Value, Allocator> >
     {
         typedef sequence::impl::dense_array_tag type;
     };
@@ -443,6 +800,7 @@ namespace boost { namespace constructors { namespace impl
           , parameter::optional<time_series::tag::stop>
           , parameter::optional<time_series::tag::value>
           , parameter::optional<time_series::tag::zero>
+          , parameter::optional<time_series::tag::allocator>
         > args_type;
     };
 
@@ -0,0 +1,286 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file compressed_stream.hpp
+/// The bit stream and the encodings of offsets and values used by
+/// compressed_sparse_array
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_STORAGE_DETAIL_COMPRESSED_STREAM_EAN_10_18_2026
+#define BOOST_TIME_SERIES_STORAGE_DETAIL_COMPRESSED_STREAM_EAN_10_18_2026
+
+#include <vector>
+#include <cstddef>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost { namespace time_series { namespace storage { namespace detail
+{
+    // The number of zero bits above the highest set bit of x
+    // \pre 0 != x
+    inline unsigned leading_zeros(boost::uint64_t x)
+    {
+        BOOST_ASSERT(0 != x);
+        unsigned n = 0;
+        if(!(x >> 32)) { n += 32; x <<= 32; }
+        if(!(x >> 48)) { n += 16; x <<= 16; }
+        if(!(x >> 56)) { n += 8; x <<= 8; }
+        if(!(x >> 60)) { n += 4; x <<= 4; }
+        if(!(x >> 62)) { n += 2; x <<= 2; }
+        if(!(x >> 63)) { n += 1; }
+        return n;
+    }
+
+    // The number of zero bits below the lowest set bit of x
+    // \pre 0 != x
+    inline unsigned trailing_zeros(boost::uint64_t x)
+    {
+        BOOST_ASSERT(0 != x);
+        unsigned n = 0;
+        if(!(x & 0xFFFFFFFFu)) { n += 32; x >>= 32; }
+        if(!(x & 0xFFFFu)) { n += 16; x >>= 16; }
+        if(!(x & 0xFFu)) { n += 8; x >>= 8; }
+        if(!(x & 0xFu)) { n += 4; x >>= 4; }
+        if(!(x & 0x3u)) { n += 2; x >>= 2; }
+        if(!(x & 0x1u)) { n += 1; }
+        return n;
+    }
+
+    // bit_writer
+    //   Appends bits to a stream of 64-bit words, highest bit first.
+    struct bit_writer
+    {
+        bit_writer(std::vector<boost::uint64_t> &words, std::size_t &size)
+          : words_(words)
+          , size_(size)
+        {}
+
+        // Appends the low n bits of bits
+        void put(boost::uint64_t bits, unsigned n)
+        {
+            BOOST_ASSERT(0 < n && n <= 64);
+            if(n < 64)
+            {
+                bits &= (boost::uint64_t(1) << n) - 1;
+            }
+
+            unsigned const used = static_cast<unsigned>(this->size_ % 64);
+            if(0 == used)
+            {
+                this->words_.push_back(0);
+            }
+
+            unsigned const free = 64 - used;
+            if(n <= free)
+            {
+                this->words_.back() |= bits << (free - n);
+            }
+            else
+            {
+                this->words_.back() |= bits >> (n - free);
+                this->words_.push_back(bits << (64 - (n - free)));
+            }
+
+            this->size_ += n;
+        }
+
+    private:
+        std::vector<boost::uint64_t> &words_;
+        std::size_t &size_;
+    };
+
+    // bit_reader
+    //   Reads back the bits appended by a bit_writer, from a bit position.
+    struct bit_reader
+    {
+        bit_reader()
+          : words_(0)
+          , position_(0)
+        {}
+
+        bit_reader(boost::uint64_t const *words, std::size_t position)
+          : words_(words)
+          , position_(position)
+        {}
+
+        boost::uint64_t get(unsigned n)
+        {
+            BOOST_ASSERT(0 < n && n <= 64);
+            boost::uint64_t const *word = this->words_ + this->position_ / 64;
+            unsigned const used = static_cast<unsigned>(this->position_ % 64);
+            unsigned const avail = 64 - used;
+            boost::uint64_t result = (word[0] << used) >> (64 - n);
+            if(n > avail)
+            {
+                result |= word[1] >> (64 - (n - avail));
+            }
+
+            this->position_ += n;
+            return result;
+        }
+
+    private:
+        boost::uint64_t const *words_;
+        std::size_t position_;
+    };
+
+    // offset_codec
+    //   Offsets are stored as the change in the distance between neighbours:
+    //   a regular tick costs 1 bit, and a jitter of a few ticks 9 to 16 bits.
+    struct offset_codec
+    {
+        offset_codec()
+          : offset_(0)
+          , delta_(0)
+        {}
+
+        explicit offset_codec(boost::int64_t offset)
+          : offset_(offset)
+          , delta_(0)
+        {}
+
+        void encode(bit_writer &out, boost::int64_t offset)
+        {
+            boost::int64_t const delta = offset - this->offset_;
+            boost::int64_t const dod = delta - this->delta_;
+            boost::uint64_t const zz = (static_cast<boost::uint64_t>(dod) << 1) ^ (dod < 0 ? ~boost::uint64_t(0) : 0);
+
+            if(0 == zz)
+            {
+                out.put(0, 1);
+            }
+            else if(zz < (1u << 7))
+            {
+                out.put(2, 2);
+                out.put(zz, 7);
+            }
+            else if(zz < (1u << 9))
+            {
+                out.put(6, 3);
+                out.put(zz, 9);
+            }
+            else if(zz < (1u << 12))
+            {
+                out.put(14, 4);
+                out.put(zz, 12);
+            }
+            else
+            {
+                out.put(15, 4);
+                out.put(zz, 64);
+            }
+
+            this->offset_ = offset;
+            this->delta_ = delta;
+        }
+
+        boost::int64_t decode(bit_reader &in)
+        {
+            static unsigned const widths[] = {0, 7, 9, 12, 64};
+            unsigned ones = 0;
+            while(ones != 4 && in.get(1))
+            {
+                ++ones;
+            }
+
+            boost::int64_t dod = 0;
+            if(0 != ones)
+            {
+                boost::uint64_t const zz = in.get(widths[ones]);
+                dod = static_cast<boost::int64_t>((zz >> 1) ^ (0 - (zz & 1)));
+            }
+
+            this->delta_ += dod;
+            this->offset_ += this->delta_;
+            return this->offset_;
+        }
+
+    private:
+        boost::int64_t offset_;
+        boost::int64_t delta_;
+    };
+
+    // value_codec
+    //   Values are stored as the XOR of their bits with those of the value
+    //   before: a repeated value costs 1 bit, and a small change only its
+    //   meaningful bits, within the window of the last change when it fits.
+    struct value_codec
+    {
+        value_codec()
+          : bits_(0)
+          , leading_(0)
+          , trailing_(0)
+          , window_(false)
+        {}
+
+        explicit value_codec(boost::uint64_t bits)
+          : bits_(bits)
+          , leading_(0)
+          , trailing_(0)
+          , window_(false)
+        {}
+
+        void encode(bit_writer &out, boost::uint64_t bits)
+        {
+            boost::uint64_t const x = bits ^ this->bits_;
+            this->bits_ = bits;
+
+            if(0 == x)
+            {
+                out.put(0, 1);
+                return;
+            }
+
+            unsigned const leading = leading_zeros(x);
+            unsigned const trailing = trailing_zeros(x);
+            if(this->window_ && leading >= this->leading_ && trailing >= this->trailing_)
+            {
+                out.put(2, 2);
+                out.put(x >> this->trailing_, 64 - this->leading_ - this->trailing_);
+            }
+            else
+            {
+                unsigned const meaningful = 64 - leading - trailing;
+                out.put(3, 2);
+                out.put(leading, 6);
+                out.put(meaningful - 1, 6);
+                out.put(x >> trailing, meaningful);
+                this->leading_ = leading;
+                this->trailing_ = trailing;
+                this->window_ = true;
+            }
+        }
+
+        boost::uint64_t decode(bit_reader &in)
+        {
+            if(in.get(1))
+            {
+                if(in.get(1))
+                {
+                    this->leading_ = static_cast<unsigned>(in.get(6));
+                    unsigned const meaningful = static_cast<unsigned>(in.get(6)) + 1;
+                    this->trailing_ = 64 - this->leading_ - meaningful;
+                }
+
+                this->bits_ ^= in.get(64 - this->leading_ - this->trailing_) << this->trailing_;
+            }
+
+            return this->bits_;
+        }
+
+        boost::uint64_t bits() const
+        {
+            return this->bits_;
+        }
+
+    private:
+        boost::uint64_t bits_;
+        unsigned leading_;
+        unsigned trailing_;
+        bool window_;
+    };
+
+}}}}
+
+#endif // BOOST_TIME_SERIES_STORAGE_DETAIL_COMPRESSED_STREAM_EAN_10_18_2026
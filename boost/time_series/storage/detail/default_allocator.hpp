@@ -0,0 +1,31 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file default_allocator.hpp
+/// A lazy default for the allocator named parameter
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_STORAGE_DETAIL_DEFAULT_ALLOCATOR_EAN_10_18_2026_HPP
+#define BOOST_TIME_SERIES_STORAGE_DETAIL_DEFAULT_ALLOCATOR_EAN_10_18_2026_HPP
+
+namespace boost { namespace time_series { namespace storage { namespace detail
+{
+    // Used as args[time_series::allocator || default_allocator<Allocator>()],
+    // so that an Allocator is only default-constructed when the allocator
+    // named parameter is missing. Allocators without a default constructor
+    // work as long as one is always passed.
+    template<typename Allocator>
+    struct default_allocator
+    {
+        typedef Allocator result_type;
+
+        Allocator operator ()() const
+        {
+            return Allocator();
+        }
+    };
+
+}}}}
+
+#endif
@@ -30,8 +30,9 @@ namespace boost { namespace time_series { namespace storage
 
         indirect_copy_and_swap_inserter(Series &series)
           : array_(series)
-          , temp_(new time_series::detail::ref_counted_object<Series>(
-                constructors::construct<Series>(
+          , temp_(time_series::detail::ref_counted_object<Series>::create(
+                std::allocator<Series>()
+              , constructors::construct<Series>(
                     time_series::zero = range_run_storage::zero(series)
                 )
             ))
@@ -0,0 +1,305 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file mapped_archive.hpp
+/// A read-only memory mapping of an archive written by
+/// \c range_run_storage::save_binary()
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_STORAGE_DETAIL_MAPPED_ARCHIVE_EAN_10_18_2026
+#define BOOST_TIME_SERIES_STORAGE_DETAIL_MAPPED_ARCHIVE_EAN_10_18_2026
+
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/range_run_storage/utility/binary_archive.hpp>
+
+namespace boost { namespace time_series { namespace storage { namespace detail
+{
+    namespace rrs = range_run_storage;
+
+    // mapped_archive
+    //   Maps a file written by save_binary() read-only, and points into it
+    //   for the zero, the pre- and post-runs, and the blocks of offsets and
+    //   values. Nothing is copied out of the mapping but the few fields of
+    //   the header, and copies of a mapped_archive share the mapping.
+    template<typename Value, typename Offset>
+    struct mapped_archive
+    {
+        BOOST_MPL_ASSERT((is_pod<Value>));
+        BOOST_MPL_ASSERT((is_pod<Offset>));
+        BOOST_MPL_ASSERT_RELATION(alignment_of<Value>::value, <=, rrs::detail::binary_archive_alignment);
+        BOOST_MPL_ASSERT_RELATION(alignment_of<Offset>::value, <=, rrs::detail::binary_archive_alignment);
+
+        // An empty archive, with no mapping
+        mapped_archive()
+          : region_()
+          , flags_(0)
+          , zero_(0)
+          , pre_run_(0)
+          , pre_value_(0)
+          , post_run_(0)
+          , post_value_(0)
+          , size_(0)
+          , starts_(0)
+          , ends_(0)
+          , values_(0)
+        {}
+
+        // Maps file. Throws interprocess_exception if the file cannot be
+        // mapped, and std::runtime_error if it does not hold an archive of a
+        // storage of Value and Offset.
+        explicit mapped_archive(std::string const &file)
+          : region_()
+          , flags_(0)
+          , zero_(0)
+          , pre_run_(0)
+          , pre_value_(0)
+          , post_run_(0)
+          , post_value_(0)
+          , size_(0)
+          , starts_(0)
+          , ends_(0)
+          , values_(0)
+        {
+            interprocess::file_mapping mapping(file.c_str(), interprocess::read_only);
+            this->region_.reset(new interprocess::mapped_region(mapping, interprocess::read_only));
+
+            char const *begin = static_cast<char const *>(this->region_->get_address());
+            char const *end = begin + this->region_->get_size();
+
+            boost::uint32_t const *magic = this->field_<boost::uint32_t>(begin, end, 1);
+            boost::uint32_t const *version = this->field_<boost::uint32_t>(begin, end, 1);
+            boost::uint8_t const *offset_size = this->field_<boost::uint8_t>(begin, end, 1);
+            boost::uint8_t const *value_size = this->field_<boost::uint8_t>(begin, end, 1);
+            this->flags_ = *this->field_<boost::uint8_t>(begin, end, 1);
+
+            if(rrs::detail::binary_archive_magic != *magic
+            || rrs::detail::binary_archive_version != *version
+            || sizeof(Offset) != *offset_size
+            || sizeof(Value) != *value_size)
+            {
+                this->fail_();
+            }
+
+            this->zero_ = this->field_<Value>(begin, end, 1);
+
+            if(this->flags_ & rrs::detail::binary_archive_pre_run)
+            {
+                this->pre_run_ = this->field_<Offset>(begin, end, 1);
+                this->field_<Offset>(begin, end, 1);
+                this->pre_value_ = this->field_<Value>(begin, end, 1);
+            }
+
+            if(this->flags_ & rrs::detail::binary_archive_post_run)
+            {
+                this->post_run_ = this->field_<Offset>(begin, end, 1);
+                this->field_<Offset>(begin, end, 1);
+                this->post_value_ = this->field_<Value>(begin, end, 1);
+            }
+
+            boost::uint64_t const size = *this->field_<boost::uint64_t>(begin, end, 1);
+            if(size > this->region_->get_size())
+            {
+                this->fail_();
+            }
+            this->size_ = static_cast<std::size_t>(size);
+
+            if(0 != this->size_)
+            {
+                if(this->contiguous())
+                {
+                    this->starts_ = this->field_<Offset>(begin, end, 1);
+                }
+                else
+                {
+                    this->starts_ = this->field_<Offset>(begin, end, this->size_);
+                    if(!this->unit_runs())
+                    {
+                        this->ends_ = this->field_<Offset>(begin, end, this->size_);
+                    }
+                }
+
+                this->values_ = this->field_<Value>(begin, end, this->size_);
+            }
+        }
+
+        // The zero, or null for an empty archive
+        Value const *zero() const
+        {
+            return this->zero_;
+        }
+
+        // The start and end of the pre-run, then its value; null if there is none
+        Offset const *pre_run() const
+        {
+            return this->pre_run_;
+        }
+
+        Value const *pre_value() const
+        {
+            return this->pre_value_;
+        }
+
+        // The start and end of the post-run, then its value; null if there is none
+        Offset const *post_run() const
+        {
+            return this->post_run_;
+        }
+
+        Value const *post_value() const
+        {
+            return this->post_value_;
+        }
+
+        // The number of runs
+        std::size_t size() const
+        {
+            return this->size_;
+        }
+
+        // Every run has length 1
+        bool unit_runs() const
+        {
+            return 0 != (this->flags_ & rrs::detail::binary_archive_unit_runs);
+        }
+
+        // The runs are unit runs, and each starts where the last ended; only
+        // the first start is stored.
+        bool contiguous() const
+        {
+            return 0 != (this->flags_ & rrs::detail::binary_archive_contiguous);
+        }
+
+        // The block of starts, or just the first start if contiguous()
+        Offset const *starts() const
+        {
+            return this->starts_;
+        }
+
+        // The block of ends, or null if unit_runs()
+        Offset const *ends() const
+        {
+            return this->ends_;
+        }
+
+        // The block of values
+        Value const *values() const
+        {
+            return this->values_;
+        }
+
+    private:
+        // Takes count objects of type T, and the padding after them, from the
+        // front of [begin, end)
+        template<typename T>
+        T const *field_(char const *&begin, char const *end, std::size_t count) const
+        {
+            std::size_t const bytes = count * sizeof(T);
+            std::size_t const padded = bytes + rrs::detail::binary_archive_padding(bytes);
+            if(static_cast<std::size_t>(end - begin) < padded)
+            {
+                this->fail_();
+            }
+
+            T const *result = reinterpret_cast<T const *>(begin);
+            begin += padded;
+            return result;
+        }
+
+        void fail_() const
+        {
+            boost::throw_exception(std::runtime_error("not a binary archive of a range-run storage of this layout"));
+        }
+
+        shared_ptr<interprocess::mapped_region> region_;
+        boost::uint8_t flags_;
+        Value const *zero_;
+        Offset const *pre_run_;
+        Value const *pre_value_;
+        Offset const *post_run_;
+        Value const *post_value_;
+        std::size_t size_;
+        Offset const *starts_;
+        Offset const *ends_;
+        Value const *values_;
+    };
+
+    // mapped_offset_iterator
+    //   Walks the starts of the unit runs of a mapped_archive. A contiguous
+    //   archive stores only the first start, so the others are counted up
+    //   from it rather than read.
+    template<typename Offset>
+    struct mapped_offset_iterator
+      : iterator_facade<
+            mapped_offset_iterator<Offset>
+          , Offset
+          , random_access_traversal_tag
+          , Offset
+        >
+    {
+        mapped_offset_iterator()
+          : starts_(0)
+          , contiguous_(false)
+          , index_(0)
+        {}
+
+        mapped_offset_iterator(Offset const *starts, bool contiguous, std::ptrdiff_t index)
+          : starts_(starts)
+          , contiguous_(contiguous)
+          , index_(index)
+        {}
+
+    private:
+        friend class boost::iterator_core_access;
+
+        Offset dereference() const
+        {
+            return this->contiguous_
+              ? static_cast<Offset>(*this->starts_ + this->index_)
+              : this->starts_[this->index_];
+        }
+
+        bool equal(mapped_offset_iterator const &that) const
+        {
+            return this->index_ == that.index_;
+        }
+
+        void increment()
+        {
+            ++this->index_;
+        }
+
+        void decrement()
+        {
+            --this->index_;
+        }
+
+        void advance(std::ptrdiff_t n)
+        {
+            this->index_ += n;
+        }
+
+        std::ptrdiff_t distance_to(mapped_offset_iterator const &that) const
+        {
+            return that.index_ - this->index_;
+        }
+
+        Offset const *starts_;
+        bool contiguous_;
+        std::ptrdiff_t index_;
+    };
+
+}}}}
+
+#endif // BOOST_TIME_SERIES_STORAGE_DETAIL_MAPPED_ARCHIVE_EAN_10_18_2026
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file sampled_index.hpp
+/// A two-level index for searching a sorted array of runs
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_STORAGE_DETAIL_SAMPLED_INDEX_EAN_10_18_2026_HPP
+#define BOOST_TIME_SERIES_STORAGE_DETAIL_SAMPLED_INDEX_EAN_10_18_2026_HPP
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+#include <boost/config.hpp>
+
+namespace boost { namespace time_series { namespace storage { namespace detail
+{
+    // The first position in [begin, end) at which before(key(*pos), x) is
+    // false, given that it holds for a prefix of the range.
+    template<typename Iter, typename KeyFn, typename Before, typename X>
+    Iter partition_point(Iter begin, Iter end, KeyFn const &key, Before const &before, X const &x)
+    {
+        std::ptrdiff_t size = end - begin;
+        while(0 < size)
+        {
+            std::ptrdiff_t half = size / 2;
+            Iter middle = begin + half;
+            if(before(key(*middle), x))
+            {
+                begin = middle + 1;
+                size -= half + 1;
+            }
+            else
+            {
+                size = half;
+            }
+        }
+        return begin;
+    }
+
+    template<typename Key>
+    struct identity_key
+    {
+        Key const &operator ()(Key const &k) const
+        {
+            return k;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // sampled_index
+    //   Every block_size-th key of a sorted array, in a small array of its own.
+    //   A search goes through the samples, which stay in cache from one lookup
+    //   to the next, and then through a single block of the full array, instead
+    //   of jumping about the whole array. The owner of the array clear()s the
+    //   samples whenever it changes the keys, and build()s them only when its
+    //   user asks for them, so a writer that never searches does not pay for
+    //   them. A search only reads them, so any number of threads may search
+    //   an array that is not being changed. Without samples, or for an
+    //   array of fewer than min_size elements, a search is a plain binary
+    //   search. The samples are allocated with a copy of alloc.
+    template<typename Key, typename Allocator = std::allocator<Key> >
+    struct sampled_index
+    {
+        BOOST_STATIC_CONSTANT(std::size_t, block_size = 32);
+        BOOST_STATIC_CONSTANT(std::size_t, min_size = 8 * block_size);
+
+        explicit sampled_index(Allocator const &alloc = Allocator())
+          : samples_(alloc)
+          , size_(0)
+        {}
+
+        template<typename Iter, typename KeyFn, typename Before, typename X>
+        Iter partition_point(Iter begin, Iter end, KeyFn const &key, Before const &before, X const &x) const
+        {
+            std::size_t const size = end - begin;
+            if(size < min_size || size != this->size_)
+            {
+                return detail::partition_point(begin, end, key, before, x);
+            }
+
+            // samples_[j] is the key of begin[j * block_size], so the answer
+            // lies after the last sample that is before x, and no later than
+            // the next one.
+            std::size_t j = detail::partition_point(
+                this->samples_.begin()
+              , this->samples_.end()
+              , identity_key<Key>()
+              , before
+              , x
+            ) - this->samples_.begin();
+
+            if(0 == j)
+            {
+                return begin;
+            }
+
+            Iter first = begin + ((j - 1) * block_size + 1);
+            Iter last = begin + (std::min)(j * block_size, size);
+            return detail::partition_point(first, last, key, before, x);
+        }
+
+        template<typename Iter, typename KeyFn>
+        void build(Iter begin, Iter end, KeyFn const &key)
+        {
+            std::size_t const size = end - begin;
+            this->clear();
+            if(size < min_size)
+            {
+                return;
+            }
+
+            this->samples_.reserve((size + block_size - 1) / block_size);
+            for(std::size_t i = 0; i < size; i += block_size)
+            {
+                this->samples_.push_back(key(begin[i]));
+            }
+            this->size_ = size;
+        }
+
+        void clear()
+        {
+            this->samples_.clear();
+            this->size_ = 0;
+        }
+
+        void swap(sampled_index &that)
+        {
+            this->samples_.swap(that.samples_);
+            std::swap(this->size_, that.size_);
+        }
+
+    private:
+        std::vector<Key, Allocator> samples_;
+        std::size_t size_; // of the array the samples were taken from
+    };
+
+}}}}
+
+#endif
@@ -0,0 +1,293 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file mapped_dense_array.hpp
+/// A read-only dense array over a memory-mapped file, that satisfies the
+/// \c InfiniteRangeRunStorage concept
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_STORAGE_MAPPED_DENSE_ARRAY_EAN_10_18_2026
+#define BOOST_TIME_SERIES_STORAGE_MAPPED_DENSE_ARRAY_EAN_10_18_2026
+
+#include <boost/time_series/time_series_fwd.hpp>
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+#include <boost/throw_exception.hpp>
+#include <boost/detail/construct.hpp>
+#include <boost/parameter/parameters.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/range_run_storage/difference1.hpp>
+#include <boost/range_run_storage/utility/infinite_run.hpp>
+#include <boost/time_series/traits/storage_category.hpp>
+#include <boost/time_series/storage/detail/offset_runs.hpp>
+#include <boost/time_series/storage/detail/mapped_archive.hpp>
+
+namespace boost { namespace time_series { namespace storage
+{
+    namespace rrs = range_run_storage;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // mapped_dense_array
+    //   The values are read in place from a file written by save_binary() from
+    //   a dense storage, mapped read-only; opening the file reads only its
+    //   header. Copies share the mapping.
+    template<typename Value>
+    struct mapped_dense_array
+    {
+        typedef rrs::infinite_run_value<Value> pre_type;
+        typedef rrs::infinite_run_value<Value> post_type;
+
+        typedef typename pre_type::run_type pre_run_type;
+        typedef typename post_type::run_type post_run_type;
+
+        typedef std::size_t size_type;
+        typedef Value value_type;
+        typedef Value const *iterator;
+        typedef Value const *const_iterator;
+
+        typedef Value const &const_reference;
+        typedef Value const &reference;
+
+        template<typename Args>
+        explicit mapped_dense_array(Args const &args)
+          : archive_()
+          , offset_(0)
+          , zero_(numeric::zero<Value>::value)
+          , pre_(numeric::zero<Value>::value)
+          , post_(numeric::zero<Value>::value)
+        {
+            this->pre_.first = this->pre_.second = -inf;
+            this->post_.first = this->post_.second = inf;
+
+            std::string const file = args[time_series::file | std::string()];
+            if(file.empty())
+            {
+                return;
+            }
+
+            this->archive_ = detail::mapped_archive<Value, std::ptrdiff_t>(file);
+            if(0 != this->archive_.size() && !this->archive_.contiguous())
+            {
+                boost::throw_exception(std::runtime_error("not a binary archive of a dense storage"));
+            }
+
+            this->zero_ = *this->archive_.zero();
+            if(0 != this->archive_.size())
+            {
+                this->offset_ = *this->archive_.starts();
+            }
+
+            if(std::ptrdiff_t const *run = this->archive_.pre_run())
+            {
+                this->pre_.first = run[0];
+                this->pre_.second = run[1];
+                this->pre_.value = *this->archive_.pre_value();
+            }
+
+            if(std::ptrdiff_t const *run = this->archive_.post_run())
+            {
+                this->post_.first = run[0];
+                this->post_.second = run[1];
+                this->post_.value = *this->archive_.post_value();
+            }
+        }
+
+        const_iterator begin() const
+        {
+            return this->archive_.values();
+        }
+
+        const_iterator end() const
+        {
+            return this->archive_.values() + this->archive_.size();
+        }
+
+        size_type size() const
+        {
+            return this->archive_.size();
+        }
+
+        bool empty() const
+        {
+            return 0 == this->archive_.size();
+        }
+
+        reference operator [](std::ptrdiff_t i) const
+        {
+            if(i < this->pre_.second)
+            {
+                return this->pre_.value;
+            }
+            else if(i >= this->post_.first)
+            {
+                return this->post_.value;
+            }
+            else
+            {
+                i -= this->offset_;
+
+                if(i >= 0 && static_cast<size_type>(i) < this->size())
+                {
+                    return this->begin()[i];
+                }
+            }
+
+            return this->zero();
+        }
+
+        std::ptrdiff_t offset() const
+        {
+            return this->offset_;
+        }
+
+        std::ptrdiff_t end_offset() const
+        {
+            return this->offset_ + this->size();
+        }
+
+        reference zero() const
+        {
+            return this->zero_;
+        }
+
+        pre_type const &pre() const { return this->pre_; }
+        post_type const &post() const { return this->post_; }
+
+    private:
+        detail::mapped_archive<Value, std::ptrdiff_t> archive_;
+        std::ptrdiff_t offset_;
+        Value zero_;
+        pre_type pre_;
+        post_type post_;
+    };
+
+}}}
+
+namespace boost
+{
+    namespace sequence { namespace impl
+    {
+        struct mapped_dense_array_tag;
+
+        template<typename T>
+        struct tag<time_series::storage::mapped_dense_array<T> >
+        {
+            typedef mapped_dense_array_tag type;
+        };
+    }}
+
+    namespace range_run_storage { namespace impl
+    {
+        template<typename S>
+        struct runs<S, sequence::impl::mapped_dense_array_tag>
+        {
+            typedef typename sequence::concepts::Sequence<S>::cursor cursor_type;
+            typedef difference1<cursor_type> difference_runs_type;
+            typedef time_series::storage::offset_runs<difference_runs_type, std::ptrdiff_t> result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return result_type(difference_runs_type(sequence::begin(s)), s.offset());
+            }
+        };
+
+        template<typename S, typename I>
+        struct get_at<S, I, sequence::impl::mapped_dense_array_tag>
+        {
+            typedef typename S::const_reference result_type;
+
+            result_type operator ()(S &s, I &i) const
+            {
+                return s[i];
+            }
+        };
+
+        template<typename S>
+        struct zero<S, sequence::impl::mapped_dense_array_tag>
+        {
+            typedef typename S::reference result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.zero();
+            }
+        };
+
+        template<typename S>
+        struct pre_run<S, sequence::impl::mapped_dense_array_tag>
+        {
+            typedef typename S::pre_run_type result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.pre();
+            }
+        };
+
+        template<typename S>
+        struct pre_value<S, sequence::impl::mapped_dense_array_tag>
+        {
+            typedef typename S::value_type const &result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.pre().value;
+            }
+        };
+
+        template<typename S>
+        struct post_run<S, sequence::impl::mapped_dense_array_tag>
+        {
+            typedef typename S::post_run_type result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.post();
+            }
+        };
+
+        template<typename S>
+        struct post_value<S, sequence::impl::mapped_dense_array_tag>
+        {
+            typedef typename S::value_type const &result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.post().value;
+            }
+        };
+    }}
+
+    namespace time_series { namespace traits
+    {
+        template<typename Value>
+        struct storage_category<storage::mapped_dense_array<Value> >
+        {
+            typedef dense_storage_tag type;
+        };
+    }}
+}
+
+namespace boost { namespace constructors { namespace impl
+{
+    template<typename Value>
+    struct tag<time_series::storage::mapped_dense_array<Value> >
+    {
+        typedef sequence::impl::mapped_dense_array_tag type;
+    };
+
+    template<typename T>
+    struct construct<T, sequence::impl::mapped_dense_array_tag>
+      : arg_pack_construct
+    {
+        typedef parameter::parameters<
+            parameter::optional<time_series::tag::file>
+        > args_type;
+    };
+
+}}}
+
+#endif // BOOST_TIME_SERIES_STORAGE_MAPPED_DENSE_ARRAY_EAN_10_18_2026
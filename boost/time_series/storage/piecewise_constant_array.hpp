@@ -11,6 +11,7 @@
 
 #include <boost/time_series/time_series_fwd.hpp>
 #include <vector>
+#include <memory>
 #include <utility> // for std::pair
 #include <boost/detail/construct.hpp>
 #include <boost/implicit_cast.hpp>
@@ -24,6 +25,8 @@
 #include <boost/time_series/utility/is_zero.hpp>
 #include <boost/range_run_storage/concepts.hpp>
 #include <boost/range_run_storage/utility/subrun.hpp>
+#include <boost/time_series/storage/detail/default_allocator.hpp>
+#include <boost/time_series/storage/detail/sampled_index.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/utility.hpp>
 
@@ -33,7 +36,7 @@ namespace boost { namespace time_series { namespace storage
 {
     namespace rrs = range_run_storage;
 
-    template<typename Value, typename Offset = std::ptrdiff_t>
+    template<typename Value, typename Offset = std::ptrdiff_t, typename Allocator = std::allocator<Value> >
     struct piecewise_constant_array;
 
     template<typename Value, typename Offset = std::ptrdiff_t>
@@ -69,6 +72,29 @@ namespace boost { namespace time_series { namespace storage
         }
     };
 
+    // piecewise_run_end
+    template<typename Offset = std::ptrdiff_t>
+    struct piecewise_run_end
+    {
+        template<typename RV>
+        Offset operator ()(RV const &rv) const
+        {
+            return rv.second;
+        }
+    };
+
+    // piecewise_end_before
+    //   True if a run that ends at end lies wholly before offset, as for
+    //   rrs::less.
+    template<typename Offset = std::ptrdiff_t>
+    struct piecewise_end_before
+    {
+        bool operator ()(Offset end, Offset offset) const
+        {
+            return is_float<Offset>::value ? end < offset : end <= offset;
+        }
+    };
+
     // piecewise_runs_map
     template<typename Offset = std::ptrdiff_t>
     struct piecewise_runs_map
@@ -120,15 +146,17 @@ namespace boost { namespace time_series { namespace storage
     };
 
     // piecewise_ordered_inserter
-    template<typename Value, typename Offset = std::ptrdiff_t>
+    //   The runs are collected in a new vector, allocated with the allocator
+    //   of the array, which replaces the runs of the array on commit().
+    template<typename Value, typename Offset = std::ptrdiff_t, typename Allocator = std::allocator<Value> >
     struct piecewise_ordered_inserter
     {
         typedef std::pair<Offset, Offset> run_type;
         typedef Value value_type;
 
-        explicit piecewise_ordered_inserter(piecewise_constant_array<Value, Offset> &array)
+        explicit piecewise_ordered_inserter(piecewise_constant_array<Value, Offset, Allocator> &array)
           : array_(array)
-          , new_runs_(new time_series::detail::ref_counted_object<runs_type>())
+          , new_runs_(object_type::create(array.get_allocator(), runs_type(array.data_.get_allocator())))
         {
             this->new_runs_->get().reserve(this->array_.data_.capacity());
         }
@@ -159,37 +187,54 @@ namespace boost { namespace time_series { namespace storage
         void commit()
         {
             this->new_runs_->get().swap(this->array_.data_);
+            this->array_.index_.clear();
         }
 
     private:
-        typedef std::vector<piecewise_run_value<Value, Offset> > runs_type;
-        piecewise_constant_array<Value, Offset> &array_;
-        intrusive_ptr<time_series::detail::ref_counted_object<runs_type> > new_runs_;
+        typedef typename piecewise_constant_array<Value, Offset, Allocator>::data_type runs_type;
+        typedef time_series::detail::ref_counted_object<runs_type, Allocator> object_type;
+
+        piecewise_constant_array<Value, Offset, Allocator> &array_;
+        intrusive_ptr<object_type> new_runs_;
     };
 
     // The piecewise_constant_array
-    template<typename Value, typename Offset>
+    //   The runs are allocated with a copy of the allocator named parameter,
+    //   rebound to piecewise_run_value.
+    template<typename Value, typename Offset, typename Allocator>
     struct piecewise_constant_array
     {
         typedef Value value_type;
         typedef Offset offset_type;
+        typedef Allocator allocator_type;
         typedef std::pair<Offset, Offset> piecewise_run;
 
-        typedef std::vector<piecewise_run_value<Value, Offset> > data_type;
+        typedef piecewise_run_value<Value, Offset> run_value_type;
+        typedef std::vector<
+            run_value_type
+          , typename Allocator::template rebind<run_value_type>::other
+        > data_type;
+        typedef typename Allocator::template rebind<Offset>::other offset_allocator_type;
         typedef typename data_type::iterator iterator;
         typedef typename data_type::const_iterator const_iterator;
 
         typedef Value const &const_reference;
         typedef const_reference reference;
 
-        friend struct piecewise_ordered_inserter<Value, Offset>;
+        friend struct piecewise_ordered_inserter<Value, Offset, Allocator>;
 
         template<typename Args>
         explicit piecewise_constant_array(Args const &args)
-          : data_()
+          : data_(typename data_type::allocator_type(args[time_series::allocator || detail::default_allocator<Allocator>()]))
           , zero_(implicit_cast<Value const &>(args[time_series::zero | numeric::zero<Value>()]))
+          , index_(offset_allocator_type(args[time_series::allocator || detail::default_allocator<Allocator>()]))
         {}
 
+        allocator_type get_allocator() const
+        {
+            return allocator_type(this->data_.get_allocator());
+        }
+
         iterator begin()
         {
             return this->data_.begin() + (this->data_.size() > 0u);
@@ -215,6 +260,7 @@ namespace boost { namespace time_series { namespace storage
             using std::swap;
             swap(this->data_, that.data_);
             swap(this->zero_, that.zero_);
+            this->index_.swap(that.index_);
         }
 
         reference operator [](Offset offset) const
@@ -222,9 +268,11 @@ namespace boost { namespace time_series { namespace storage
             piecewise_run_transform<Offset> tfx;
             rrs::unit_run<Offset> tmp(offset);
 
-            const_iterator where = piecewise_constant_array::find_element(
+            const_iterator where = this->index_.partition_point(
                 this->data_.begin()
               , this->data_.end()
+              , piecewise_run_end<Offset>()
+              , piecewise_end_before<Offset>()
               , offset
             );
 
@@ -241,6 +289,7 @@ namespace boost { namespace time_series { namespace storage
         {
             // BUGBUG this doesn't handle the case when value == 0
             piecewise_run_transform<Offset> tfx;
+            this->index_.clear();
 
             typedef typename rrs::concepts::Run<R>::offset_type that_offset_type;
             that_offset_type offset = rrs::offset(run);
@@ -249,7 +298,6 @@ namespace boost { namespace time_series { namespace storage
             rrs::unit_run<Offset> tmp(offset);
             piecewise_run_value<Value, Offset> rv(value, offset, endoff);
 
-            typedef typename std::vector<piecewise_run_value<Value, Offset> >::iterator iterator;
             iterator where = piecewise_constant_array::find_element(
                 this->data_.begin()
               , this->data_.end()
@@ -294,6 +342,14 @@ namespace boost { namespace time_series { namespace storage
             }
         }
 
+        /// Samples the ends of the runs, so that lookups go through a
+        /// two-level search until the runs next change. Any change to the
+        /// runs drops the index; without one, a lookup is a binary search.
+        void build_index()
+        {
+            this->index_.build(this->data_.begin(), this->data_.end(), piecewise_run_end<Offset>());
+        }
+
         reference zero() const
         {
             return this->zero_;
@@ -304,6 +360,8 @@ namespace boost { namespace time_series { namespace storage
             this->zero_ = z;
         }
 
+        // Only the values of the runs may be changed through this; the index
+        // is kept
         data_type &data()
         {
             return this->data_;
@@ -322,6 +380,7 @@ namespace boost { namespace time_series { namespace storage
         {
             ar & this->data_;
             ar & this->zero_;
+            this->index_.clear();
         }
 
         template<typename Iter>
@@ -338,12 +397,13 @@ namespace boost { namespace time_series { namespace storage
 
         data_type data_;
         Value zero_;
+        detail::sampled_index<Offset, offset_allocator_type> index_;
     };
 
-    template<typename Value, typename Offset>
+    template<typename Value, typename Offset, typename Allocator>
     void swap(
-        piecewise_constant_array<Value, Offset> &left
-      , piecewise_constant_array<Value, Offset> &right
+        piecewise_constant_array<Value, Offset, Allocator> &left
+      , piecewise_constant_array<Value, Offset, Allocator> &right
     )
     {
         left.swap(right);
@@ -357,14 +417,14 @@ namespace boost
         struct piecewise_constant_array_tag;
         struct piecewise_ordered_inserter_tag;
 
-        template<typename Value, typename Offset>
-        struct tag<time_series::storage::piecewise_constant_array<Value, Offset> >
+        template<typename Value, typename Offset, typename Allocator>
+        struct tag<time_series::storage::piecewise_constant_array<Value, Offset, Allocator> >
         {
             typedef piecewise_constant_array_tag type;
         };
 
-        template<typename Value, typename Offset>
-        struct tag<time_series::storage::piecewise_ordered_inserter<Value, Offset> >
+        template<typename Value, typename Offset, typename Allocator>
+        struct tag<time_series::storage::piecewise_ordered_inserter<Value, Offset, Allocator> >
         {
             typedef piecewise_ordered_inserter_tag type;
         };
@@ -521,6 +581,7 @@ namespace boost
             typedef time_series::storage::piecewise_ordered_inserter<
                 typename S::value_type
               , typename S::offset_type
+              , typename S::allocator_type
             > result_type;
 
             result_type operator ()(S &s) const
@@ -544,8 +605,8 @@ namespace boost
 
 namespace boost { namespace time_series { namespace traits
 {
-    template<typename Value, typename Offset>
-    struct storage_category<storage::piecewise_constant_array<Value, Offset> >
+    template<typename Value, typename Offset, typename Allocator>
+    struct storage_category<storage::piecewise_constant_array<Value, Offset, Allocator> >
     {
         typedef piecewise_constant_storage_tag type;
     };
@@ -553,8 +614,8 @@ namespace boost { namespace time_series { namespace traits
 
 namespace boost { namespace constructors { namespace impl
 {
-    template<typename Value, typename Offset>
-    struct tag<time_series::storage::piecewise_constant_array<Value, Offset> >
+    template<typename Value, typename Offset, typename Allocator>
+    struct tag<time_series::storage::piecewise_constant_array<Value, Offset, Allocator> >
     {
         typedef sequence::impl::piecewise_constant_array_tag type;
     };
@@ -565,6 +626,7 @@ namespace boost { namespace constructors { namespace impl
     {
         typedef parameter::parameters<
             parameter::optional<time_series::tag::zero>
+          , parameter::optional<time_series::tag::allocator>
         > args_type;
     };
 
@@ -0,0 +1,555 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file piecewise_constant_tree_array.hpp
+/// A piecewise_constant array with a balanced-tree run index that satisfies
+/// the \c InfiniteRangeRunStorage concept
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_STORAGE_PIECEWISE_CONSTANT_TREE_ARRAY_EAN_10_18_2026
+#define BOOST_TIME_SERIES_STORAGE_PIECEWISE_CONSTANT_TREE_ARRAY_EAN_10_18_2026
+
+#include <boost/time_series/time_series_fwd.hpp>
+#include <map>
+#include <utility> // for std::pair
+#include <boost/detail/construct.hpp>
+#include <boost/implicit_cast.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/parameter/parameters.hpp>
+#include <boost/numeric/functional.hpp>
+#include <boost/type_traits/is_float.hpp>
+#include <boost/time_series/detail/ref_counted_object.hpp>
+#include <boost/time_series/traits/storage_category.hpp>
+#include <boost/time_series/utility/is_zero.hpp>
+#include <boost/time_series/storage/piecewise_constant_array.hpp>
+#include <boost/range_run_storage/concepts.hpp>
+#include <boost/range_run_storage/utility/subrun.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/utility.hpp>
+
+namespace boost { namespace time_series { namespace storage
+{
+    namespace rrs = range_run_storage;
+
+    template<typename Value, typename Offset = std::ptrdiff_t>
+    struct piecewise_constant_tree_array;
+
+    // piecewise_tree_runs_map
+    template<typename Offset = std::ptrdiff_t>
+    struct piecewise_tree_runs_map
+    {
+        typedef std::pair<Offset, Offset> const &result_type;
+
+        template<typename K>
+        result_type operator ()(K const &k) const
+        {
+            return (*k).second;
+        }
+    };
+
+    template<typename Value>
+    struct msvc_result_piecewise_tree_elements_map
+    {
+        template<typename K>
+        struct result;
+
+        template<typename This, typename K>
+        struct result<This(K)>
+        {
+            typedef Value const &type;
+        };
+
+        template<typename This, typename K, typename V>
+        struct result<This(K, V)>
+        {
+            typedef void type;
+        };
+    };
+
+    // piecewise_tree_elements_map
+    template<typename Value>
+    struct piecewise_tree_elements_map
+      : msvc_result_piecewise_tree_elements_map<Value>
+    {
+        template<typename K>
+        Value const &operator ()(K const &k) const
+        {
+            return (*k).second.value;
+        }
+
+        template<typename K, typename V>
+        void operator ()(K const &k, V const &v) const
+        {
+            (*k).second.value = v;
+        }
+    };
+
+    // piecewise_tree_ordered_inserter
+    template<typename Value, typename Offset = std::ptrdiff_t>
+    struct piecewise_tree_ordered_inserter
+    {
+        typedef std::pair<Offset, Offset> run_type;
+        typedef Value value_type;
+
+        explicit piecewise_tree_ordered_inserter(piecewise_constant_tree_array<Value, Offset> &array)
+          : array_(array)
+          , new_runs_(time_series::detail::ref_counted_object<runs_type>::create(std::allocator<runs_type>()))
+        {}
+
+        template<typename R, typename V>
+        void set_at(R &run, V &value)
+        {
+            if(!time_series::detail::is_zero(this->array_, value))
+            {
+                typedef typename rrs::concepts::Run<R>::offset_type that_offset_type;
+                that_offset_type offset = rrs::offset(run);
+                that_offset_type endoff = rrs::end_offset(run);
+                BOOST_ASSERT(is_float<Offset>::value || offset < endoff);
+                runs_type &runs = this->new_runs_->get();
+                if(!runs.empty())
+                {
+                    typename runs_type::iterator back = runs.end();
+                    --back;
+                    if(offset == rrs::end_offset(back->second) && numeric::promote<bool>(value == back->second.value))
+                    {
+                        offset = back->second.first;
+                        runs.erase(back);
+                    }
+                }
+                piecewise_run_value<Value, Offset> rv(value, offset, endoff);
+                runs.insert(runs.end(), std::make_pair(key_type(endoff, offset), rv));
+            }
+        }
+
+        void commit()
+        {
+            this->new_runs_->get().swap(this->array_.data_);
+        }
+
+    private:
+        typedef typename piecewise_constant_tree_array<Value, Offset>::key_type key_type;
+        typedef typename piecewise_constant_tree_array<Value, Offset>::data_type runs_type;
+        piecewise_constant_tree_array<Value, Offset> &array_;
+        intrusive_ptr<time_series::detail::ref_counted_object<runs_type> > new_runs_;
+    };
+
+    // The piecewise_constant_tree_array
+    //   Like piecewise_constant_array, but the runs are kept in a balanced tree
+    //   keyed by their end offsets, so that set_at() at a random offset costs
+    //   O(log N) rather than shifting the tail of a vector. With floating-point
+    //   offsets a run may have zero width and end where the run before it
+    //   ends, so the key is the end and then the start of the run; the
+    //   zero-width run sorts after the wider one, as in the vector.
+    template<typename Value, typename Offset>
+    struct piecewise_constant_tree_array
+    {
+        typedef Value value_type;
+        typedef Offset offset_type;
+        typedef std::pair<Offset, Offset> piecewise_run;
+
+        typedef std::pair<Offset, Offset> key_type; // (end, start)
+        typedef std::map<key_type, piecewise_run_value<Value, Offset> > data_type;
+        typedef typename data_type::iterator iterator;
+        typedef typename data_type::const_iterator const_iterator;
+
+        typedef Value const &const_reference;
+        typedef const_reference reference;
+
+        friend struct piecewise_tree_ordered_inserter<Value, Offset>;
+
+        template<typename Args>
+        explicit piecewise_constant_tree_array(Args const &args)
+          : data_()
+          , zero_(implicit_cast<Value const &>(args[time_series::zero | numeric::zero<Value>()]))
+        {}
+
+        iterator begin()
+        {
+            return this->data_.empty() ? this->data_.begin() : ++this->data_.begin();
+        }
+
+        iterator end()
+        {
+            return this->data_.size() > 1u ? --this->data_.end() : this->data_.end();
+        }
+
+        const_iterator begin() const
+        {
+            return this->data_.empty() ? this->data_.begin() : ++this->data_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return this->data_.size() > 1u ? --this->data_.end() : this->data_.end();
+        }
+
+        void swap(piecewise_constant_tree_array &that)
+        {
+            using std::swap;
+            swap(this->data_, that.data_);
+            swap(this->zero_, that.zero_);
+        }
+
+        reference operator [](Offset offset) const
+        {
+            rrs::unit_run<Offset> tmp(offset);
+            const_iterator where = this->find_element(offset);
+
+            if(where == this->data_.end() || rrs::less(tmp, where->second))
+            {
+                return this->zero();
+            }
+
+            return where->second.value;
+        }
+
+        template<typename R>
+        void set_at(R const &run, Value const &value)
+        {
+            // BUGBUG this doesn't handle the case when value == 0
+            Offset offset = rrs::offset(run);
+            Offset endoff = rrs::end_offset(run);
+
+            // Runs that merely touch the new run at offset are left alone,
+            // so look for the first run that ends past offset.
+            iterator where = this->ends_after_(offset);
+
+            // Split off the part of a run that starts before offset, or absorb
+            // it into the new run if the values are the same.
+            if(where != this->data_.end() && where->second.first < offset)
+            {
+                if(numeric::promote<bool>(value == where->second.value))
+                {
+                    offset = where->second.first;
+                }
+                else
+                {
+                    // The tail keeps the end of the run, but its start is part
+                    // of the key, so it goes back into the tree.
+                    piecewise_run_value<Value, Offset> head(where->second.value, where->second.first, offset);
+                    piecewise_run_value<Value, Offset> tail(where->second.value, offset, where->second.second);
+                    this->data_.erase(where++);
+                    this->data_.insert(where, std::make_pair(key_type(offset, head.first), head));
+                    where = this->data_.insert(where, std::make_pair(key_type(tail.second, offset), tail));
+                }
+            }
+
+            // Erase the runs that are covered by the new run.
+            while(where != this->data_.end() && endoff >= rrs::end_offset(where->second))
+            {
+                this->data_.erase(where++);
+            }
+
+            // Trim the front of a run that overlaps the end of the new run,
+            // or absorb it if the values are the same.
+            if(where != this->data_.end() && endoff > where->second.first)
+            {
+                if(numeric::promote<bool>(value == where->second.value))
+                {
+                    endoff = where->second.second;
+                    this->data_.erase(where++);
+                }
+                else
+                {
+                    piecewise_run_value<Value, Offset> tail(where->second.value, endoff, where->second.second);
+                    this->data_.erase(where++);
+                    where = this->data_.insert(where, std::make_pair(key_type(tail.second, endoff), tail));
+                }
+            }
+
+            // A zero-width run with the same start and end may already be
+            // here; replace it.
+            piecewise_run_value<Value, Offset> rv(value, offset, endoff);
+            this->data_.insert(where, std::make_pair(key_type(endoff, offset), rv))->second = rv;
+        }
+
+        reference zero() const
+        {
+            return this->zero_;
+        }
+
+        void set_zero(reference z)
+        {
+            this->zero_ = z;
+        }
+
+        data_type &data()
+        {
+            return this->data_;
+        }
+
+        data_type const &data() const
+        {
+            return this->data_;
+        }
+
+    private:
+        friend class boost::serialization::access;
+
+        template<typename Archive>
+        void serialize(Archive &ar, unsigned int const version)
+        {
+            ar & this->data_;
+            ar & this->zero_;
+        }
+
+        // The first run that does not end before offset. Integral runs are
+        // half-open, so that is the first run whose end is past offset.
+        // Floating-point runs are closed.
+        const_iterator find_element(Offset offset) const
+        {
+            Offset const lowest = -inf;
+            return is_float<Offset>::value
+              ? this->data_.lower_bound(key_type(offset, lowest))
+              : this->ends_after_(offset);
+        }
+
+        // The first run whose end is past offset
+        iterator ends_after_(Offset offset)
+        {
+            Offset const highest = inf;
+            return this->data_.upper_bound(key_type(offset, highest));
+        }
+
+        const_iterator ends_after_(Offset offset) const
+        {
+            Offset const highest = inf;
+            return this->data_.upper_bound(key_type(offset, highest));
+        }
+
+        data_type data_;
+        Value zero_;
+    };
+
+    template<typename Value, typename Offset>
+    void swap(
+        piecewise_constant_tree_array<Value, Offset> &left
+      , piecewise_constant_tree_array<Value, Offset> &right
+    )
+    {
+        left.swap(right);
+    }
+}}}
+
+namespace boost
+{
+    namespace sequence { namespace impl
+    {
+        struct piecewise_constant_tree_array_tag;
+        struct piecewise_tree_ordered_inserter_tag;
+
+        template<typename Value, typename Offset>
+        struct tag<time_series::storage::piecewise_constant_tree_array<Value, Offset> >
+        {
+            typedef piecewise_constant_tree_array_tag type;
+        };
+
+        template<typename Value, typename Offset>
+        struct tag<time_series::storage::piecewise_tree_ordered_inserter<Value, Offset> >
+        {
+            typedef piecewise_tree_ordered_inserter_tag type;
+        };
+
+        template<typename S>
+        struct elements<S, piecewise_constant_tree_array_tag>
+        {
+            typedef time_series::storage::piecewise_tree_elements_map<
+                typename S::value_type
+            > result_type;
+
+            result_type operator ()(S &) const
+            {
+                return result_type();
+            }
+        };
+    }}
+
+    namespace range_run_storage { namespace impl
+    {
+        template<typename S>
+        struct runs<S, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef time_series::storage::piecewise_tree_runs_map<
+                typename S::offset_type
+            > result_type;
+
+            result_type operator ()(S &) const
+            {
+                return result_type();
+            }
+        };
+
+        template<typename S, typename I>
+        struct get_at<S, I, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef typename S::const_reference result_type;
+
+            result_type operator ()(S &s, I &i) const
+            {
+                return s[i];
+            }
+        };
+
+        template<typename S>
+        struct zero<S, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef typename S::reference result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.zero();
+            }
+        };
+
+        template<typename S, typename V>
+        struct set_zero<S, V, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, V &v) const
+            {
+                return s.set_zero(v);
+            }
+        };
+
+        template<typename S>
+        struct pre_run<S, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef typename S::offset_type offset_type;
+            typedef std::pair<offset_type, offset_type> result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.data().empty()
+                  ? result_type(-inf, -inf)
+                  : static_cast<result_type>(s.data().begin()->second);
+            }
+        };
+
+        template<typename S>
+        struct pre_value<S, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef typename S::const_reference result_type;
+
+            result_type operator ()(S &s) const
+            {
+                if(s.data().empty())
+                    return s.zero();
+                else
+                    return s.data().begin()->second.value;
+            }
+        };
+
+        template<typename S, typename V>
+        struct set_pre_value<S, V, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, V &v) const
+            {
+                if(!s.data().empty())
+                {
+                    s.data().begin()->second.value = v;
+                }
+            }
+        };
+
+        template<typename S>
+        struct post_run<S, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef typename S::offset_type offset_type;
+            typedef std::pair<offset_type, offset_type> result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return s.data().size() <= 1u
+                  ? result_type(inf, inf)
+                  : static_cast<result_type>(s.data().rbegin()->second);
+            }
+        };
+
+        template<typename S>
+        struct post_value<S, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef typename S::const_reference result_type;
+
+            result_type operator ()(S &s) const
+            {
+                if(s.data().size() <= 1u)
+                    return s.zero();
+                else
+                    return s.data().rbegin()->second.value;
+            }
+        };
+
+        template<typename S, typename V>
+        struct set_post_value<S, V, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, V &v) const
+            {
+                if(s.data().size() > 1u)
+                {
+                    s.data().rbegin()->second.value = v;
+                }
+            }
+        };
+
+        template<typename S>
+        struct ordered_inserter<S, sequence::impl::piecewise_constant_tree_array_tag>
+        {
+            typedef time_series::storage::piecewise_tree_ordered_inserter<
+                typename S::value_type
+              , typename S::offset_type
+            > result_type;
+
+            result_type operator ()(S &s) const
+            {
+                return result_type(s);
+            }
+        };
+
+        template<typename S>
+        struct commit<S, sequence::impl::piecewise_tree_ordered_inserter_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s) const
+            {
+                return s.commit();
+            }
+        };
+    }}
+}
+
+namespace boost { namespace time_series { namespace traits
+{
+    template<typename Value, typename Offset>
+    struct storage_category<storage::piecewise_constant_tree_array<Value, Offset> >
+    {
+        typedef piecewise_constant_tree_storage_tag type;
+    };
+}}}
+
+namespace boost { namespace constructors { namespace impl
+{
+    template<typename Value, typename Offset>
+    struct tag<time_series::storage::piecewise_constant_tree_array<Value, Offset> >
+    {
+        typedef sequence::impl::piecewise_constant_tree_array_tag type;
+    };
+
+    template<typename T>
+    struct construct<T, sequence::impl::piecewise_constant_tree_array_tag>
+      : arg_pack_construct
+    {
+        typedef parameter::parameters<
+            parameter::optional<time_series::tag::zero>
+        > args_type;
+    };
+
+}}}
+
+#endif
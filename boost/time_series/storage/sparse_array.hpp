@@ -12,17 +12,24 @@
 #include <boost/time_series/time_series_fwd.hpp>
 
 #include <vector>
+#include <memory>
+#include <iterator>
 #include <utility> // for std::pair
+#include <functional>
+#include <algorithm>
 #include <boost/detail/construct.hpp>
+#include <boost/mpl/if.hpp>
 #include <boost/mpl/assert.hpp>
 #include <boost/implicit_cast.hpp>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/parameter/parameters.hpp>
 #include <boost/numeric/functional.hpp>
+#include <boost/type_traits/is_const.hpp>
 #include <boost/type_traits/is_float.hpp>
 #include <boost/type_traits/is_integral.hpp>
-#include <boost/iterator/transform_iterator.hpp>
 #include <boost/range_run_storage/concepts.hpp>
+#include <boost/range_run_storage/set_at_range.hpp>
+#include <boost/range_run_storage/set_at_offsets.hpp>
 #include <boost/range_run_storage/algorithm/transform.hpp>
 #include <boost/range_run_storage/utility/infinite_run.hpp>
 #include <boost/time_series/detail/ref_counted_object.hpp>
@@ -31,7 +38,11 @@
 #include <boost/range_run_storage/utility/unit_run.hpp>
 #include <boost/range_run_storage/traits/is_unit_run.hpp>
 #include <boost/time_series/storage/characteristic_array.hpp>
+#include <boost/time_series/storage/detail/default_allocator.hpp>
+#include <boost/time_series/storage/detail/sampled_index.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
+#include <boost/serialization/split_member.hpp>
 
 // Define the indices property map needed to make
 // sparse_array satisfy the Array concept.
@@ -40,52 +51,31 @@ namespace boost { namespace time_series { namespace storage
     namespace rrs = range_run_storage;
     using rrs::concepts::Run;
 
-    template<typename Value, typename Offset = std::ptrdiff_t>
+    template<typename Value, typename Offset = std::ptrdiff_t, typename Allocator = std::allocator<Value> >
     struct sparse_array;
 
+    // sparse_archive_element
+    //   An element as archives of version 0 hold it: the offsets and values
+    //   of a sparse_array were written in (offset, value) pairs.
     template<typename Value, typename Offset>
-    struct sparse_run_value
-      : rrs::unit_run<Offset>
+    struct sparse_archive_element
     {
-        typedef Value value_type;
-        typedef Offset offset_type;
-
-        sparse_run_value()
-          : rrs::unit_run<Offset>(0)
-          , value()
-        {}
-
-        sparse_run_value(Value const &value_, Offset offset)
-          : rrs::unit_run<Offset>(offset)
-          , value(value_)
-        {}
-
+        rrs::unit_run<Offset> run;
         Value value;
     };
 
-    // sparse_run_transform
-    template<typename Offset>
-    struct sparse_run_transform
-    {
-        typedef rrs::unit_run<Offset> const &result_type;
-
-        template<typename RV>
-        result_type operator ()(RV const &rv) const
-        {
-            return rv;
-        }
-    };
-
     // sparse_runs_map
+    //   The cursors of a sparse_array walk its offsets, so a run is read
+    //   straight from the offset the key refers to.
     template<typename Offset>
     struct sparse_runs_map
     {
-        typedef rrs::unit_run<Offset> const &result_type;
+        typedef rrs::unit_run<Offset> result_type;
 
         template<typename K>
         result_type operator ()(K const &k) const
         {
-            return *k;
+            return result_type(*k);
         }
     };
 
@@ -98,7 +88,7 @@ namespace boost { namespace time_series { namespace storage
         template<typename This, typename K>
         struct result<This(K)>
         {
-            typedef Value const &type;
+            typedef typename std::vector<Value>::const_reference type;
         };
 
         template<typename This, typename K, typename V>
@@ -109,36 +99,58 @@ namespace boost { namespace time_series { namespace storage
     };
 
     // sparse_elements_map
-    template<typename Value>
+    //   Finds the value that goes with the offset the key refers to by its
+    //   position in the offsets array.
+    template<
+        typename Value
+      , typename Offset
+      , typename ValueIter
+      , typename OffsetIter = typename std::vector<Offset>::const_iterator
+    >
     struct sparse_elements_map
       : msvc_result_sparse_elements_map<Value>
     {
+        typedef OffsetIter offset_iterator;
+
+        sparse_elements_map(offset_iterator offsets, ValueIter values)
+          : offsets_(offsets)
+          , values_(values)
+        {}
+
         template<typename K>
-        Value const &operator ()(K const &k) const
+        typename std::vector<Value>::const_reference operator ()(K const &k) const
         {
-            return (*k).value;
+            return this->values_[k - this->offsets_];
         }
 
         template<typename K, typename V>
         void operator ()(K const &k, V const &v) const
         {
-            (*k).value = v;
+            this->values_[k - this->offsets_] = v;
         }
+
+    private:
+        offset_iterator offsets_;
+        ValueIter values_;
     };
 
     ///////////////////////////////////////////////////////////////////////////////
     // sparse_ordered_inserter
-    template<typename Value, typename Offset>
+    //   The runs are written into a new sparse_array, allocated with the
+    //   allocator of the old one, which replaces the old one on commit().
+    template<typename Value, typename Offset, typename Allocator = std::allocator<Value> >
     struct sparse_ordered_inserter
     {
         typedef Value value_type;
         typedef Offset offset_type;
 
-        explicit sparse_ordered_inserter(sparse_array<Value, Offset> &that)
+        explicit sparse_ordered_inserter(sparse_array<Value, Offset, Allocator> &that)
           : old_(that)
-          , new_(new time_series::detail::ref_counted_object<sparse_array<Value, Offset> >(
-                constructors::construct<sparse_array<Value, Offset> >(
+          , new_(object_type::create(
+                that.get_allocator()
+              , constructors::construct<sparse_array<Value, Offset, Allocator> >(
                     time_series::zero = rrs::zero(that)
+                  , time_series::allocator = that.get_allocator()
                 )
             ))
         {}
@@ -152,17 +164,49 @@ namespace boost { namespace time_series { namespace storage
             }
         }
 
+        // Consecutive values starting at off; zeros are skipped.
+        template<typename Iter>
+        void set_at_range(Offset off, Iter begin, Iter end)
+        {
+            sparse_array<Value, Offset, Allocator> &that = this->new_->get();
+            BOOST_ASSERT(off != -inf);
+            that.reserve(that.offsets_.size() + std::distance(begin, end));
+            for(; begin != end; ++begin, ++off)
+            {
+                if(!time_series::detail::is_zero(that, *begin))
+                {
+                    that.push_back(*begin, off);
+                }
+            }
+        }
+
+        // Unit runs at the ascending offsets in [begin, end), with the values
+        // in values; zeros are skipped.
+        template<typename OffsetIter, typename ValueIter>
+        void set_at_offsets(OffsetIter begin, OffsetIter end, ValueIter values)
+        {
+            sparse_array<Value, Offset, Allocator> &that = this->new_->get();
+            that.reserve(that.offsets_.size() + std::distance(begin, end));
+            for(; begin != end; ++begin, ++values)
+            {
+                if(!time_series::detail::is_zero(that, *values))
+                {
+                    BOOST_ASSERT(*begin != -inf);
+                    that.push_back(*values, *begin);
+                }
+            }
+        }
+
         void commit()
         {
-            sparse_array<Value, Offset> &that = this->new_->get();
-            that.swap(this->old_);
+            this->new_->get().swap(this->old_);
         }
 
     private:
         template<typename R, typename V>
         void set_at_(R &run, V &value, mpl::true_) // unit_runs
         {
-            sparse_array<Value, Offset> &that = this->new_->get();
+            sparse_array<Value, Offset, Allocator> &that = this->new_->get();
             typename Run<R>::offset_type off = rrs::offset(run);
             typename Run<R>::offset_type endoff = rrs::end_offset(run);
             if(off == -inf)
@@ -175,14 +219,14 @@ namespace boost { namespace time_series { namespace storage
             }
             else
             {
-                that.data_.push_back(sparse_run_value<Value, Offset>(value, off));
+                that.push_back(value, off);
             }
         }
 
         template<typename R, typename V>
         void set_at_(R &run, V &value, mpl::false_) // non-unit_runs
         {
-            sparse_array<Value, Offset> &that = this->new_->get();
+            sparse_array<Value, Offset, Allocator> &that = this->new_->get();
             typename Run<R>::offset_type off = rrs::offset(run);
             typename Run<R>::offset_type endoff = rrs::end_offset(run);
             BOOST_ASSERT(is_float<Offset>::value || off < endoff);
@@ -197,25 +241,32 @@ namespace boost { namespace time_series { namespace storage
             else
             {
                 BOOST_ASSERT(is_integral<typename Run<R>::offset_type>::value);
-                that.data_.reserve(that.data_.size() + rrs::length(run));
+                that.reserve(that.offsets_.size() + rrs::length(run));
                 do
                 {
-                    that.data_.push_back(sparse_run_value<Value, Offset>(value, off));
+                    that.push_back(value, off);
                 }
                 while(++off < endoff);
             }
         }
 
-        sparse_array<Value, Offset> &old_;
-        intrusive_ptr<time_series::detail::ref_counted_object<sparse_array<Value, Offset> > > new_;
+        typedef time_series::detail::ref_counted_object<sparse_array<Value, Offset, Allocator>, Allocator> object_type;
+
+        sparse_array<Value, Offset, Allocator> &old_;
+        intrusive_ptr<object_type> new_;
     };
 
     // The sparse_array
-    template<typename Value, typename Offset>
+    //   The offsets and values are kept in separate arrays, so a search for
+    //   an offset touches only the offsets, and a pass over the values reads
+    //   them contiguously. Both are allocated with a copy of the allocator
+    //   named parameter, rebound to Offset for the offsets.
+    template<typename Value, typename Offset, typename Allocator>
     struct sparse_array
     {
         typedef Value value_type;
         typedef Offset offset_type;
+        typedef Allocator allocator_type;
 
         // TODO return by reference
         typedef rrs::infinite_run_value<Value, Offset> pre_type;
@@ -224,18 +275,22 @@ namespace boost { namespace time_series { namespace storage
         typedef typename pre_type::run_type pre_run_type;
         typedef typename post_type::run_type post_run_type;
 
-        typedef std::vector<sparse_run_value<Value, Offset> > data_type;
-        typedef typename data_type::iterator iterator;
-        typedef typename data_type::const_iterator const_iterator;
+        typedef typename Allocator::template rebind<Offset>::other offset_allocator_type;
+        typedef std::vector<Offset, offset_allocator_type> offsets_type;
+        typedef std::vector<Value, Allocator> values_type;
+        typedef typename offsets_type::const_iterator iterator;
+        typedef typename offsets_type::const_iterator const_iterator;
 
         typedef typename time_series::detail::zero_constant<Value>::const_reference const_reference;
         typedef const_reference reference;
 
-        friend struct sparse_ordered_inserter<Value, Offset>;
+        friend struct sparse_ordered_inserter<Value, Offset, Allocator>;
 
         template<typename Args>
         explicit sparse_array(Args const &args)
-          : data_()
+          : offsets_(offset_allocator_type(args[time_series::allocator || detail::default_allocator<Allocator>()]))
+          , values_(args[time_series::allocator || detail::default_allocator<Allocator>()])
+          , index_(offset_allocator_type(args[time_series::allocator || detail::default_allocator<Allocator>()]))
           , zero_(implicit_cast<Value const &>(args[time_series::zero | numeric::zero<Value>()]))
           , pre_(args[time_series::zero | numeric::zero<Value>()])
           , post_(args[time_series::zero | numeric::zero<Value>()])
@@ -244,15 +299,22 @@ namespace boost { namespace time_series { namespace storage
             this->post_.first = this->post_.second = inf;
         }
 
-        iterator begin() { return this->data_.begin(); }
-        iterator end() { return this->data_.end(); }
-        const_iterator begin() const { return this->data_.begin(); }
-        const_iterator end() const { return this->data_.end(); }
+        const_iterator begin() const { return this->offsets_.begin(); }
+        const_iterator end() const { return this->offsets_.end(); }
+
+        allocator_type get_allocator() const { return this->values_.get_allocator(); }
+
+        // The values, in the same order as the offsets
+        typename values_type::iterator values_begin() { return this->values_.begin(); }
+        typename values_type::const_iterator values_begin() const { return this->values_.begin(); }
+        typename values_type::const_iterator values_end() const { return this->values_.end(); }
 
         void swap(sparse_array &that)
         {
             using std::swap;
-            swap(this->data_, that.data_);
+            swap(this->offsets_, that.offsets_);
+            swap(this->values_, that.values_);
+            this->index_.swap(that.index_);
             swap(this->zero_, that.zero_);
             swap(this->pre_, that.pre_);
             swap(this->post_, that.post_);
@@ -270,18 +332,17 @@ namespace boost { namespace time_series { namespace storage
             }
             else
             {
-                sparse_run_transform<offset_type> tfx;
-                rrs::unit_run<offset_type> tmp(i);
-
-                const_iterator where = sparse_array::find_element(
-                    this->data_.begin()
-                  , this->data_.end()
+                const_iterator where = this->index_.partition_point(
+                    this->offsets_.begin()
+                  , this->offsets_.end()
+                  , detail::identity_key<Offset>()
+                  , std::less<Offset>()
                   , i
                 );
 
-                if(where != this->data_.end() && !rrs::less(tmp, tfx(*where)))
+                if(where != this->offsets_.end() && !(i < *where))
                 {
-                    return where->value;
+                    return this->values_[where - this->offsets_.begin()];
                 }
             }
 
@@ -293,7 +354,7 @@ namespace boost { namespace time_series { namespace storage
         {
             // TODO: find more efficient implementation.
             Value const &v(val), &z(this->zero());
-            sparse_ordered_inserter<Value, Offset> o(*this);
+            sparse_ordered_inserter<Value, Offset, Allocator> o(*this);
             rrs::transform(as_characteristic(run, v, z), *this, rrs::_1, rrs::_1, rrs::_1, o);
             rrs::commit(o);
         }
@@ -313,38 +374,86 @@ namespace boost { namespace time_series { namespace storage
         pre_type const &pre() const { return this->pre_; }
         post_type const &post() const { return this->post_; }
 
+        /// Samples the offsets, so that lookups go through a two-level
+        /// search until the offsets next change. Any change to the offsets
+        /// drops the index; without one, a lookup is a binary search.
+        void build_index()
+        {
+            this->index_.build(this->offsets_.begin(), this->offsets_.end(), detail::identity_key<Offset>());
+        }
+
     private:
         friend class boost::serialization::access;
 
         template<typename Archive>
-        void serialize(Archive &ar, unsigned int const version)
+        void save(Archive &ar, unsigned int const version) const
         {
-            ar & this->data_;
-            ar & this->zero_;
-            ar & this->pre_;
-            ar & this->post_;
+            ar << this->offsets_;
+            ar << this->values_;
+            ar << this->zero_;
+            ar << this->pre_;
+            ar << this->post_;
         }
 
-        template<typename Iter>
-        static Iter find_element(Iter begin, Iter end, Offset offset)
-        {
-            sparse_run_transform<Offset> tfx;
-            return std::lower_bound(
-                make_transform_iterator(begin, tfx)
-              , make_transform_iterator(end, tfx)
-              , rrs::unit_run<Offset>(offset)
-              , rrs::less
-            ).base();
+        template<typename Archive>
+        void load(Archive &ar, unsigned int const version)
+        {
+            if(0 == version)
+            {
+                std::vector<sparse_archive_element<Value, Offset> > elements;
+                ar >> elements;
+                this->offsets_.clear();
+                this->values_.clear();
+                this->reserve(elements.size());
+                for(std::size_t i = 0; i != elements.size(); ++i)
+                {
+                    this->offsets_.push_back(rrs::offset(elements[i].run));
+                    this->values_.push_back(elements[i].value);
+                }
+            }
+            else
+            {
+                ar >> this->offsets_;
+                ar >> this->values_;
+            }
+            ar >> this->zero_;
+            ar >> this->pre_;
+            ar >> this->post_;
+            this->index_.clear();
         }
 
-        data_type data_;
+        BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+        // Makes room for size elements. The capacity at least doubles when it
+        // grows, so that a series filled by many small batches is not copied
+        // once per batch.
+        void reserve(std::size_t size)
+        {
+            if(size > this->offsets_.capacity())
+            {
+                size = (std::max)(size, 2 * this->offsets_.capacity());
+                this->offsets_.reserve(size);
+                this->values_.reserve(size);
+            }
+        }
+
+        void push_back(Value const &value, Offset offset)
+        {
+            this->index_.clear();
+            this->offsets_.push_back(offset);
+            this->values_.push_back(value);
+        }
+
+        offsets_type offsets_;
+        values_type values_;
+        detail::sampled_index<Offset, offset_allocator_type> index_;
         Value zero_;
         pre_type pre_;
         post_type post_;
     };
 
-    template<typename Value, typename Offset>
-    void swap(sparse_array<Value, Offset> &left, sparse_array<Value, Offset> &right)
+    template<typename Value, typename Offset, typename Allocator>
+    void swap(sparse_array<Value, Offset, Allocator> &left, sparse_array<Value, Offset, Allocator> &right)
     {
         left.swap(right);
     }
@@ -357,14 +466,14 @@ namespace boost
         struct sparse_array_tag;
         struct sparse_ordered_inserter_tag;
 
-        template<typename Value, typename Offset>
-        struct tag<time_series::storage::sparse_array<Value, Offset> >
+        template<typename Value, typename Offset, typename Allocator>
+        struct tag<time_series::storage::sparse_array<Value, Offset, Allocator> >
         {
             typedef sparse_array_tag type;
         };
 
-        template<typename Value, typename Offset>
-        struct tag<time_series::storage::sparse_ordered_inserter<Value, Offset> >
+        template<typename Value, typename Offset, typename Allocator>
+        struct tag<time_series::storage::sparse_ordered_inserter<Value, Offset, Allocator> >
         {
             typedef sparse_ordered_inserter_tag type;
         };
@@ -374,11 +483,18 @@ namespace boost
         {
             typedef time_series::storage::sparse_elements_map<
                 typename S::value_type
+              , typename S::offset_type
+              , typename mpl::if_<
+                    is_const<S>
+                  , typename S::values_type::const_iterator
+                  , typename S::values_type::iterator
+                >::type
+              , typename S::const_iterator
             > result_type;
 
-            result_type operator ()(S &) const
+            result_type operator ()(S &s) const
             {
-                return result_type();
+                return result_type(s.begin(), s.values_begin());
             }
         };
     }}
@@ -502,6 +618,7 @@ namespace boost
             typedef time_series::storage::sparse_ordered_inserter<
                 typename S::value_type
               , typename S::offset_type
+              , typename S::allocator_type
             > result_type;
 
             result_type operator ()(S &s) const
@@ -520,22 +637,64 @@ namespace boost
                 return s.commit();
             }
         };
+
+        template<typename S, typename O, typename I, typename J>
+        struct set_at_range<S, O, I, J, sequence::impl::sparse_ordered_inserter_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, O &offset, I &begin, J &end) const
+            {
+                s.set_at_range(offset, begin, end);
+            }
+        };
+
+        template<typename S, typename I, typename J, typename V>
+        struct set_at_offsets<S, I, J, V, sequence::impl::sparse_ordered_inserter_tag>
+        {
+            typedef void result_type;
+
+            void operator ()(S &s, I &begin, J &end, V &values) const
+            {
+                s.set_at_offsets(begin, end, values);
+            }
+        };
     }}
 }
 
 namespace boost { namespace time_series { namespace traits
 {
-    template<typename Value, typename Offset>
-    struct storage_category<storage::sparse_array<Value, Offset> >
+    template<typename Value, typename Offset, typename Allocator>
+    struct storage_category<storage::sparse_array<Value, Offset, Allocator> >
     {
         typedef sparse_storage_tag type;
     };
 }}}
 
+namespace boost { namespace serialization
+{
+    // Version 1 writes the offsets and then the values of a sparse_array;
+    // version 0 wrote them in pairs.
+    template<typename Value, typename Offset, typename Allocator>
+    struct version<time_series::storage::sparse_array<Value, Offset, Allocator> >
+    {
+        typedef mpl::int_<1> type;
+        typedef mpl::integral_c_tag tag;
+        BOOST_STATIC_CONSTANT(int, value = type::value);
+    };
+
+    template<typename Archive, typename Value, typename Offset>
+    void serialize(Archive &ar, time_series::storage::sparse_archive_element<Value, Offset> &element, unsigned int const version)
+    {
+        ar & element.run;
+        ar & element.value;
+    }
+}}
+
 namespace boost { namespace constructors { namespace impl
 {
-    template<typename Value, typename Offset>
-    struct tag<time_series::storage::sparse_array<Value, Offset> >
+    template<typename Value, typename Offset, typename Allocator>
+    struct tag<time_series::storage::sparse_array<Value, Offset, Allocator> >
     {
         typedef sequence::impl::sparse_array_tag type;
     };
@@ -546,19 +705,10 @@ namespace boost { namespace constructors { namespace impl
     {
         typedef parameter::parameters<
             parameter::optional<time_series::tag::zero>
+          , parameter::optional<time_series::tag::allocator>
         > args_type;
     };
 
 }}}
 
-namespace boost { namespace serialization
-{
-    template<typename Archive, typename Value, typename Offset>
-    void serialize(Archive &ar, time_series::storage::sparse_run_value<Value, Offset> & rv, unsigned int const version)
-    {
-        ar & static_cast<range_run_storage::unit_run<Offset> &>(rv);
-        ar & rv.value;
-    }
-}}
-
 #endif
@@ -17,6 +17,7 @@
 # define BOOST_PARAMETER_MAX_ARITY 7
 #endif
 
+#include <memory>
 #include <boost/mpl/int.hpp>
 #include <boost/mpl/integral_c.hpp>
 #include <boost/integer_traits.hpp>
@@ -48,11 +49,15 @@ namespace boost { namespace time_series
     BOOST_TIME_SERIES_KEYWORD(tag, value)
     BOOST_TIME_SERIES_KEYWORD(tag, start)
     BOOST_TIME_SERIES_KEYWORD(tag, stop)
+    BOOST_TIME_SERIES_KEYWORD(tag, file)
+    BOOST_TIME_SERIES_KEYWORD(tag, allocator)
 
     // storage tags
     struct piecewise_constant_storage_tag {};
+    struct piecewise_constant_tree_storage_tag {};
     struct dense_storage_tag {};
     struct sparse_storage_tag {};
+    struct compressed_sparse_storage_tag {};
     struct characteristic_storage_tag {};
     struct delta_storage_tag {};
     struct constant_storage_tag {};
@@ -95,11 +100,20 @@ namespace boost { namespace time_series
         template<typename T>
         struct storage_category;
 
-        template<typename Tag, typename Value, typename Discretization, typename Offset>
+        template<
+            typename Tag
+          , typename Value
+          , typename Discretization
+          , typename Offset
+          , typename Allocator = std::allocator<Value>
+        >
         struct generate_series;
 
         template<typename S>
         struct discretization_type;
+
+        template<typename S>
+        struct allocator_type;
     }
 
     struct any {}; // for use as the discretization template parameter
@@ -122,7 +136,7 @@ namespace boost { namespace time_series
     struct time_series_facade;
 
     // End-user
-    template<typename Value, typename Discretization = int>
+    template<typename Value, typename Discretization = int, typename Allocator = std::allocator<Value> >
     struct dense_series;
 
     template<typename Value, typename Discretization = int, typename Offset = std::ptrdiff_t>
@@ -131,6 +145,9 @@ namespace boost { namespace time_series
     template<typename Value, typename Discretization = int, typename Offset = std::ptrdiff_t>
     struct characteristic_unit_series;
 
+    template<typename Value, typename Discretization = int, typename Offset = std::ptrdiff_t>
+    struct compressed_sparse_series;
+
     template<typename Value, typename Discretization = int, typename Offset = std::ptrdiff_t>
     struct constant_series;
 
@@ -152,10 +169,29 @@ namespace boost { namespace time_series
     template<typename Value, typename Discretization = int, typename Offset = std::ptrdiff_t>
     struct inverse_heaviside_unit_series;
 
+    template<typename Value, typename Discretization = int>
+    struct mapped_dense_series;
+
     template<typename Value, typename Discretization = int, typename Offset = std::ptrdiff_t>
+    struct mapped_sparse_series;
+
+    template<
+        typename Value
+      , typename Discretization = int
+      , typename Offset = std::ptrdiff_t
+      , typename Allocator = std::allocator<Value>
+    >
     struct piecewise_constant_series;
 
     template<typename Value, typename Discretization = int, typename Offset = std::ptrdiff_t>
+    struct piecewise_constant_tree_series;
+
+    template<
+        typename Value
+      , typename Discretization = int
+      , typename Offset = std::ptrdiff_t
+      , typename Allocator = std::allocator<Value>
+    >
     struct sparse_series;
 
     //
@@ -170,6 +206,9 @@ namespace boost { namespace time_series
     template<typename Series, typename Factor>
     struct scaled_series;
 
+    template<typename Expr>
+    struct lazy_series;
+
     //
     // ordered inserter:
     //
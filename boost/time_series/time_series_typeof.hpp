@@ -19,10 +19,14 @@ BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::tag::stop)
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::tag::value)
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::tag::discretization)
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::tag::zero)
+BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::tag::file)
+BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::tag::allocator)
 
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::piecewise_constant_storage_tag)
+BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::piecewise_constant_tree_storage_tag)
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::dense_storage_tag)
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::sparse_storage_tag)
+BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::compressed_sparse_storage_tag)
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::characteristic_storage_tag)
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::delta_storage_tag)
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::constant_storage_tag)
@@ -40,8 +44,9 @@ BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::unit)
 
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::traits::is_time_series, (typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::traits::storage_category, (typename))
-BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::traits::generate_series, (typename)(typename)(typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::traits::generate_series, (typename)(typename)(typename)(typename)(typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::traits::discretization_type, (typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::traits::allocator_type, (typename))
 
 BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::any)
 
@@ -49,9 +54,10 @@ BOOST_TYPEOF_REGISTER_TYPE(boost::time_series::time_series_root)
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::time_series_base, (typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::time_series_facade, (typename)(typename)(typename))
 
-BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::dense_series, (typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::dense_series, (typename)(typename)(typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::characteristic_series, (typename)(typename)(typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::characteristic_unit_series, (typename)(typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::compressed_sparse_series, (typename)(typename)(typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::constant_series, (typename)(typename)(typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::delta_series, (typename)(typename)(typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::delta_unit_series, (typename)(typename)(typename))
@@ -59,12 +65,16 @@ BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::heaviside_series, (typename)(
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::heaviside_unit_series, (typename)(typename)(typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::inverse_heaviside_series, (typename)(typename)(typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::inverse_heaviside_unit_series, (typename)(typename)(typename))
-BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::piecewise_constant_series, (typename)(typename)(typename))
-BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::sparse_series, (typename)(typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::mapped_dense_series, (typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::mapped_sparse_series, (typename)(typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::piecewise_constant_series, (typename)(typename)(typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::piecewise_constant_tree_series, (typename)(typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::sparse_series, (typename)(typename)(typename)(typename))
 
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::clipped_series, (typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::shifted_series, (typename))
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::scaled_series, (typename)(typename))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::lazy_series, (typename))
 
 BOOST_TYPEOF_REGISTER_TEMPLATE(boost::time_series::ordered_inserter, (typename))
 
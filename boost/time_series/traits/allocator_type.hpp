@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file allocator_type.hpp
+/// Given a series, return the type of the allocator of its storage, or void
+/// if its storage does not allocate
+//
+//  Copyright 2006 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TIME_SERIES_TRAITS_ALLOCATOR_TYPE_HPP_EAN_10_18_2026
+#define BOOST_TIME_SERIES_TRAITS_ALLOCATOR_TYPE_HPP_EAN_10_18_2026
+
+namespace boost { namespace time_series { namespace traits
+{
+
+    template<typename S>
+    struct allocator_type
+    {
+        typedef void type;
+    };
+
+    template<typename S>
+    struct allocator_type<S const>
+      : allocator_type<S>
+    {};
+
+    template<typename S>
+    struct allocator_type<S volatile>
+      : allocator_type<S>
+    {};
+
+    template<typename S>
+    struct allocator_type<S volatile const>
+      : allocator_type<S>
+    {};
+
+}}}
+
+#endif
@@ -33,12 +33,18 @@ namespace boost { namespace time_series { namespace traits
     template<typename From>
     struct is_storage_convertible<From, sparse_storage_tag> : mpl::true_ {};
 
+    template<typename From>
+    struct is_storage_convertible<From, compressed_sparse_storage_tag> : mpl::true_ {};
+
     template<typename From>
     struct is_storage_convertible<From, dense_storage_tag> : mpl::true_ {};
 
     template<typename From>
     struct is_storage_convertible<From, piecewise_constant_storage_tag> : mpl::true_ {};
 
+    template<typename From>
+    struct is_storage_convertible<From, piecewise_constant_tree_storage_tag> : mpl::true_ {};
+
     template<>
     struct is_storage_convertible<delta_storage_tag, characteristic_storage_tag> : mpl::true_ {};
 
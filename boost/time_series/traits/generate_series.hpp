@@ -10,13 +10,16 @@
 #ifndef BOOST_TIME_SERIES_TRAITS_GENERATE_SERIES_HPP_EAN_06_07_2006
 #define BOOST_TIME_SERIES_TRAITS_GENERATE_SERIES_HPP_EAN_06_07_2006
 
+#include <boost/time_series/time_series_fwd.hpp>
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/assert.hpp>
 
 namespace boost { namespace time_series { namespace traits
 {
 
-    template<typename Tag, typename Value, typename Discretization, typename Offset>
+    /// The allocator is used by series whose storage allocates, and is
+    /// ignored by the others.
+    template<typename Tag, typename Value, typename Discretization, typename Offset, typename Allocator>
     struct generate_series
     {
         BOOST_MPL_ASSERT_MSG(false, SERIES_NOT_REGISTERED_YOU_FORGOT_TO_INCLUDE_THE_SERIES_HEADER, (Tag));
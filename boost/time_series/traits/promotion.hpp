@@ -38,7 +38,10 @@ namespace boost { namespace time_series { namespace traits
 
     template<typename Tag>
     struct is_piecewise_constant
-      : is_same<Tag, piecewise_constant_storage_tag>
+      : mpl::or_<
+            is_same<Tag, piecewise_constant_storage_tag>
+          , is_same<Tag, piecewise_constant_tree_storage_tag>
+        >
     {};
 
     template<typename Tag>
@@ -58,7 +61,11 @@ namespace boost { namespace time_series { namespace traits
 
     template<typename Tag>
     struct is_sparse
-      : mpl::or_<is_same<Tag, sparse_storage_tag>, is_same<Tag, delta_storage_tag> >
+      : mpl::or_<
+            is_same<Tag, sparse_storage_tag>
+          , is_same<Tag, compressed_sparse_storage_tag>
+          , is_same<Tag, delta_storage_tag>
+        >
     {};
 
     template<typename Tag>
@@ -69,7 +76,7 @@ namespace boost { namespace time_series { namespace traits
     // 1) Adding anything to a dense array gives a dense array
     // 2) Adding two of (piecewise_constant, heaviside, inverse heaviside,
     //      characteristic or constant) yields a piecewise_constant.
-    // 3) Adding two of (sparse or delta) yields a sparse array
+    // 3) Adding two of (sparse, compressed sparse or delta) yields a sparse array
     template<typename Left, typename Right>
     struct plus
       : mpl::eval_if<
@@ -219,7 +226,7 @@ namespace boost { namespace time_series { namespace traits
       : mpl::or_<
             is_same<Divisor, dense_storage_tag>
           , is_same<Divisor, constant_storage_tag>
-          , is_same<Divisor, piecewise_constant_storage_tag>
+          , is_piecewise_constant<Divisor>
         >
     {};
 
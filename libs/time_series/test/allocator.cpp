@@ -0,0 +1,284 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <memory>
+#include <cstddef>
+#include <boost/mpl/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/numeric/numeric.hpp>
+#include <boost/time_series/numeric/partial_sum.hpp>
+#include <boost/time_series/numeric/invert_elements.hpp>
+#include <boost/time_series/numeric/adjacent_difference.hpp>
+#include <boost/time_series/numeric/compact.hpp>
+#include <boost/time_series/numeric/coarse_grain.hpp>
+#include <boost/time_series/numeric/fine_grain.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+
+using namespace boost;
+using namespace unit_test;
+using namespace time_series;
+
+///////////////////////////////////////////////////////////////////////////////
+// counting_allocator
+//   Adds the number of bytes it allocates to a counter it shares with its
+//   copies.
+template<typename T>
+struct counting_allocator
+  : std::allocator<T>
+{
+    template<typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    explicit counting_allocator(std::size_t *count = 0)
+      : count_(count)
+    {}
+
+    template<typename U>
+    counting_allocator(counting_allocator<U> const &that)
+      : count_(that.count_)
+    {}
+
+    T *allocate(std::size_t n, void const * = 0)
+    {
+        if(this->count_)
+        {
+            *this->count_ += n * sizeof(T);
+        }
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n)
+    {
+        std::allocator<T>::deallocate(p, n);
+    }
+
+    std::size_t *count_;
+};
+
+template<typename T, typename U>
+bool operator ==(counting_allocator<T> const &left, counting_allocator<U> const &right)
+{
+    return left.count_ == right.count_;
+}
+
+template<typename T, typename U>
+bool operator !=(counting_allocator<T> const &left, counting_allocator<U> const &right)
+{
+    return left.count_ != right.count_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// arena_allocator
+//   A counting_allocator that cannot be default-constructed, so series that
+//   use it must always be given one.
+template<typename T>
+struct arena_allocator
+  : counting_allocator<T>
+{
+    template<typename U>
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    explicit arena_allocator(std::size_t *count)
+      : counting_allocator<T>(count)
+    {}
+
+    template<typename U>
+    arena_allocator(arena_allocator<U> const &that)
+      : counting_allocator<T>(that)
+    {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// test_dense_allocator
+//
+void test_dense_allocator()
+{
+    typedef dense_series<double, int, counting_allocator<double> > series_type;
+
+    std::size_t count = 0;
+    series_type d(start = 0, stop = 100, allocator = counting_allocator<double>(&count));
+    BOOST_CHECK(count >= 100 * sizeof(double));
+
+    // the inserter's copy and its reference count come from the same allocator
+    std::size_t const before = count;
+    make_ordered_inserter(d)(1., 0)(2., 1)(3., 5, 8).commit();
+    BOOST_CHECK(count > before);
+    BOOST_CHECK_EQUAL(2., d[1]);
+    BOOST_CHECK_EQUAL(3., d[7]);
+    BOOST_CHECK_EQUAL(0., d[8]);
+
+    std::size_t const appended = count;
+    make_append_inserter(d)(4., 8, 100).commit();
+    BOOST_CHECK(count > appended);
+    BOOST_CHECK_EQUAL(4., d[8]);
+
+    // the sum of series with the same allocator has that allocator
+    BOOST_MPL_ASSERT((is_same<series_type, BOOST_TYPEOF(d + d)>));
+    std::size_t const summed = count;
+    series_type twice = d + d;
+    BOOST_CHECK_EQUAL(6., twice[7]);
+    BOOST_CHECK(count > summed);
+    BOOST_CHECK(twice.get_allocator() == d.get_allocator());
+
+    twice *= d;
+    BOOST_CHECK_EQUAL(18., twice[7]);
+    BOOST_CHECK(twice.get_allocator() == d.get_allocator());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_sparse_allocator
+//
+void test_sparse_allocator()
+{
+    typedef sparse_series<int, int, std::ptrdiff_t, counting_allocator<int> > series_type;
+
+    std::size_t count = 0;
+    series_type s(zero = -1, allocator = counting_allocator<int>(&count));
+    make_ordered_inserter(s)(1, 0)(2, 3)(3, 10).commit();
+    BOOST_CHECK(count >= 3 * (sizeof(int) + sizeof(std::ptrdiff_t)));
+    BOOST_CHECK_EQUAL(2, s[3]);
+    BOOST_CHECK_EQUAL(-1, s[4]);
+    BOOST_CHECK_EQUAL(3, s[10]);
+
+    // sparse plus dense is dense, with the allocator of the left operand
+    typedef dense_series<int, int, counting_allocator<int> > dense_type;
+    dense_series<int> d(start = 0, stop = 2, value = 5);
+    BOOST_MPL_ASSERT((is_same<dense_type, BOOST_TYPEOF(s + d)>));
+    dense_type sum = s + d;
+    BOOST_CHECK_EQUAL(6, sum[0]);
+    BOOST_CHECK_EQUAL(2, sum[3]);
+    BOOST_CHECK(sum.get_allocator() == s.get_allocator());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_piecewise_allocator
+//
+void test_piecewise_allocator()
+{
+    typedef piecewise_constant_series<int, int, std::ptrdiff_t, counting_allocator<int> > series_type;
+
+    std::size_t count = 0;
+    series_type p(discretization = 1, allocator = counting_allocator<int>(&count));
+    make_ordered_inserter(p)(1, 0, 10)(2, 10, 20).commit();
+    BOOST_CHECK(count > 0);
+    BOOST_CHECK_EQUAL(1, p[9]);
+    BOOST_CHECK_EQUAL(2, p[10]);
+    BOOST_CHECK_EQUAL(0, p[20]);
+
+    std::size_t const before = count;
+    make_ordered_inserter(p)(1, 0, 5)(7, 5, 15)(2, 15, 20).commit();
+    BOOST_CHECK(count > before);
+    BOOST_CHECK_EQUAL(1, p[4]);
+    BOOST_CHECK_EQUAL(7, p[14]);
+    BOOST_CHECK_EQUAL(2, p[15]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_algorithm_allocator
+//   The series that algorithms return are allocated like their input.
+void test_algorithm_allocator()
+{
+    typedef sparse_series<int, int, std::ptrdiff_t, counting_allocator<int> > series_type;
+
+    std::size_t count = 0;
+    series_type s(allocator = counting_allocator<int>(&count));
+    make_ordered_inserter(s)(1, 0)(2, 3)(3, 10).commit();
+
+    std::size_t const before = count;
+    piecewise_constant_series<int, int, std::ptrdiff_t, counting_allocator<int> > sums = partial_sum(s);
+    BOOST_CHECK(count > before);
+    BOOST_CHECK(sums.get_allocator() == s.get_allocator());
+    BOOST_CHECK_EQUAL(3, sums[3]);
+    BOOST_CHECK_EQUAL(6, sums[10]);
+
+    series_type diffs = adjacent_difference(s);
+    BOOST_CHECK(diffs.get_allocator() == s.get_allocator());
+    BOOST_CHECK_EQUAL(-2, diffs[4]);
+
+    series_type inverted = invert_elements(s);
+    BOOST_CHECK(inverted.get_allocator() == s.get_allocator());
+
+    piecewise_constant_series<int, int, std::ptrdiff_t, counting_allocator<int> > compacted = compact(s);
+    BOOST_CHECK(compacted.get_allocator() == s.get_allocator());
+    BOOST_CHECK_EQUAL(2, compacted[3]);
+
+    series_type coarse_sums = coarse_grain(s, 5, sum_downsample);
+    BOOST_CHECK(coarse_sums.get_allocator() == s.get_allocator());
+    BOOST_CHECK_EQUAL(3, coarse_sums[0]);
+    BOOST_CHECK_EQUAL(3, coarse_sums[2]);
+
+    sparse_series<double, int, std::ptrdiff_t, counting_allocator<double> > coarse_means = coarse_grain(s, 5, mean_downsample);
+    BOOST_CHECK(coarse_means.get_allocator() == s.get_allocator());
+    BOOST_CHECK_EQUAL(1.5, coarse_means[0]);
+
+    series_type coarse(discretization = 5, allocator = s.get_allocator());
+    make_ordered_inserter(coarse)(1, 0)(2, 1).commit();
+
+    series_type fine_sparse = fine_grain(coarse, 1, sparse_upsample);
+    BOOST_CHECK(fine_sparse.get_allocator() == s.get_allocator());
+    BOOST_CHECK_EQUAL(2, fine_sparse[5]);
+
+    std::size_t const upsampled = count;
+    piecewise_constant_series<int, int, std::ptrdiff_t, counting_allocator<int> > fine = fine_grain(coarse, 1);
+    BOOST_CHECK(count > upsampled);
+    BOOST_CHECK(fine.get_allocator() == s.get_allocator());
+    BOOST_CHECK_EQUAL(2, fine[9]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_no_default_allocator
+//   An allocator without a default constructor works as long as it is always
+//   passed in, and is carried over to the results of operations.
+void test_no_default_allocator()
+{
+    std::size_t count = 0;
+    arena_allocator<double> arena(&count);
+
+    dense_series<double, int, arena_allocator<double> > d(start = 0, stop = 10, value = 1., allocator = arena);
+    make_ordered_inserter(d)(2., 0, 5)(3., 5, 10).commit();
+    BOOST_CHECK_EQUAL(6., (d + d)[5]);
+    BOOST_CHECK((d + d).get_allocator() == arena);
+
+    sparse_series<double, int, std::ptrdiff_t, arena_allocator<double> > s(allocator = arena);
+    make_ordered_inserter(s)(1., 0)(2., 3).commit();
+    BOOST_CHECK_EQUAL(3., (s + d)[0]);
+    BOOST_CHECK_EQUAL(2., partial_sum(s)[0] + 1.);
+    BOOST_CHECK(partial_sum(s).get_allocator() == arena);
+    BOOST_CHECK(compact(s).get_allocator() == arena);
+    BOOST_CHECK(coarse_grain(d, 5, max_downsample).get_allocator() == arena);
+    BOOST_CHECK_EQUAL(3., coarse_grain(d, 5, max_downsample)[1]);
+
+    piecewise_constant_series<double, int, std::ptrdiff_t, arena_allocator<double> > p(allocator = arena);
+    make_ordered_inserter(p)(1., 0, 10).commit();
+    BOOST_CHECK_EQUAL(1., (p * p)[9]);
+
+    BOOST_CHECK(count > 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("allocator test");
+
+    test->add(BOOST_TEST_CASE(&test_dense_allocator));
+    test->add(BOOST_TEST_CASE(&test_sparse_allocator));
+    test->add(BOOST_TEST_CASE(&test_piecewise_allocator));
+    test->add(BOOST_TEST_CASE(&test_algorithm_allocator));
+    test->add(BOOST_TEST_CASE(&test_no_default_allocator));
+
+    return test;
+}
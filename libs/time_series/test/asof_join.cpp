@@ -0,0 +1,82 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/asof_join.hpp>
+
+using namespace boost;
+using namespace unit_test;
+using namespace time_series;
+
+///////////////////////////////////////////////////////////////////////////////
+// test_asof_join
+//
+void test_asof_join()
+{
+    // trades
+    sparse_series<int> trades;
+    make_ordered_inserter(trades)
+        (1, 0)(1, 3)(1, 4)(1, 9)(1, 15)(1, 30)
+    .commit();
+
+    // quotes
+    sparse_series<double> quotes;
+    make_ordered_inserter(quotes)
+        (10.5, 2)(10.75, 4)(11., 8)
+    .commit();
+
+    sparse_series<double> joined = asof_join(trades, quotes);
+    sparse_series<double> expected;
+    make_ordered_inserter(expected)
+        (10.5, 3)(10.75, 4)(11., 9)(11., 15)(11., 30)
+    .commit();
+    BOOST_CHECK_EQUAL(expected, joined);
+
+    // quotes last seen more than 2 offsets ago are stale
+    sparse_series<double> fresh = asof_join(trades, quotes, 2);
+    sparse_series<double> expected_fresh;
+    make_ordered_inserter(expected_fresh)
+        (10.5, 3)(10.75, 4)(11., 9)
+    .commit();
+    BOOST_CHECK_EQUAL(expected_fresh, fresh);
+
+    // a piecewise constant series is current throughout each run, and
+    // holds its last value through the gaps
+    piecewise_constant_series<int> levels;
+    make_ordered_inserter(levels)
+        (5, 1, 4)
+        (7, 10, 20)
+        (9, 20, inf)
+    .commit();
+
+    sparse_series<int> sampled = asof_join(trades, levels);
+    sparse_series<int> expected_levels;
+    make_ordered_inserter(expected_levels)
+        (5, 3)(5, 4)(5, 9)(7, 15)(9, 30)
+    .commit();
+    BOOST_CHECK_EQUAL(expected_levels, sampled);
+
+    sparse_series<int> sampled_fresh = asof_join(trades, levels, 1);
+    sparse_series<int> expected_levels_fresh;
+    make_ordered_inserter(expected_levels_fresh)
+        (5, 3)(5, 4)(7, 15)(9, 30)
+    .commit();
+    BOOST_CHECK_EQUAL(expected_levels_fresh, sampled_fresh);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("asof_join test");
+
+    test->add(BOOST_TEST_CASE(&test_asof_join));
+
+    return test;
+}
@@ -0,0 +1,157 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <sstream>
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/characteristic_series.hpp>
+#include <boost/range_run_storage/utility/binary_archive.hpp>
+
+using namespace boost;
+using namespace unit_test;
+
+template<typename Series>
+void check_round_trip(Series const &expected)
+{
+    namespace rrs = range_run_storage;
+
+    std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+    rrs::save_binary(ss, expected);
+
+    Series result;
+    BOOST_CHECK(rrs::load_binary(ss, result));
+    BOOST_CHECK_EQUAL(expected, result);
+    BOOST_CHECK_EQUAL(rrs::zero(expected), rrs::zero(result));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_binary_archive
+//
+void test_binary_archive()
+{
+    namespace rrs = range_run_storage;
+    using namespace time_series;
+
+    dense_series<double> d(start = -5, stop = 1000);
+    for(int i = -5; i < 1000; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), i / 7.);
+    check_round_trip(d);
+
+    sparse_series<int> s(zero = -1);
+    make_ordered_inserter(s)(5, 0)(1, 3)(4, 7)(2, 8)(3, 20).commit();
+    check_round_trip(s);
+
+    piecewise_constant_series<int> p;
+    make_ordered_inserter(p)
+        (1, -inf, -10)
+        (7, 0, 10)
+        (3, 10, 100)
+        (9, 200, inf)
+    .commit();
+    check_round_trip(p);
+
+    check_round_trip(sparse_series<int>());
+
+    // with floating-point offsets, the runs of a sparse series are points
+    sparse_series<int, int, double> fs;
+    make_ordered_inserter(fs)(5, .5)(1, 1.5)(4, 1.75)(2, 3.).commit();
+    check_round_trip(fs);
+    {
+        std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+        rrs::save_binary(ss, fs);
+        std::string const archive = ss.str();
+
+        // the flags follow the padded magic number, version and sizes
+        BOOST_CHECK(archive[32] & rrs::detail::binary_archive_unit_runs);
+        BOOST_CHECK(!(archive[32] & rrs::detail::binary_archive_contiguous));
+    }
+    check_round_trip(characteristic_series<int>(-10, 10, 2));
+
+    // Not an archive, or one of a different layout
+    {
+        std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+        ss << "not an archive";
+        sparse_series<int> result;
+        make_ordered_inserter(result)(1, 1).commit();
+        BOOST_CHECK(!rrs::load_binary(ss, result));
+        BOOST_CHECK(ss.fail());
+        BOOST_CHECK_EQUAL(1, result[1]);
+    }
+
+    {
+        std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+        rrs::save_binary(ss, d);
+        sparse_series<int> result;
+        BOOST_CHECK(!rrs::load_binary(ss, result));
+    }
+
+    // Cut short
+    {
+        std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+        rrs::save_binary(ss, s);
+        std::string const archive = ss.str();
+        std::stringstream cut(archive.substr(0, archive.size() - 1), std::ios::in | std::ios::binary);
+        sparse_series<int> result;
+        BOOST_CHECK(!rrs::load_binary(cut, result));
+    }
+
+    // Offsets out of order
+    {
+        std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+        rrs::save_binary(ss, s);
+        std::string archive = ss.str();
+
+        // the 5 starts come before the padded 5 values; swap the first two
+        std::size_t const where = archive.size() - 5 * sizeof(std::ptrdiff_t) - 24;
+        std::string const first = archive.substr(where, sizeof(std::ptrdiff_t));
+        archive.replace(where, sizeof(std::ptrdiff_t), archive.substr(where + sizeof(std::ptrdiff_t), sizeof(std::ptrdiff_t)));
+        archive.replace(where + sizeof(std::ptrdiff_t), sizeof(std::ptrdiff_t), first);
+
+        std::stringstream corrupt(archive, std::ios::in | std::ios::binary);
+        sparse_series<int> result;
+        make_ordered_inserter(result)(1, 1).commit();
+        BOOST_CHECK(!rrs::load_binary(corrupt, result));
+        BOOST_CHECK(corrupt.fail());
+        BOOST_CHECK_EQUAL(1, result[1]);
+    }
+
+    // A count of runs far beyond what the stream holds
+    boost::uint64_t const counts[] = {boost::uint64_t(1) << 33, boost::uint64_t(1) << 60, ~boost::uint64_t(0)};
+    for(std::size_t i = 0; i != sizeof(counts) / sizeof(*counts); ++i)
+    {
+        std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+        rrs::save_binary(ss, s);
+        std::string archive = ss.str();
+
+        // the count comes before the 5 starts and the padded 5 values
+        std::size_t const where = archive.size() - 5 * sizeof(std::ptrdiff_t) - 24 - 8;
+        boost::uint64_t count = 0;
+        archive.copy(reinterpret_cast<char *>(&count), sizeof(count), where);
+        BOOST_REQUIRE_EQUAL(5u, count);
+        archive.replace(where, sizeof(count), reinterpret_cast<char const *>(&counts[i]), sizeof(count));
+
+        std::stringstream corrupt(archive, std::ios::in | std::ios::binary);
+        sparse_series<int> result;
+        make_ordered_inserter(result)(1, 1).commit();
+        BOOST_CHECK(!rrs::load_binary(corrupt, result));
+        BOOST_CHECK(corrupt.fail());
+        BOOST_CHECK_EQUAL(1, result[1]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("binary_archive test");
+
+    test->add(BOOST_TEST_CASE(&test_binary_archive));
+
+    return test;
+}
@@ -111,6 +111,94 @@ void test_coarse_grain()
     BOOST_CHECK_EQUAL(r4, o4);
 }
 
+void test_coarse_grain_reducers()
+{
+    using namespace boost::time_series;
+
+    piecewise_constant_series<int> s1;
+
+    make_ordered_inserter(s1)
+        (1, 0, 3)
+        (3, 8, 11)
+        (5, 11, 12)
+    .commit();
+
+    sparse_series<int> r1(discretization = 4);
+
+    make_ordered_inserter(r1)
+        (3, 0)
+        (14, 2)
+    .commit();
+
+    BOOST_CHECK_EQUAL(r1, coarse_grain(s1, 4, sum_downsample));
+
+    sparse_series<int> r2(discretization = 4);
+
+    make_ordered_inserter(r2)
+        (1, 0)
+        (3, 2)
+    .commit();
+
+    BOOST_CHECK_EQUAL(r2, coarse_grain(s1, 4, min_downsample));
+
+    sparse_series<int> r3(discretization = 4);
+
+    make_ordered_inserter(r3)
+        (1, 0)
+        (5, 2)
+    .commit();
+
+    BOOST_CHECK_EQUAL(r3, coarse_grain(s1, 4, max_downsample));
+    BOOST_CHECK_EQUAL(r3, coarse_grain(s1, 4, last_downsample));
+
+    sparse_series<double> r4(discretization = 4);
+
+    make_ordered_inserter(r4)
+        (1., 0)
+        (4., 2)
+    .commit();
+
+    BOOST_CHECK_EQUAL(r4, coarse_grain(s1, 4, mean_downsample));
+
+    sparse_series<double> r5(discretization = 4);
+
+    make_ordered_inserter(r5)
+        (1., 0)
+        (3.5, 2)
+    .commit();
+
+    BOOST_CHECK_EQUAL(r5, coarse_grain(s1, 4, time_weighted_mean_downsample));
+
+    // Runs straddling a period boundary, and negative offsets
+    sparse_series<int> s2;
+
+    make_ordered_inserter(s2)
+        (1, -3)(2)(3)(4)(5)
+    .commit();
+
+    sparse_series<int> r6(discretization = 2);
+
+    make_ordered_inserter(r6)
+        (1, -2)(5, -1)(9, 0)
+    .commit();
+
+    BOOST_CHECK_EQUAL(r6, coarse_grain(s2, 2, sum_downsample));
+
+    sparse_series<int> o6(discretization = 2);
+    coarse_grain(s2, 2, sum_downsample, make_ordered_inserter(o6)).commit();
+    BOOST_CHECK_EQUAL(r6, o6);
+
+    dense_series<int> d(stop = 100, value = 2);
+
+    sparse_series<int> r7(discretization = 10);
+
+    make_ordered_inserter(r7)
+        (20, 0)(20)(20)(20)(20)(20)(20)(20)(20)(20)
+    .commit();
+
+    BOOST_CHECK_EQUAL(r7, coarse_grain(d, 10, sum_downsample));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -119,6 +207,7 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
     test_suite *test = BOOST_TEST_SUITE("coarse_grain test");
 
     test->add(BOOST_TEST_CASE(&test_coarse_grain));
+    test->add(BOOST_TEST_CASE(&test_coarse_grain_reducers));
 
     return test;
 }
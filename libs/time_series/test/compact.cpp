@@ -0,0 +1,96 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/numeric/compact.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+
+using namespace boost;
+using namespace unit_test;
+using namespace time_series;
+
+///////////////////////////////////////////////////////////////////////////////
+// test_compact
+//
+void test_compact()
+{
+    // flat stretches of a dense series become one run each
+    dense_series<int> d(start = 0, stop = 12);
+    make_ordered_inserter(d)
+        (1, 0)(1, 1)(1, 2)(0, 3)(0, 4)(4, 5)(4, 6)(4, 7)(4, 8)(2, 9)(2, 10)(4, 11)
+    .commit();
+
+    piecewise_constant_series<int> pc = compact(d);
+    BOOST_CHECK_EQUAL(d, pc);
+    BOOST_CHECK_EQUAL(1, pc[2]);
+    BOOST_CHECK_EQUAL(0, pc[4]);
+    BOOST_CHECK_EQUAL(4, pc[11]);
+    BOOST_CHECK_EQUAL(0, pc[12]);
+    BOOST_CHECK_EQUAL(3., compaction_ratio(d));
+
+    // the ratio of a dense series with a pre-run is counted run by run
+    dense_series<int> dp(start = 0, stop = 4);
+    make_ordered_inserter(dp)(5, -inf, 0)(5, 0)(5, 1)(6, 2)(6, 3).commit();
+    BOOST_CHECK_EQUAL(2.5, compaction_ratio(dp));
+    BOOST_CHECK_EQUAL(dp, compact(dp));
+
+    // neighbouring unit runs of a sparse series merge, gaps do not
+    sparse_series<double> s(discretization = 2, zero = -1.);
+    make_ordered_inserter(s)(3., 0)(3., 1)(3., 5)(7., 6).commit();
+    piecewise_constant_series<double, int> ps = compact(s);
+    BOOST_CHECK_EQUAL(2, ps.discretization());
+    BOOST_CHECK_EQUAL(3., ps[1]);
+    BOOST_CHECK_EQUAL(-1., ps[3]);
+    BOOST_CHECK_EQUAL(7., ps[6]);
+    BOOST_CHECK_EQUAL(s, ps);
+
+    // an empty series
+    dense_series<int> e;
+    BOOST_CHECK_EQUAL(1., compaction_ratio(e));
+    BOOST_CHECK_EQUAL(e, compact(e));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_compact_threshold
+//
+void test_compact_threshold()
+{
+    dense_series<double> d(start = 0, stop = 1000);
+    {
+        ordered_inserter<dense_series<double> > o(d);
+        for(int i = 0; i < 1000; ++i)
+        {
+            o(1. + i / 100, i);
+        }
+        o.commit();
+    }
+
+    // 100 values for each run
+    piecewise_constant_series<double> pc;
+    BOOST_CHECK_EQUAL(100., compact(d, pc, 50.));
+    BOOST_CHECK_EQUAL(d, pc);
+    BOOST_CHECK_EQUAL(10., pc[999]);
+
+    // below the threshold out is left alone
+    piecewise_constant_series<double> none;
+    BOOST_CHECK_EQUAL(100., compact(d, none, 200.));
+    BOOST_CHECK_EQUAL(0., none[999]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("compact test");
+
+    test->add(BOOST_TEST_CASE(&test_compact));
+    test->add(BOOST_TEST_CASE(&test_compact_threshold));
+
+    return test;
+}
@@ -0,0 +1,132 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/compressed_sparse_series.hpp>
+#include <boost/time_series/constant_series.hpp>
+#include <boost/time_series/numeric/numeric.hpp>
+#include <boost/time_series/numeric/integrate.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+
+using namespace boost;
+using namespace unit_test;
+using namespace time_series;
+
+namespace seq = boost::sequence;
+namespace rrs = boost::range_run_storage;
+
+///////////////////////////////////////////////////////////////////////////////
+// test_compressed_sparse_series
+//
+void test_compressed_sparse_series()
+{
+    compressed_sparse_series<int> ts;
+    make_ordered_inserter(ts)(42, -1).commit();
+
+    BOOST_CHECK_EQUAL(1, std::distance(seq::begin(ts), seq::end(ts)));
+    BOOST_CHECK_EQUAL(-1, rrs::offset(rrs::runs(ts)(*seq::begin(ts))));
+    BOOST_CHECK_EQUAL(42, seq::elements(ts)(*seq::begin(ts)));
+    BOOST_CHECK_EQUAL(42, ts[-1]);
+    BOOST_CHECK_EQUAL(0, ts[0]);
+
+    // adding compressed series yields a sparse series
+    compressed_sparse_series<int> cs1;
+    compressed_sparse_series<int> cs2;
+    make_ordered_inserter(cs1)(3, 1)(4, 2).commit();
+    make_ordered_inserter(cs2)(4, 2)(5, 3).commit();
+
+    sparse_series<int> ss = cs1 + cs2;
+    BOOST_CHECK_EQUAL(3, std::distance(seq::begin(ss), seq::end(ss)));
+    BOOST_CHECK_EQUAL(3, ss[1]);
+    BOOST_CHECK_EQUAL(8, ss[2]);
+    BOOST_CHECK_EQUAL(5, ss[3]);
+
+    // scaling by a constant keeps it compressed
+    compressed_sparse_series<int> scaled = cs1 * constant_series<int>(2);
+    BOOST_CHECK_EQUAL(6, scaled[1]);
+    BOOST_CHECK_EQUAL(8, scaled[2]);
+
+    // runs longer than 1, and the pre- and post-runs
+    compressed_sparse_series<int> p;
+    make_ordered_inserter(p)(1, -inf, -10)(7, 0, 3)(9, 20, inf).commit();
+    BOOST_CHECK_EQUAL(1, p[-100]);
+    BOOST_CHECK_EQUAL(0, p[-10]);
+    BOOST_CHECK_EQUAL(7, p[2]);
+    BOOST_CHECK_EQUAL(0, p[3]);
+    BOOST_CHECK_EQUAL(9, p[100]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_compressed_ticks
+//
+void test_compressed_ticks()
+{
+    // irregular ticks with slowly moving prices, over many blocks
+    sparse_series<double> s;
+    compressed_sparse_series<double> c;
+    {
+        ordered_inserter<sparse_series<double> > so(s);
+        ordered_inserter<compressed_sparse_series<double> > co(c);
+        std::ptrdiff_t off = -500;
+        double price = 100.;
+        for(int i = 0; i < 10000; ++i)
+        {
+            off += (0 == i % 17) ? 1 + i % 5 : 1;
+            price = (0 == i % 3) ? price + (i % 7 - 3) * 0.25 : price;
+            so(price, off);
+            co(price, off);
+        }
+        so(-1e300, off + 100000);
+        co(-1e300, off + 100000);
+        so.commit();
+        co.commit();
+    }
+
+    BOOST_CHECK_EQUAL(s, c);
+    BOOST_CHECK_EQUAL(10001, std::distance(seq::begin(c), seq::end(c)));
+    BOOST_CHECK_EQUAL(integrate(s), integrate(c));
+    for(std::ptrdiff_t i = -600; i < 13000; i += 7)
+    {
+        BOOST_CHECK_EQUAL(s[i], c[i]);
+    }
+
+    storage::compressed_sparse_array<double> const &data
+        = time_series::detail::time_series_facade_access::data(c);
+    BOOST_CHECK_EQUAL(10001u, data.size());
+    BOOST_CHECK(data.encoded_size() * 4 < 10001 * (sizeof(double) + sizeof(std::ptrdiff_t)));
+
+    // any series converts to a compressed series
+    compressed_sparse_series<double> copy;
+    copy = s;
+    BOOST_CHECK_EQUAL(s, copy);
+
+    // values of every bit pattern survive the round trip
+    compressed_sparse_series<double> odd;
+    make_ordered_inserter(odd)
+        (1., 0)(-1., 1)(1e-300, 2)(1e300, 3)(std::sqrt(2.), 1 << 20)
+        (3., (1 << 20) + 1)(3., (1 << 20) + 2)(-0.5, std::ptrdiff_t(1) << 40)
+    .commit();
+    BOOST_CHECK_EQUAL(1e-300, odd[2]);
+    BOOST_CHECK_EQUAL(1e300, odd[3]);
+    BOOST_CHECK_EQUAL(std::sqrt(2.), odd[1 << 20]);
+    BOOST_CHECK_EQUAL(3., odd[(1 << 20) + 2]);
+    BOOST_CHECK_EQUAL(-0.5, odd[std::ptrdiff_t(1) << 40]);
+    BOOST_CHECK_EQUAL(0., odd[4]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("compressed_sparse_series test");
+
+    test->add(BOOST_TEST_CASE(&test_compressed_sparse_series));
+    test->add(BOOST_TEST_CASE(&test_compressed_ticks));
+
+    return test;
+}
@@ -0,0 +1,126 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/convolve.hpp>
+
+using namespace boost;
+using namespace unit_test;
+using namespace time_series;
+
+namespace rrs = boost::range_run_storage;
+
+template<typename Series, typename Kernel, typename Result>
+void check_convolve(Series const &series, Kernel const &kernel, Result const &result, std::ptrdiff_t lo, std::ptrdiff_t hi, std::ptrdiff_t klo, std::ptrdiff_t khi)
+{
+    for(std::ptrdiff_t i = lo; i < hi; ++i)
+    {
+        double expected = 0.;
+        for(std::ptrdiff_t j = klo; j < khi; ++j)
+            expected += series[i - j] * kernel[j];
+        BOOST_CHECK_SMALL(expected - result[i], 1e-6);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_convolve
+//
+void test_convolve()
+{
+    // small kernel, computed directly
+    piecewise_constant_series<int> p;
+    make_ordered_inserter(p)
+        (2, 0, 10)
+        (-3, 10, 12)
+        (5, 20, 25)
+    .commit();
+
+    dense_series<int> k(start = -1, stop = 2);
+    make_ordered_inserter(k)
+        (1, -1)(2, 0)(-1, 1)
+    .commit();
+
+    dense_series<int> pk = convolve(p, k);
+    check_convolve(p, k, pk, -10, 40, -1, 2);
+    BOOST_CHECK_EQUAL(2 * 2 + 2 * 1 - 1 * 2, pk[5]);
+
+    // long series and kernel, computed by FFT
+    dense_series<double> d(start = 3, stop = 3003);
+    for(int i = 3; i < 3003; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), ((i * 7) % 11 - 5) * 0.5);
+
+    sparse_series<double> sk;
+    for(int i = 0; i < 400; i += 3)
+        make_ordered_inserter(sk)((i % 5) - 2., i).commit();
+
+    dense_series<double> dk = convolve(d, sk);
+    check_convolve(d, sk, dk, 0, 3500, 0, 400);
+
+    // integral results from the FFT are exact
+    dense_series<int> di(start = 0, stop = 3000);
+    for(int i = 0; i < 3000; ++i)
+        rrs::set_at(di, rrs::unit_run<std::ptrdiff_t>(i), (i * 13) % 17 - 8);
+    dense_series<int> dik = convolve(di, di);
+    int expected = 0;
+    for(int i = 0; i <= 2000; ++i)
+        expected += di[i] * di[2000 - i];
+    BOOST_CHECK_EQUAL(expected, dik[2000]);
+
+    // constant tails
+    dense_series<int> tails;
+    make_ordered_inserter(tails)
+        (3, -inf, 0)
+        (1, 0)(2)(3)
+        (-1, 3, inf)
+    .commit();
+
+    dense_series<int> tk = convolve(tails, k);
+    check_convolve(tails, k, tk, -10, 15, -1, 2);
+    BOOST_CHECK_EQUAL(6, tk[-1000]);
+    BOOST_CHECK_EQUAL(-2, tk[1000]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_convolve_large_integers
+//
+void test_convolve_large_integers()
+{
+    // values up to 2e6 against a long 0/1 kernel, by FFT; the results, about
+    // 1e9, are well within what a double holds exactly
+    dense_series<long> d(start = 0, stop = 4000);
+    for(long i = 0; i < 4000; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), (i * 7919 * 7919) % 2000001);
+
+    dense_series<long> k(start = 0, stop = 3000);
+    for(long i = 0; i < 3000; ++i)
+        rrs::set_at(k, rrs::unit_run<std::ptrdiff_t>(i), (i * 31 / 7) % 2);
+
+    dense_series<long> dk = convolve(d, k);
+    for(std::ptrdiff_t i = 0; i < 6999; ++i)
+    {
+        long expected = 0;
+        for(std::ptrdiff_t j = (std::max)(std::ptrdiff_t(0), i - 3999); j < 3000 && j <= i; ++j)
+            expected += d[i - j] * k[j];
+        BOOST_CHECK_EQUAL(expected, dk[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("convolve test");
+
+    test->add(BOOST_TEST_CASE(&test_convolve));
+    test->add(BOOST_TEST_CASE(&test_convolve_large_integers));
+
+    return test;
+}
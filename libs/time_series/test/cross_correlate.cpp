@@ -0,0 +1,115 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/cross_correlate.hpp>
+
+using namespace boost;
+using namespace unit_test;
+using namespace time_series;
+
+namespace rrs = boost::range_run_storage;
+
+template<typename A, typename B, typename Result>
+void check_cross_correlate(A const &a, B const &b, Result const &result, std::ptrdiff_t max_lag, std::ptrdiff_t lo, std::ptrdiff_t hi)
+{
+    for(std::ptrdiff_t lag = -max_lag; lag <= max_lag; ++lag)
+    {
+        double expected = 0.;
+        for(std::ptrdiff_t i = lo; i < hi; ++i)
+            expected += a[i] * b[i + lag];
+        BOOST_CHECK_SMALL(expected - result[lag], 1e-6);
+    }
+    BOOST_CHECK_EQUAL(0., result[-max_lag - 1]);
+    BOOST_CHECK_EQUAL(0., result[max_lag + 1]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_cross_correlate
+//
+void test_cross_correlate()
+{
+    dense_series<double> a(start = 0, stop = 2000);
+    dense_series<double> b(start = 40, stop = 2500);
+    for(int i = 0; i < 2000; ++i)
+        rrs::set_at(a, rrs::unit_run<std::ptrdiff_t>(i), ((i * 7) % 11 - 5) * 0.25);
+    for(int i = 40; i < 2500; ++i)
+        rrs::set_at(b, rrs::unit_run<std::ptrdiff_t>(i), (i * 3) % 5 - 2.);
+
+    // a few lags, summed directly
+    dense_series<double> few = cross_correlate(a, b, 3);
+    check_cross_correlate(a, b, few, 3, 0, 2000);
+
+    // many lags, by FFT
+    dense_series<double> many = cross_correlate(a, b, 600);
+    check_cross_correlate(a, b, many, 600, 0, 2000);
+
+    // b is a copy of a delayed by 5, so the correlation peaks at lag 5
+    sparse_series<int> s, t;
+    make_ordered_inserter(s)(1, 0)(-2, 3)(4, 7)(1, 8).commit();
+    make_ordered_inserter(t)(1, 5)(-2, 8)(4, 12)(1, 13).commit();
+    dense_series<int> st = cross_correlate(s, t, 8);
+    BOOST_CHECK_EQUAL(1 + 4 + 16 + 1, st[5]);
+    check_cross_correlate(s, t, st, 8, -1, 10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_cross_correlate_large_integers
+//
+void test_cross_correlate_large_integers()
+{
+    // values up to 2e6 against a long 0/1 series, with enough lags that the
+    // FFT is used
+    dense_series<long> a(start = 0, stop = 4000);
+    dense_series<long> b(start = 100, stop = 3100);
+    for(long i = 0; i < 4000; ++i)
+        rrs::set_at(a, rrs::unit_run<std::ptrdiff_t>(i), (i * 7919 * 7919) % 2000001);
+    for(long i = 100; i < 3100; ++i)
+        rrs::set_at(b, rrs::unit_run<std::ptrdiff_t>(i), (i * 31 / 7) % 2);
+
+    dense_series<long> ab = cross_correlate(a, b, 3000);
+    for(std::ptrdiff_t lag = -3000; lag <= 3000; ++lag)
+    {
+        long expected = 0;
+        for(std::ptrdiff_t i = (std::max)(std::ptrdiff_t(0), 100 - lag); i < 4000 && i + lag < 3100; ++i)
+            expected += a[i] * b[i + lag];
+        BOOST_CHECK_EQUAL(expected, ab[lag]);
+    }
+
+    // values too large for the FFT to be exact, so that each lag is summed
+    // directly
+    dense_series<long> c(start = 0, stop = 1000);
+    dense_series<long> d(start = 50, stop = 1050);
+    for(long i = 0; i < 1000; ++i)
+        rrs::set_at(c, rrs::unit_run<std::ptrdiff_t>(i), 30000000 - (i * 7919) % 1000);
+    for(long i = 50; i < 1050; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), 29999999 - (i * 31) % 977);
+
+    dense_series<long> cd = cross_correlate(c, d, 600);
+    for(std::ptrdiff_t lag = -600; lag <= 600; ++lag)
+    {
+        long expected = 0;
+        for(std::ptrdiff_t i = (std::max)(std::ptrdiff_t(0), 50 - lag); i < 1000 && i + lag < 1050; ++i)
+            expected += c[i] * d[i + lag];
+        BOOST_CHECK_EQUAL(expected, cd[lag]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("cross_correlate test");
+
+    test->add(BOOST_TEST_CASE(&test_cross_correlate));
+    test->add(BOOST_TEST_CASE(&test_cross_correlate_large_integers));
+
+    return test;
+}
@@ -74,6 +74,146 @@ void test_get_raw_buffer()
     BOOST_CHECK_EQUAL(20u, cbuff.second);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// test_append
+//
+void test_append()
+{
+    dense_series<int> d;
+    make_ordered_inserter(d)(1, 1)(2, 2).commit();
+
+    // appending at or after the end grows the buffer in place
+    make_append_inserter(d)(3, 3)(5, 5).commit();
+    BOOST_CHECK_EQUAL(5u, get_raw_buffer(d).second);
+    BOOST_CHECK_EQUAL(1, d[1]);
+    BOOST_CHECK_EQUAL(2, d[2]);
+    BOOST_CHECK_EQUAL(3, d[3]);
+    BOOST_CHECK_EQUAL(0, d[4]);
+    BOOST_CHECK_EQUAL(5, d[5]);
+    BOOST_CHECK_EQUAL(0, d[6]);
+
+    // the single-value form appends after the given offset
+    make_append_inserter(d, 6)(6)(7).commit();
+    BOOST_CHECK_EQUAL(7u, get_raw_buffer(d).second);
+    BOOST_CHECK_EQUAL(6, d[6]);
+    BOOST_CHECK_EQUAL(7, d[7]);
+
+    // nothing is appended until commit(), and an abandoned inserter
+    // leaves the series as it was
+    {
+        ordered_inserter<dense_series<int> > a = make_append_inserter(d);
+        a(8, 8)(9, 9);
+        BOOST_CHECK_EQUAL(7u, get_raw_buffer(d).second);
+        BOOST_CHECK_EQUAL(0, d[8]);
+    }
+    BOOST_CHECK_EQUAL(7u, get_raw_buffer(d).second);
+    BOOST_CHECK_EQUAL(7, d[7]);
+
+    // writing before the end falls back to copy-and-swap, and the
+    // existing elements are preserved
+    dense_series<int> e(d);
+    ordered_inserter<dense_series<int> > o = make_append_inserter(e);
+    o(42, 2)(43, 9);
+    BOOST_CHECK_EQUAL(2, e[2]);
+    BOOST_CHECK_EQUAL(0, e[9]);
+    o.commit();
+    BOOST_CHECK_EQUAL(1, e[1]);
+    BOOST_CHECK_EQUAL(42, e[2]);
+    BOOST_CHECK_EQUAL(3, e[3]);
+    BOOST_CHECK_EQUAL(7, e[7]);
+    BOOST_CHECK_EQUAL(0, e[8]);
+    BOOST_CHECK_EQUAL(43, e[9]);
+
+    // after the fallback, many runs before and after the start of the data
+    // are written in one pass, leaving the gaps between them alone
+    dense_series<int> g(d);
+    {
+        ordered_inserter<dense_series<int> > a = make_append_inserter(g);
+        a(-7, -3)(-1, 0, 2)(-4, 3)(-5, 5, 7);
+        for(int i = 9; i < 40; i += 3)
+        {
+            a(i, i);
+        }
+        a.commit();
+    }
+    BOOST_CHECK_EQUAL(0, g[-4]);
+    BOOST_CHECK_EQUAL(-7, g[-3]);
+    BOOST_CHECK_EQUAL(0, g[-2]);
+    BOOST_CHECK_EQUAL(-1, g[0]);
+    BOOST_CHECK_EQUAL(-1, g[1]);
+    BOOST_CHECK_EQUAL(2, g[2]);
+    BOOST_CHECK_EQUAL(-4, g[3]);
+    BOOST_CHECK_EQUAL(0, g[4]);
+    BOOST_CHECK_EQUAL(-5, g[5]);
+    BOOST_CHECK_EQUAL(-5, g[6]);
+    BOOST_CHECK_EQUAL(7, g[7]);
+    BOOST_CHECK_EQUAL(0, g[8]);
+    for(int i = 9; i < 40; ++i)
+    {
+        BOOST_CHECK_EQUAL(0 == i % 3 ? i : 0, g[i]);
+    }
+    BOOST_CHECK_EQUAL(0, g[40]);
+
+    // set_at past the end also appends in place
+    typedef rrs::unit_run<std::ptrdiff_t> run_type;
+    rrs::set_at(d, run_type(8), 8);
+    BOOST_CHECK_EQUAL(8u, get_raw_buffer(d).second);
+    BOOST_CHECK_EQUAL(8, d[8]);
+    BOOST_CHECK_EQUAL(1, d[1]);
+
+    // appending to an empty series starts the dense region at the run
+    dense_series<int> f;
+    make_append_inserter(f)(4, 10)(5, 11).commit();
+    BOOST_CHECK_EQUAL(10, rrs::offset(rrs::runs(f)(*seq::begin(f))));
+    BOOST_CHECK_EQUAL(2u, get_raw_buffer(f).second);
+    BOOST_CHECK_EQUAL(5, f[11]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_bulk_insert
+//
+void test_bulk_insert()
+{
+    int const values[] = {1, 2, 3, 4, 5};
+    std::ptrdiff_t const offsets[] = {2, 3, 5, 8, 9};
+
+    // a block of consecutive values
+    dense_series<int> d1, d2;
+    make_ordered_inserter(d1)(9, -3).set_at_range(2, values, values + 5)(6, 7).commit();
+    make_ordered_inserter(d2)(9, -3)(1, 2)(2, 3)(3, 4)(4, 5)(5, 6)(6, 7).commit();
+    BOOST_CHECK_EQUAL(11u, get_raw_buffer(d1).second);
+    for(int i = -5; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(d2[i], d1[i]);
+    }
+
+    // parallel arrays of offsets and values, with gaps
+    dense_series<int> d3, d4;
+    make_ordered_inserter(d3).set_at_offsets(offsets, offsets + 5, values)(6, 10).commit();
+    make_ordered_inserter(d4)(1, 2)(2, 3)(3, 5)(4, 8)(5, 9)(6, 10).commit();
+    BOOST_CHECK_EQUAL(9u, get_raw_buffer(d3).second);
+    for(int i = 0; i < 12; ++i)
+    {
+        BOOST_CHECK_EQUAL(d4[i], d3[i]);
+    }
+
+    // in append mode, blocks past the end grow the buffer in place
+    make_append_inserter(d3).set_at_range(12, values, values + 2).commit();
+    BOOST_CHECK_EQUAL(12u, get_raw_buffer(d3).second);
+    BOOST_CHECK_EQUAL(6, d3[10]);
+    BOOST_CHECK_EQUAL(0, d3[11]);
+    BOOST_CHECK_EQUAL(1, d3[12]);
+    BOOST_CHECK_EQUAL(2, d3[13]);
+
+    // and a block that overlaps existing data falls back to copy-and-swap
+    make_append_inserter(d3).set_at_offsets(offsets + 3, offsets + 5, values).commit();
+    BOOST_CHECK_EQUAL(12u, get_raw_buffer(d3).second);
+    BOOST_CHECK_EQUAL(1, d3[8]);
+    BOOST_CHECK_EQUAL(2, d3[9]);
+    BOOST_CHECK_EQUAL(6, d3[10]);
+    BOOST_CHECK_EQUAL(1, d3[12]);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -84,6 +224,8 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
     test->add(BOOST_TEST_CASE(&test_dense_series));
     test->add(BOOST_TEST_CASE(&test_random_access));
     test->add(BOOST_TEST_CASE(&test_get_raw_buffer));
+    test->add(BOOST_TEST_CASE(&test_append));
+    test->add(BOOST_TEST_CASE(&test_bulk_insert));
 
     return test;
 }
@@ -0,0 +1,200 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <set>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/ewma.hpp>
+#include <boost/range_run_storage/algorithm/copy.hpp>
+
+using namespace boost;
+using namespace unit_test;
+using namespace time_series;
+
+namespace rrs = boost::range_run_storage;
+
+// Collects the last offset of each run written to it
+struct record_run_ends
+{
+    typedef std::set<std::ptrdiff_t> ends_type;
+
+    explicit record_run_ends(ends_type &ends)
+      : ends(&ends)
+    {}
+
+    template<typename Run, typename Value>
+    void set_at(Run const &run, Value const &)
+    {
+        this->ends->insert(rrs::end_offset(run) - 1);
+    }
+
+    ends_type *ends;
+};
+
+// Steps the average one offset at a time over [-5, 60), and checks that
+// result has the average at the last offset of each run of series, unless
+// it is zero, and nothing anywhere else
+template<typename Series>
+void check_ewma(Series const &series, sparse_series<double> const &result, double alpha)
+{
+    record_run_ends::ends_type series_ends, result_ends;
+    record_run_ends series_out(series_ends), result_out(result_ends);
+    rrs::copy(series, series_out);
+    rrs::copy(result, result_out);
+
+    BOOST_REQUIRE(!series_ends.empty());
+    BOOST_CHECK(-5 < *series_ends.begin() && *series_ends.rbegin() < 60);
+
+    double state = 0.;
+    for(std::ptrdiff_t i = -5; i < 60; ++i)
+    {
+        state = alpha * series[i] + (1. - alpha) * state;
+        bool const expected = 0 != series_ends.count(i) && 0. != state;
+        BOOST_CHECK_EQUAL(expected, 0 != result_ends.count(i));
+        if(expected)
+        {
+            BOOST_CHECK_CLOSE(state, result[i], 1e-9);
+        }
+    }
+
+    BOOST_CHECK(result_ends.empty() || (-5 <= *result_ends.begin() && *result_ends.rbegin() < 60));
+}
+
+// Steps the average one offset at a time over [-5, 60), and checks that
+// result has it at every offset up to the end of the last run of series
+template<typename Series>
+void check_filled_ewma(Series const &series, dense_series<double> const &result, double alpha)
+{
+    record_run_ends::ends_type series_ends;
+    record_run_ends series_out(series_ends);
+    rrs::copy(series, series_out);
+
+    BOOST_REQUIRE(!series_ends.empty());
+    std::ptrdiff_t const last = *series_ends.rbegin();
+
+    double state = 0.;
+    for(std::ptrdiff_t i = -5; i <= last; ++i)
+    {
+        state = alpha * series[i] + (1. - alpha) * state;
+        if(0. == state)
+        {
+            BOOST_CHECK_EQUAL(0., result[i]);
+        }
+        else
+        {
+            BOOST_CHECK_CLOSE(state, result[i], 1e-9);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_ewma
+//
+void test_ewma()
+{
+    piecewise_constant_series<int> p;
+    make_ordered_inserter(p)
+        (2, 0, 10)
+        (-3, 10, 12)
+        (4, 12, 13)
+        (5, 20, 35)
+        (-1, 40, 41)
+    .commit();
+
+    sparse_series<double> pe = ewma_at_run_ends(p, 0.25);
+    check_ewma(p, pe, 0.25);
+
+    // one value per run, at its last offset
+    BOOST_CHECK_EQUAL(0., pe[8]);
+    BOOST_CHECK_EQUAL(0., pe[34 + 1]);
+    BOOST_CHECK_CLOSE(2. - 2. * std::pow(0.75, 10), pe[9], 1e-9);
+    BOOST_CHECK_EQUAL(0., pe[5]);
+
+    dense_series<int> d(start = 2, stop = 30);
+    for(int i = 2; i < 30; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), (i * 7) % 11 - 5);
+
+    sparse_series<double> de = ewma_at_run_ends(d, 0.5);
+    check_ewma(d, de, 0.5);
+    BOOST_CHECK_CLOSE(0.5 * d[2], de[2], 1e-9);
+
+    sparse_series<int> s;
+    make_ordered_inserter(s)
+        (3, 1)(-2, 4)(6, 5)(1, 20)
+    .commit();
+
+    sparse_series<double> se = ewma_at_run_ends(s, 0.1);
+    check_ewma(s, se, 0.1);
+    BOOST_CHECK_CLOSE(0.3, se[1], 1e-9);
+    BOOST_CHECK_CLOSE(0.3 * 0.9 * 0.9 * 0.9 - 0.2, se[4], 1e-9);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_filled_ewma
+//
+void test_filled_ewma()
+{
+    piecewise_constant_series<int> p;
+    make_ordered_inserter(p)
+        (2, 0, 10)
+        (-3, 10, 12)
+        (4, 12, 13)
+        (5, 20, 35)
+        (-1, 40, 41)
+    .commit();
+
+    dense_series<double> pe = ewma(p, 0.25);
+    check_filled_ewma(p, pe, 0.25);
+
+    // the average inside a run and inside a gap, not only at the run ends
+    BOOST_CHECK_CLOSE(2. - 2. * std::pow(0.75, 6), pe[5], 1e-9);
+    BOOST_CHECK_CLOSE(pe[12] * std::pow(0.75, 3), pe[15], 1e-9);
+
+    dense_series<int> d(start = 2, stop = 30);
+    for(int i = 2; i < 30; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), (i * 7) % 11 - 5);
+
+    dense_series<double> de = ewma(d, 0.5);
+    check_filled_ewma(d, de, 0.5);
+
+    sparse_series<int> s;
+    make_ordered_inserter(s)
+        (3, 1)(-2, 4)(6, 5)(1, 20)
+    .commit();
+
+    dense_series<double> se = ewma(s, 0.1);
+    check_filled_ewma(s, se, 0.1);
+    BOOST_CHECK_CLOSE(0.3 * 0.9, se[2], 1e-9);
+
+    // the same averages through the general path
+    piecewise_constant_series<int> ps;
+    make_ordered_inserter(ps)
+        (3, 1, 2)(-2, 4, 5)(6, 5, 6)(1, 20, 21)
+    .commit();
+
+    dense_series<double> pse = ewma(ps, 0.1);
+    check_filled_ewma(ps, pse, 0.1);
+    for(std::ptrdiff_t i = 0; i < 21; ++i)
+    {
+        BOOST_CHECK_CLOSE(se[i] + 1., pse[i] + 1., 1e-9);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("ewma test");
+
+    test->add(BOOST_TEST_CASE(&test_ewma));
+    test->add(BOOST_TEST_CASE(&test_filled_ewma));
+
+    return test;
+}
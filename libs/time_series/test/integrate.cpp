@@ -5,6 +5,8 @@
 
 #include <boost/test/unit_test.hpp>
 #include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/dense_series.hpp>
 #include <boost/time_series/numeric/integrate.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
 
@@ -33,6 +35,51 @@ void test_integrate()
         (2, 90, 99)
     .commit();
     BOOST_CHECK_EQUAL(2340, integrate(p2));
+
+    sparse_series<int> s1(discretization = 30);
+    make_ordered_inserter(s1)(2, 0)(4, 10)(2, 90).commit();
+    BOOST_CHECK_EQUAL(240, integrate(s1));
+
+    sparse_series<double> s2;
+    make_ordered_inserter(s2)(.5, -3)(1.5, 5).commit();
+    BOOST_CHECK_EQUAL(2., integrate(s2));
+
+    // the unit runs of floating-point offsets have no length
+    sparse_series<double, int, double> s3;
+    make_ordered_inserter(s3)(1., .5)(2., 1.5).commit();
+    BOOST_CHECK_EQUAL(0., integrate(s3));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_integrate_compensated
+//
+void test_integrate_compensated()
+{
+    using namespace time_series;
+
+    // Added one at a time to 1, each of the small values is rounded away
+    std::ptrdiff_t const size = 100001;
+    double const small = 1e-16;
+
+    dense_series<double> d(start = 0, stop = size, value = small);
+    range_run_storage::set_at(d, range_run_storage::unit_run<std::ptrdiff_t>(0), 1.);
+    BOOST_CHECK_CLOSE(1e-11, integrate(d) - 1., 1e-3);
+
+    sparse_series<double> s;
+    ordered_inserter<sparse_series<double> > out(s);
+    out(1., 0);
+    for(std::ptrdiff_t i = 1; i < size; ++i)
+        out(small, i);
+    out.commit();
+    BOOST_CHECK_CLOSE(1e-11, integrate(s) - 1., 1e-3);
+
+    piecewise_constant_series<double> p;
+    ordered_inserter<piecewise_constant_series<double> > pout(p);
+    pout(1., 0, 1);
+    for(std::ptrdiff_t i = 1; i < size; ++i)
+        pout(i % 2 ? small : 2 * small, 2 * i, 2 * i + 1);
+    pout.commit();
+    BOOST_CHECK_CLOSE(1.5e-11, integrate(p) - 1., 1e-3);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -43,6 +90,7 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
     test_suite *test = BOOST_TEST_SUITE("integrate test");
 
     test->add(BOOST_TEST_CASE(&test_integrate));
+    test->add(BOOST_TEST_CASE(&test_integrate_compensated));
 
     return test;
 }
@@ -0,0 +1,140 @@
+//  (C) Copyright Eric Niebler 2005.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/constant_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/numeric/numeric.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/lazy_series.hpp>
+
+using namespace boost::unit_test;
+using namespace boost::time_series;
+
+namespace seq = boost::sequence;
+namespace rrs = boost::range_run_storage;
+
+///////////////////////////////////////////////////////////////////////////////
+// test_lazy_plus
+//
+void test_lazy_plus()
+{
+    dense_series<int> ss1;
+    sparse_series<int> ss2;
+
+    make_ordered_inserter(ss1)(3, 1)(4, 2).commit();
+    make_ordered_inserter(ss2)(4, 2)(5, 3).commit();
+
+    dense_series<int> eager = ss1 + ss2;
+    dense_series<int> ss3 = lazy(ss1) + ss2;
+
+    BOOST_CHECK_EQUAL(3, std::distance(seq::begin(ss3), seq::end(ss3)));
+    for(int i = -2; i < 6; ++i)
+    {
+        BOOST_CHECK_EQUAL(eager[i], ss3[i]);
+    }
+
+    BOOST_CHECK_EQUAL(3, (lazy(ss1) + ss2)[1]);
+    BOOST_CHECK_EQUAL(8, (lazy(ss1) + ss2)[2]);
+    BOOST_CHECK_EQUAL(0, (lazy(ss1) + ss2)[4]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_lazy_expression
+//
+void test_lazy_expression()
+{
+    dense_series<int> a, b, c;
+    piecewise_constant_series<int> d;
+
+    make_ordered_inserter(a)(1, 0)(2, 1)(3, 2)(4, 3)(5, 4).commit();
+    make_ordered_inserter(b)(2, 2)(3, 3)(4, 4)(5, 5).commit();
+    make_ordered_inserter(c)(7, 1)(8, 2)(9, 3)(10, 4)(11, 5)(12, 6).commit();
+    make_ordered_inserter(d)(1, 3, 7).commit();
+
+    dense_series<int> eager = a + b * c - d;
+    dense_series<int> fused = lazy(a) + b * lazy(c) - d;
+
+    BOOST_CHECK_EQUAL(rrs::offset(rrs::runs(eager)(*seq::begin(eager))),
+                      rrs::offset(rrs::runs(fused)(*seq::begin(fused))));
+    for(int i = -2; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(eager[i], fused[i]);
+    }
+
+    dense_series<int> scaled = 2 * lazy(a) + lazy(b) * 3;
+    for(int i = -2; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(2 * a[i] + b[i] * 3, scaled[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_lazy_intersection
+//
+void test_lazy_intersection()
+{
+    dense_series<int> ss1, ss2;
+
+    make_ordered_inserter(ss1)(1, 0)(2, 1).commit();
+    make_ordered_inserter(ss2)(3, 5)(4, 6).commit();
+
+    dense_series<int> ss3 = lazy(ss1) * ss2;
+    BOOST_CHECK_EQUAL(0, std::distance(seq::begin(ss3), seq::end(ss3)));
+
+    make_ordered_inserter(ss2)(3, 1)(4, 2)(5, 3).commit();
+    ss3 = lazy(ss1) * ss2;
+    BOOST_CHECK_EQUAL(1, std::distance(seq::begin(ss3), seq::end(ss3)));
+    BOOST_CHECK_EQUAL(6, ss3[1]);
+    BOOST_CHECK_EQUAL(0, ss3[2]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_lazy_constant
+//
+void test_lazy_constant()
+{
+    dense_series<double> ss1;
+    constant_series<double> ss2(5.);
+
+    make_ordered_inserter(ss1)(1., 2)(2., 3)(3., 4).commit();
+
+    // The constant extends everywhere, so the sum has pre- and post-runs
+    dense_series<double> eager = ss1 + ss2;
+    dense_series<double> fused = lazy(ss1) + ss2;
+    for(int i = -5; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(eager[i], fused[i]);
+    }
+    BOOST_CHECK_EQUAL(5., rrs::pre_value(fused));
+    BOOST_CHECK_EQUAL(5., rrs::post_value(fused));
+    BOOST_CHECK_EQUAL(3, std::distance(seq::begin(fused), seq::end(fused)));
+
+    // Products with a constant only cover the other operand
+    piecewise_constant_series<double> ss3;
+    make_ordered_inserter(ss3)(2., 0, 4)(3., 6, 8).commit();
+    piecewise_constant_series<double> product = lazy(ss3) * ss2;
+    for(int i = -2; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(ss3[i] * 5., product[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("lazy series test");
+
+    test->add(BOOST_TEST_CASE(&test_lazy_plus));
+    test->add(BOOST_TEST_CASE(&test_lazy_expression));
+    test->add(BOOST_TEST_CASE(&test_lazy_intersection));
+    test->add(BOOST_TEST_CASE(&test_lazy_constant));
+
+    return test;
+}
@@ -0,0 +1,148 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/mapped_dense_series.hpp>
+#include <boost/time_series/mapped_sparse_series.hpp>
+#include <boost/time_series/numeric/numeric.hpp>
+#include <boost/time_series/numeric/integrate.hpp>
+#include <boost/range_run_storage/utility/binary_archive.hpp>
+
+using namespace boost;
+using namespace unit_test;
+
+template<typename Series>
+void save_file(char const *file, Series const &series)
+{
+    std::ofstream ofs(file, std::ios::out | std::ios::binary);
+    range_run_storage::save_binary(ofs, series);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_mapped_dense_series
+//
+void test_mapped_dense_series()
+{
+    namespace rrs = range_run_storage;
+    using namespace time_series;
+
+    dense_series<double, double> d(discretization = 0.5);
+    ordered_inserter<dense_series<double, double> > o(d);
+    o(3., -inf, -5);
+    for(int i = -5; i < 1000; ++i)
+        o(i / 7., i);
+    o(4., 1000, inf);
+    o.commit();
+    save_file("mapped_series_test.bin", d);
+
+    {
+        mapped_dense_series<double, double> m(file = "mapped_series_test.bin", discretization = 0.5);
+        BOOST_CHECK_EQUAL(d, m);
+        BOOST_CHECK_EQUAL(0.5, m.discretization());
+        BOOST_CHECK_EQUAL(3., m[-100]);
+        BOOST_CHECK_EQUAL(d[7], m[7]);
+        BOOST_CHECK_EQUAL(4., m[2000]);
+
+        // copies share the mapping
+        mapped_dense_series<double, double> c(m);
+        BOOST_CHECK_EQUAL(d, c);
+
+        // arithmetic on a mapped series gives an ordinary series
+        dense_series<double, double> twice = m + m;
+        BOOST_CHECK_EQUAL(2 * d[500], twice[500]);
+    }
+
+    // not a dense archive
+    sparse_series<double> s;
+    make_ordered_inserter(s)(1., 3)(2., 7).commit();
+    save_file("mapped_series_test.bin", s);
+    BOOST_CHECK_THROW((mapped_dense_series<double>(file = "mapped_series_test.bin", discretization = 1)), std::runtime_error);
+    BOOST_CHECK_THROW((mapped_dense_series<int>(file = "mapped_series_test.bin", discretization = 1)), std::runtime_error);
+
+    // an empty series needs no file
+    mapped_dense_series<double> e;
+    BOOST_CHECK_EQUAL(dense_series<double>(), e);
+
+    std::remove("mapped_series_test.bin");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_mapped_sparse_series
+//
+void test_mapped_sparse_series()
+{
+    namespace rrs = range_run_storage;
+    using namespace time_series;
+
+    sparse_series<int> s(discretization = 1, zero = -1);
+    make_ordered_inserter(s)(5, 0)(1, 3)(4, 7)(2, 8)(3, 20).commit();
+    save_file("mapped_series_test.bin", s);
+
+    {
+        mapped_sparse_series<int> m(file = "mapped_series_test.bin", discretization = 1);
+        BOOST_CHECK_EQUAL(s, m);
+        BOOST_CHECK_EQUAL(-1, rrs::zero(m));
+        for(int i = -2; i < 25; ++i)
+            BOOST_CHECK_EQUAL(s[i], m[i]);
+        BOOST_CHECK_EQUAL(integrate(s), integrate(m));
+
+        sparse_series<int> sum = m + s;
+        BOOST_CHECK_EQUAL(2 * s[7], sum[7]);
+    }
+
+    // contiguous offsets store only the first start
+    sparse_series<int> c;
+    make_ordered_inserter(c)(1, 10)(2, 11)(3, 12).commit();
+    save_file("mapped_series_test.bin", c);
+
+    {
+        mapped_sparse_series<int> m(file = "mapped_series_test.bin", discretization = 1);
+        BOOST_CHECK_EQUAL(c, m);
+        BOOST_CHECK_EQUAL(2, m[11]);
+        BOOST_CHECK_EQUAL(0, m[13]);
+    }
+
+    // a dense archive maps as sparse too
+    dense_series<int> d(start = 2, stop = 6, value = 7);
+    save_file("mapped_series_test.bin", d);
+
+    {
+        mapped_sparse_series<int> m(file = "mapped_series_test.bin", discretization = 1);
+        BOOST_CHECK_EQUAL(d, m);
+    }
+
+    // floating-point offsets
+    sparse_series<int, int, double> f;
+    make_ordered_inserter(f)(1, .5)(2, 1.5)(3, 1.75).commit();
+    save_file("mapped_series_test.bin", f);
+
+    {
+        mapped_sparse_series<int, int, double> m(file = "mapped_series_test.bin", discretization = 1);
+        BOOST_CHECK_EQUAL(f, m);
+        BOOST_CHECK_EQUAL(2, m[1.5]);
+        BOOST_CHECK_EQUAL(0, m[1.]);
+    }
+
+    std::remove("mapped_series_test.bin");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("mapped_series test");
+
+    test->add(BOOST_TEST_CASE(&test_mapped_dense_series));
+    test->add(BOOST_TEST_CASE(&test_mapped_sparse_series));
+
+    return test;
+}
@@ -6,6 +6,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/time_series/delta_series.hpp>
 #include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/constant_series.hpp>
 #include <boost/time_series/sparse_series.hpp>
 #include <boost/time_series/piecewise_constant_series.hpp>
 #include <boost/time_series/characteristic_series.hpp>
@@ -88,6 +89,72 @@ void test_series_multiplies2()
     BOOST_CHECK_EQUAL(expected, result);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// test_series_multiplies_dense
+//
+void test_series_multiplies_dense()
+{
+    // dense * dense is computed directly on the buffers, over the overlap only
+    dense_series<double> ss1(start = 1, stop = 5, value = 2.);
+    dense_series<double> ss2(start = 3, stop = 9, value = 3.);
+
+    dense_series<double> product = ss1 * ss2;
+    BOOST_CHECK_EQUAL(2, std::distance(seq::begin(product), seq::end(product)));
+    BOOST_CHECK_EQUAL(3, rrs::offset(rrs::runs(product)(*seq::begin(product))));
+    BOOST_CHECK_EQUAL(0., product[2]);
+    BOOST_CHECK_EQUAL(6., product[3]);
+    BOOST_CHECK_EQUAL(6., product[4]);
+    BOOST_CHECK_EQUAL(0., product[5]);
+
+    dense_series<double> quotient = ss2 / ss1;
+    BOOST_CHECK_EQUAL(2, std::distance(seq::begin(quotient), seq::end(quotient)));
+    BOOST_CHECK_EQUAL(1.5, quotient[3]);
+
+    dense_series<double> disjoint(start = 10, stop = 12, value = 1.);
+    dense_series<double> none = ss1 * disjoint;
+    BOOST_CHECK_EQUAL(0, std::distance(seq::begin(none), seq::end(none)));
+
+    // dense * constant keeps the extent of the dense series
+    constant_series<double> c(0.5);
+    dense_series<double> halved = ss1 * c;
+    BOOST_CHECK_EQUAL(4, std::distance(seq::begin(halved), seq::end(halved)));
+    BOOST_CHECK_EQUAL(1., halved[1]);
+    BOOST_CHECK_EQUAL(1., halved[4]);
+    BOOST_CHECK_EQUAL(0., halved[5]);
+
+    ss1 *= ss2;
+    BOOST_CHECK_EQUAL(product, ss1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_series_multiplies_skewed
+//
+void test_series_multiplies_skewed()
+{
+    // a few points masking a long series skip through it; check the skips
+    // land on the right runs, including the first, last and adjacent ones
+    sparse_series<int> ticks, events;
+    {
+        ordered_inserter<sparse_series<int> > in(ticks);
+        for(int i = 0; i != 10000; ++i)
+        {
+            in(i % 7 + 1, 3 * i);
+        }
+        in.commit();
+    }
+    make_ordered_inserter(events)(2, 0)(3, 1)(5, 3)(7, 6)(11, 3000)(13, 3001)(17, 29997)(19, 40000).commit();
+
+    sparse_series<int> masked = events * ticks;
+    BOOST_CHECK_EQUAL(5, std::distance(seq::begin(masked), seq::end(masked)));
+    BOOST_CHECK_EQUAL(2 * 1, masked[0]);
+    BOOST_CHECK_EQUAL(5 * 2, masked[3]);
+    BOOST_CHECK_EQUAL(7 * 3, masked[6]);
+    BOOST_CHECK_EQUAL(11 * (1000 % 7 + 1), masked[3000]);
+    BOOST_CHECK_EQUAL(17 * (9999 % 7 + 1), masked[29997]);
+
+    BOOST_CHECK_EQUAL(masked, ticks * events);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -97,6 +164,8 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
 
     test->add(BOOST_TEST_CASE(&test_series_multiplies));
     test->add(BOOST_TEST_CASE(&test_series_multiplies2));
+    test->add(BOOST_TEST_CASE(&test_series_multiplies_dense));
+    test->add(BOOST_TEST_CASE(&test_series_multiplies_skewed));
 
     return test;
 }
@@ -0,0 +1,326 @@
+//  (C) Copyright Eric Niebler 2005.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <vector>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/numeric/numeric.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/partial_sum.hpp>
+#include <boost/time_series/numeric/parallel_partial_sum.hpp>
+#include <boost/time_series/numeric/parallel_integrate.hpp>
+#include <boost/range_run_storage/algorithm/parallel.hpp>
+
+using namespace boost::unit_test;
+using namespace boost::time_series;
+
+namespace seq = boost::sequence;
+namespace rrs = boost::range_run_storage;
+
+struct record_values
+{
+    explicit record_values(std::vector<int> &values)
+      : values(&values)
+    {}
+
+    void operator ()(int value, std::ptrdiff_t offset, std::ptrdiff_t end_offset) const
+    {
+        for(; offset != end_offset; ++offset)
+            (*this->values)[offset] = value;
+    }
+
+    std::vector<int> *values;
+};
+
+template<typename Series>
+struct record_lookups
+{
+    record_lookups(Series const &series, std::vector<int> &values)
+      : series(&series)
+      , values(&values)
+    {}
+
+    void operator ()(int, std::ptrdiff_t offset, std::ptrdiff_t end_offset) const
+    {
+        for(; offset != end_offset; ++offset)
+            (*this->values)[offset] = (*this->series)[offset];
+    }
+
+    Series const *series;
+    std::vector<int> *values;
+};
+
+struct throw_at
+{
+    typedef int result_type;
+
+    explicit throw_at(int bad)
+      : bad(bad)
+    {}
+
+    int operator ()(int value) const
+    {
+        if(value == this->bad)
+            throw std::runtime_error("throw_at");
+        return value;
+    }
+
+    void operator ()(int value, std::ptrdiff_t, std::ptrdiff_t) const
+    {
+        (*this)(value);
+    }
+
+    int bad;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// test_parallel_transform
+//
+void test_parallel_transform()
+{
+    dense_series<int> ss1(start = 5, stop = 1000, value = 3);
+    sparse_series<int> ss2;
+    {
+        ordered_inserter<sparse_series<int> > in(ss2);
+        for(int i = 0; i < 1200; i += 7)
+            in(i, i);
+        in.commit();
+    }
+
+    for(std::size_t threads = 1; threads != 6; ++threads)
+    {
+        dense_series<int> sum;
+        {
+            ordered_inserter<dense_series<int> > out(sum);
+            rrs::parallel_transform(ss1, ss2, boost::numeric::plus, out, threads).commit();
+        }
+        BOOST_CHECK_EQUAL(ss1 + ss2, sum);
+
+        dense_series<int> copy;
+        {
+            ordered_inserter<dense_series<int> > out(copy);
+            rrs::parallel_copy(ss1, out, threads).commit();
+        }
+        BOOST_CHECK_EQUAL(ss1, copy);
+
+        std::vector<int> values(1000, 0);
+        rrs::parallel_for_each(ss1, record_values(values), threads);
+        BOOST_CHECK_EQUAL(0, values[4]);
+        BOOST_CHECK_EQUAL(3, values[5]);
+        BOOST_CHECK_EQUAL(3, values[999]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_parallel_transform_piecewise
+//
+void test_parallel_transform_piecewise()
+{
+    // long runs on one side must not be cut where the other side is split
+    piecewise_constant_series<int> ss1, ss2;
+    make_ordered_inserter(ss1)(1, 0, 10)(2, 10, 20)(3, 20, 30)(4, 30, 40)(5, 40, 50)(6, 50, 60).commit();
+    make_ordered_inserter(ss2)(10, 5, 55)(20, 58, 70).commit();
+
+    piecewise_constant_series<int> expected = ss1 + ss2;
+    dense_series<int> ss3(start = 3, stop = 65, value = 100);
+    for(std::size_t threads = 2; threads != 8; ++threads)
+    {
+        piecewise_constant_series<int> sum;
+        {
+            ordered_inserter<piecewise_constant_series<int> > out(sum);
+            rrs::parallel_transform(ss1, ss2, boost::numeric::plus, out, threads).commit();
+        }
+        for(int i = -2; i < 75; ++i)
+        {
+            BOOST_CHECK_EQUAL(expected[i], sum[i]);
+        }
+
+        dense_series<int> mixed;
+        {
+            ordered_inserter<dense_series<int> > out(mixed);
+            rrs::parallel_transform(ss3, ss1, boost::numeric::plus, out, threads).commit();
+        }
+        for(int i = -2; i < 75; ++i)
+        {
+            BOOST_CHECK_EQUAL(ss3[i] + ss1[i], mixed[i]);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_parallel_partial_sum
+//
+void test_parallel_partial_sum()
+{
+    dense_series<int> d(start = 3, stop = 1003);
+    for(int i = 3; i < 1003; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), (i * 7) % 13 - 6);
+
+    piecewise_constant_series<int> pwc;
+    make_ordered_inserter(pwc)
+        (2, 0, 10)
+        (-1, 10, 25)
+        (5, 40, 41)
+    .commit();
+
+    piecewise_constant_series<int> expected = partial_sum(d);
+    piecewise_constant_series<int> expected_pwc = partial_sum(pwc);
+    for(std::size_t threads = 1; threads <= 5; ++threads)
+    {
+        piecewise_constant_series<int> actual = parallel_partial_sum(d, threads);
+        for(int i = -2; i < 1010; ++i)
+        {
+            BOOST_CHECK_EQUAL(expected[i], actual[i]);
+        }
+
+        piecewise_constant_series<int> actual_pwc = parallel_partial_sum(pwc, threads);
+        BOOST_CHECK_EQUAL(expected_pwc, actual_pwc);
+    }
+
+    // enough runs that every thread gets a block, with gaps between them
+    piecewise_constant_series<int> many;
+    {
+        ordered_inserter<piecewise_constant_series<int> > o(many);
+        for(int i = 0; i < 200; ++i)
+        {
+            o(i % 7 - 3, 5 * i, 5 * i + 1 + i % 4);
+        }
+        o.commit();
+    }
+
+    piecewise_constant_series<int> expected_many = partial_sum(many);
+    for(std::size_t threads = 1; threads <= 5; ++threads)
+    {
+        piecewise_constant_series<int> actual_many = parallel_partial_sum(many, threads);
+        BOOST_CHECK_EQUAL(expected_many, actual_many);
+        for(int i = -2; i < 1010; ++i)
+        {
+            BOOST_CHECK_EQUAL(expected_many[i], actual_many[i]);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(0, expected[2]);
+    BOOST_CHECK_EQUAL(d[3], expected[3]);
+    BOOST_CHECK_EQUAL(expected[1002], expected[5000]);
+
+    BOOST_CHECK_EQUAL(20, expected_pwc[9]);
+    BOOST_CHECK_EQUAL(5, expected_pwc[24]);
+    BOOST_CHECK_EQUAL(5, expected_pwc[39]);
+    BOOST_CHECK_EQUAL(10, expected_pwc[40]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_parallel_lookup
+//
+void test_parallel_lookup()
+{
+    // large enough that lookups go through the sampled index, which all the
+    // threads read at once
+    sparse_series<int> s;
+    piecewise_constant_series<int> p;
+    {
+        ordered_inserter<sparse_series<int> > so(s);
+        ordered_inserter<piecewise_constant_series<int> > po(p);
+        for(int i = 0; i < 3000; i += 3)
+        {
+            so(i + 1, i);
+            po(i + 1, i, i + 2);
+        }
+        so.commit();
+        po.commit();
+    }
+    s.build_index();
+    p.build_index();
+
+    dense_series<int> domain(start = 0, stop = 3000, value = 1);
+    for(std::size_t threads = 1; threads != 6; ++threads)
+    {
+        std::vector<int> sv(3000, -1), pv(3000, -1);
+        rrs::parallel_for_each(domain, record_lookups<sparse_series<int> >(s, sv), threads);
+        rrs::parallel_for_each(domain, record_lookups<piecewise_constant_series<int> >(p, pv), threads);
+        for(int i = 0; i < 3000; ++i)
+        {
+            BOOST_CHECK_EQUAL(0 == i % 3 ? i + 1 : 0, sv[i]);
+            BOOST_CHECK_EQUAL(2 == i % 3 ? 0 : i - i % 3 + 1, pv[i]);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_parallel_integrate
+//
+void test_parallel_integrate()
+{
+    dense_series<int> d(start = 3, stop = 1003);
+    dense_series<double> dd(start = 3, stop = 1003);
+    for(int i = 3; i < 1003; ++i)
+    {
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), (i * 7) % 13 - 6);
+        rrs::set_at(dd, rrs::unit_run<std::ptrdiff_t>(i), 1. / i);
+    }
+
+    sparse_series<double> s;
+    make_ordered_inserter(s)(.5, -3)(1.5, 5)(.25, 40).commit();
+
+    sparse_series<double, int, double> fs;
+    make_ordered_inserter(fs)(1., .5)(2., 1.5).commit();
+
+    piecewise_constant_series<int> pwc;
+    make_ordered_inserter(pwc)
+        (2, 0, 10)
+        (-1, 10, 25)
+    .commit();
+
+    for(std::size_t threads = 1; threads <= 5; ++threads)
+    {
+        BOOST_CHECK_EQUAL(integrate(d), parallel_integrate(d, threads));
+        BOOST_CHECK_CLOSE(integrate(dd), parallel_integrate(dd, threads), 1e-12);
+        BOOST_CHECK_EQUAL(2.25, parallel_integrate(s, threads));
+        BOOST_CHECK_EQUAL(0., parallel_integrate(fs, threads));
+        BOOST_CHECK_EQUAL(5, parallel_integrate(pwc, threads));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_parallel_exceptions
+//
+void test_parallel_exceptions()
+{
+    dense_series<int> d(start = 0, stop = 1000);
+    for(int i = 0; i < 1000; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), i);
+
+    for(std::size_t threads = 1; threads != 6; ++threads)
+    {
+        // once on the calling thread's chunk, once on the last thread's
+        for(int bad = 0; bad < 1000; bad += 999)
+        {
+            dense_series<int> out;
+            ordered_inserter<dense_series<int> > o(out);
+            BOOST_CHECK_THROW(rrs::parallel_transform(d, throw_at(bad), o, threads), std::runtime_error);
+            BOOST_CHECK_THROW(rrs::parallel_for_each(d, throw_at(bad), threads), std::runtime_error);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("parallel transform test");
+
+    test->add(BOOST_TEST_CASE(&test_parallel_transform));
+    test->add(BOOST_TEST_CASE(&test_parallel_transform_piecewise));
+    test->add(BOOST_TEST_CASE(&test_parallel_partial_sum));
+    test->add(BOOST_TEST_CASE(&test_parallel_lookup));
+    test->add(BOOST_TEST_CASE(&test_parallel_integrate));
+    test->add(BOOST_TEST_CASE(&test_parallel_exceptions));
+
+    return test;
+}
@@ -55,6 +55,33 @@ void test_partial_sum()
 
     piecewise_constant_series<int, monthly> s4 = partial_sum(d);
     BOOST_CHECK_EQUAL(s4, result2);
+
+    // long runs, including one of zeros
+    piecewise_constant_series<double> p2;
+    make_ordered_inserter(p2)
+        (0.5, 0, 1000)
+        (0., 1000, 2000)
+        (-1., 2000, 2500)
+    .commit();
+    piecewise_constant_series<double> s5 = partial_sum(p2);
+    BOOST_CHECK_EQUAL(0., s5[-1]);
+    BOOST_CHECK_EQUAL(0.5, s5[0]);
+    BOOST_CHECK_EQUAL(500., s5[999]);
+    BOOST_CHECK_EQUAL(500., s5[1500]);
+    BOOST_CHECK_EQUAL(499., s5[2000]);
+    BOOST_CHECK_EQUAL(0., s5[2499]);
+    BOOST_CHECK_EQUAL(0., s5[10000]);
+
+    // a dense result takes the sums over each run as one block
+    dense_series<double> d5;
+    partial_sum(p2, make_ordered_inserter(d5)).commit();
+    BOOST_CHECK_EQUAL(0., d5[-1]);
+    BOOST_CHECK_EQUAL(0.5, d5[0]);
+    BOOST_CHECK_EQUAL(500., d5[999]);
+    BOOST_CHECK_EQUAL(500., d5[1500]);
+    BOOST_CHECK_EQUAL(499., d5[2000]);
+    BOOST_CHECK_EQUAL(0., d5[2499]);
+    BOOST_CHECK_EQUAL(0., d5[10000]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
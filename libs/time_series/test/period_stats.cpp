@@ -0,0 +1,157 @@
+//  (C) Copyright Eric Niebler 2005.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/period_stats.hpp>
+
+using namespace boost;
+using namespace unit_test;
+
+namespace seq = boost::sequence;
+
+///////////////////////////////////////////////////////////////////////////////
+// test_dense_period_stats
+//
+void test_dense_period_stats()
+{
+    using namespace time_series;
+
+    dense_series<int> d(discretization = 5);
+    ordered_inserter<dense_series<int> > o(d);
+    for(int i = 0; i < 25; ++i)
+    {
+        o((i * 7) % 11 - 5, i);
+    }
+    o.commit();
+
+    sparse_series<period_summary<int>, int, int> s = period_stats(d, 2, 10);
+    BOOST_CHECK_EQUAL(5, s.discretization());
+    BOOST_CHECK_EQUAL(3, std::distance(seq::begin(s), seq::end(s)));
+
+    // each period is checked against a direct scan of the input
+    for(int p = 2; p < 25; p += 10)
+    {
+        period_summary<int> expected;
+        for(int i = p; i < p + 10 && i < 25; ++i)
+        {
+            expected.add(d[i], 1);
+        }
+
+        period_summary<int> const &actual = s[p];
+        BOOST_CHECK_EQUAL(expected, actual);
+        BOOST_CHECK_EQUAL(d[p], actual.first);
+        BOOST_CHECK_EQUAL(expected.sum / double(expected.count), actual.mean());
+    }
+
+    BOOST_CHECK_EQUAL(10u, s[2].count);
+    BOOST_CHECK_EQUAL(3u, s[22].count);
+    BOOST_CHECK_EQUAL(d[24], s[22].last);
+    BOOST_CHECK_EQUAL(0u, s[0].count);
+
+    // the first period may start before the data
+    sparse_series<period_summary<int>, int, int> s2 = period_stats(d, -5, 10);
+    BOOST_CHECK_EQUAL(5u, s2[-5].count);
+    BOOST_CHECK_EQUAL(d[0], s2[-5].first);
+    BOOST_CHECK_EQUAL(d[4], s2[-5].last);
+
+    // long periods of doubles are summed in several lanes; the extremes
+    // land in different lanes and in the tail
+    dense_series<double> dd;
+    ordered_inserter<dense_series<double> > od(dd);
+    for(int i = 0; i < 103; ++i)
+    {
+        od(37 == i ? -100. : 102 == i ? 100. : ((i * 13) % 29) * .25 - 3., i);
+    }
+    od.commit();
+
+    sparse_series<period_summary<double>, int, int> s3 = period_stats(dd, 0, 50);
+    for(int p = 0; p < 103; p += 50)
+    {
+        period_summary<double> expected;
+        for(int i = p; i < p + 50 && i < 103; ++i)
+        {
+            expected.add(dd[i], 1);
+        }
+
+        period_summary<double> const &actual = s3[p];
+        BOOST_CHECK_EQUAL(expected.count, actual.count);
+        BOOST_CHECK_CLOSE(expected.sum, actual.sum, 1e-12);
+        BOOST_CHECK_EQUAL(expected.min, actual.min);
+        BOOST_CHECK_EQUAL(expected.max, actual.max);
+        BOOST_CHECK_EQUAL(expected.first, actual.first);
+        BOOST_CHECK_EQUAL(expected.last, actual.last);
+    }
+    BOOST_CHECK_EQUAL(-100., s3[0].min);
+    BOOST_CHECK_EQUAL(100., s3[100].max);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_runs_period_stats
+//
+void test_runs_period_stats()
+{
+    using namespace time_series;
+
+    piecewise_constant_series<int> p;
+    make_ordered_inserter(p)
+        (2, 0, 10)
+        (4, 10, 20)
+        (-3, 25, 35)
+    .commit();
+
+    sparse_series<period_summary<int>, int, int> s = period_stats(p, 0, 15);
+    BOOST_CHECK_EQUAL(3, std::distance(seq::begin(s), seq::end(s)));
+
+    // [0, 15): ten 2s and five 4s
+    BOOST_CHECK_EQUAL(15u, s[0].count);
+    BOOST_CHECK_EQUAL(40, s[0].sum);
+    BOOST_CHECK_EQUAL(2, s[0].min);
+    BOOST_CHECK_EQUAL(4, s[0].max);
+    BOOST_CHECK_EQUAL(2, s[0].first);
+    BOOST_CHECK_EQUAL(4, s[0].last);
+
+    // [15, 30): five 4s and five -3s; the gap is not sampled
+    BOOST_CHECK_EQUAL(10u, s[15].count);
+    BOOST_CHECK_EQUAL(5, s[15].sum);
+    BOOST_CHECK_EQUAL(-3, s[15].min);
+    BOOST_CHECK_EQUAL(4, s[15].max);
+    BOOST_CHECK_EQUAL(4, s[15].first);
+    BOOST_CHECK_EQUAL(-3, s[15].last);
+    BOOST_CHECK_EQUAL(.5, s[15].mean());
+
+    // [30, 45): five -3s
+    BOOST_CHECK_EQUAL(5u, s[30].count);
+    BOOST_CHECK_EQUAL(-15, s[30].sum);
+
+    // a sparse series goes through the same path as the piecewise one
+    sparse_series<double> sp;
+    make_ordered_inserter(sp)(1.5, 3)(-2., 4)(6., 12).commit();
+    sparse_series<period_summary<double>, int, int> s2 = period_stats(sp, 0, 10);
+    BOOST_CHECK_EQUAL(2, std::distance(seq::begin(s2), seq::end(s2)));
+    BOOST_CHECK_EQUAL(2u, s2[0].count);
+    BOOST_CHECK_EQUAL(-.5, s2[0].sum);
+    BOOST_CHECK_EQUAL(1.5, s2[0].first);
+    BOOST_CHECK_EQUAL(-2., s2[0].last);
+    BOOST_CHECK_EQUAL(1u, s2[10].count);
+    BOOST_CHECK_EQUAL(6., s2[10].max);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("period_stats test");
+
+    test->add(BOOST_TEST_CASE(&test_dense_period_stats));
+    test->add(BOOST_TEST_CASE(&test_runs_period_stats));
+
+    return test;
+}
@@ -64,6 +64,46 @@ struct test_piecewise_constant_series
     }
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// test_large_lookup
+//
+void test_large_lookup()
+{
+    typedef std::pair<std::ptrdiff_t, std::ptrdiff_t> run;
+    piecewise_constant_series<int> pwc;
+
+    // enough runs that lookups go through the sampled index, once it is built
+    ordered_inserter<piecewise_constant_series<int> > o(pwc);
+    for(int i = 0; i < 1000; ++i)
+    {
+        o(i + 1, 3 * i, 3 * i + 2);
+    }
+    o.commit();
+    pwc.build_index();
+
+    for(int j = -2; j < 3005; ++j)
+    {
+        int expected = (j >= 0 && j < 3000 && j % 3 != 2) ? j / 3 + 1 : 0;
+        BOOST_CHECK_EQUAL(expected, pwc[j]);
+    }
+
+    // changing the runs drops the index
+    rrs::set_at(pwc, run(2000, 2002), -1);
+    BOOST_CHECK_EQUAL(667, pwc[1999]);
+    BOOST_CHECK_EQUAL(-1, pwc[2000]);
+    BOOST_CHECK_EQUAL(-1, pwc[2001]);
+    BOOST_CHECK_EQUAL(668, pwc[2002]);
+    BOOST_CHECK_EQUAL(1000, pwc[2998]);
+
+    pwc.build_index();
+    BOOST_CHECK_EQUAL(-1, pwc[2001]);
+    BOOST_CHECK_EQUAL(668, pwc[2002]);
+
+    make_ordered_inserter(pwc)(5, 10, 20).commit();
+    BOOST_CHECK_EQUAL(5, pwc[10]);
+    BOOST_CHECK_EQUAL(0, pwc[2001]);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -73,6 +113,7 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
 
     test->add(BOOST_TEST_CASE(&test_piecewise_constant_series<std::ptrdiff_t>::call));
     test->add(BOOST_TEST_CASE(&test_piecewise_constant_series<double>::call));
+    test->add(BOOST_TEST_CASE(&test_large_lookup));
 
     return test;
 }
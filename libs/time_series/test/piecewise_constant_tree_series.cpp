@@ -0,0 +1,139 @@
+//  (C) Copyright Eric Niebler 2005.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/piecewise_constant_tree_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/numeric/numeric.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+
+using namespace boost::unit_test;
+using namespace boost::time_series;
+
+namespace seq = boost::sequence;
+namespace rrs = boost::range_run_storage;
+
+#define BOOST_CHECK_RANGE_RUN_EQUAL(x,y)\
+    BOOST_CHECK_EQUAL(x, (boost::time_series::make_ordered_inserter(tmp) y .commit(), tmp))
+
+///////////////////////////////////////////////////////////////////////////////
+// test_piecewise_constant_tree_series
+//
+template<typename Offset>
+struct test_piecewise_constant_tree_series
+{
+    static void call()
+    {
+        piecewise_constant_tree_series<int,int,Offset> tmp; // needed by BOOST_CHECK_RANGE_RUN_EQUAL
+        typedef std::pair<Offset, Offset> run;
+
+        piecewise_constant_tree_series<int,int,Offset> pwc;
+
+        rrs::set_at(pwc, run(4, 8), 4);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (4, 4, 8));
+
+        rrs::set_at(pwc, run(0, 1), 42);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (42, 0)(4, 4, 8));
+
+        rrs::set_at(pwc, run(3, 5), 4);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (42, 0)(4, 3, 8));
+
+        rrs::set_at(pwc, run(10, 14), 10);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (42, 0)(4, 3, 8)(10, 10, 14));
+
+        rrs::set_at(pwc, run(8, 12), 8);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (42, 0)(4, 3, 8)(8, 8, 12)(10, 12, 14));
+
+        rrs::set_at(pwc, run(4, 11), 7);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (42, 0)(4, 3, 4)(7, 4, 11)(8, 11, 12)(10, 12, 14));
+
+        rrs::set_at(pwc, run(3, 11), 17);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (42, 0)(17, 3, 11)(8, 11, 12)(10, 12, 14));
+
+        rrs::set_at(pwc, run(13, 14), 10);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (42, 0)(17, 3, 11)(8, 11, 12)(10, 12, 14));
+
+        rrs::set_at(pwc, run(13, 16), 10);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (42, 0)(17, 3, 11)(8, 11, 12)(10, 12, 16));
+
+        rrs::set_at(pwc, run(0, 20), 20);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (20, 0, 20));
+
+        // writing into the middle of a run keeps both ends of it
+        rrs::set_at(pwc, run(5, 8), 3);
+        BOOST_CHECK_RANGE_RUN_EQUAL(pwc, (20, 0, 5)(3, 5, 8)(20, 8, 20));
+        BOOST_CHECK_EQUAL(20, pwc[4]);
+        BOOST_CHECK_EQUAL(3, pwc[6]);
+        BOOST_CHECK_EQUAL(20, pwc[9]);
+        BOOST_CHECK_EQUAL(0, pwc[21]);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// test_zero_width_runs
+//
+void test_zero_width_runs()
+{
+    typedef std::pair<double, double> run;
+    piecewise_constant_tree_series<int, int, double> tmp; // needed by BOOST_CHECK_RANGE_RUN_EQUAL
+
+    // a zero-width run that ends where the run before it ends
+    piecewise_constant_tree_series<int, int, double> tree;
+    make_ordered_inserter(tree)(1, 0., 1.)(2, 1., 1.)(3, 1., 2.).commit();
+
+    piecewise_constant_series<int, int, double> pwc;
+    make_ordered_inserter(pwc)(1, 0., 1.)(2, 1., 1.)(3, 1., 2.).commit();
+    BOOST_CHECK_EQUAL(pwc, tree);
+
+    // a zero-width run in the middle of a run splits it in two
+    piecewise_constant_tree_series<int, int, double> split;
+    make_ordered_inserter(split)(1, 0., 3.).commit();
+    rrs::set_at(split, run(1.5, 1.5), 7);
+    BOOST_CHECK_RANGE_RUN_EQUAL(split, (1, 0., 1.5)(7, 1.5, 1.5)(1, 1.5, 3.));
+    BOOST_CHECK_EQUAL(1, split[1.]);
+    BOOST_CHECK_EQUAL(1, split[2.]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_mixed_arithmetic
+//
+void test_mixed_arithmetic()
+{
+    piecewise_constant_tree_series<int> tree;
+    make_ordered_inserter(tree)(1, 0, 4)(2, 4, 6).commit();
+
+    piecewise_constant_series<int> pwc;
+    make_ordered_inserter(pwc)(10, 2, 5).commit();
+
+    piecewise_constant_series<int> sum = tree + pwc;
+    piecewise_constant_series<int> expected;
+    make_ordered_inserter(expected)(1, 0, 2)(11, 2, 4)(12, 4, 5)(2, 5, 6).commit();
+    BOOST_CHECK_EQUAL(expected, sum);
+
+    dense_series<int> dense(start = 0, stop = 3, value = 1);
+    dense_series<int> dsum = tree + dense;
+    BOOST_CHECK_EQUAL(2, dsum[0]);
+    BOOST_CHECK_EQUAL(1, dsum[3]);
+    BOOST_CHECK_EQUAL(2, dsum[5]);
+
+    piecewise_constant_tree_series<int> copy = pwc;
+    BOOST_CHECK_EQUAL(pwc, copy);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("piecewise_constant_tree series test");
+
+    test->add(BOOST_TEST_CASE(&test_piecewise_constant_tree_series<std::ptrdiff_t>::call));
+    test->add(BOOST_TEST_CASE(&test_piecewise_constant_tree_series<double>::call));
+    test->add(BOOST_TEST_CASE(&test_zero_width_runs));
+    test->add(BOOST_TEST_CASE(&test_mixed_arithmetic));
+
+    return test;
+}
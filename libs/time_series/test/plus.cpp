@@ -3,13 +3,16 @@
 //  Boost Software License, Version 1.0. (See accompanying file
 //  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/constant_series.hpp>
 #include <boost/time_series/sparse_series.hpp>
 #include <boost/time_series/characteristic_series.hpp>
 #include <boost/time_series/piecewise_constant_series.hpp>
 #include <boost/time_series/numeric/numeric.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
+#include <boost/range_run_storage/algorithm/transform.hpp>
 
 using namespace boost::unit_test;
 using namespace boost::time_series;
@@ -98,6 +101,151 @@ void test_series_plus_floating_point()
     BOOST_CHECK_EQUAL(expected, actual);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// test_series_plus_dense
+//
+void test_series_plus_dense()
+{
+    // dense + dense is computed directly on the buffers; check that it
+    // matches the element-wise union, including the gap between the operands
+    dense_series<double> ss1(start = 1, stop = 4, value = 1.);
+    dense_series<double> ss2(start = 2, stop = 9, value = 10.);
+    dense_series<double> ss3(start = 6, stop = 8, value = 100.);
+
+    dense_series<double> sum = ss1 + ss2;
+    BOOST_CHECK_EQUAL(8, std::distance(seq::begin(sum), seq::end(sum)));
+    BOOST_CHECK_EQUAL(0., sum[0]);
+    BOOST_CHECK_EQUAL(1., sum[1]);
+    BOOST_CHECK_EQUAL(11., sum[2]);
+    BOOST_CHECK_EQUAL(11., sum[3]);
+    BOOST_CHECK_EQUAL(10., sum[4]);
+    BOOST_CHECK_EQUAL(10., sum[8]);
+    BOOST_CHECK_EQUAL(0., sum[9]);
+
+    dense_series<double> gap = ss1 + ss3;
+    BOOST_CHECK_EQUAL(7, std::distance(seq::begin(gap), seq::end(gap)));
+    BOOST_CHECK_EQUAL(1., gap[3]);
+    BOOST_CHECK_EQUAL(0., gap[4]);
+    BOOST_CHECK_EQUAL(0., gap[5]);
+    BOOST_CHECK_EQUAL(100., gap[6]);
+
+    dense_series<double> diff = ss2 - ss1;
+    BOOST_CHECK_EQUAL(-1., diff[1]);
+    BOOST_CHECK_EQUAL(9., diff[2]);
+    BOOST_CHECK_EQUAL(10., diff[4]);
+
+    // dense + scaled dense
+    dense_series<double> scaled = ss1 + ss2 * 2.;
+    BOOST_CHECK_EQUAL(1., scaled[1]);
+    BOOST_CHECK_EQUAL(21., scaled[2]);
+    BOOST_CHECK_EQUAL(20., scaled[8]);
+
+    // dense + constant has pre- and post-runs with the constant value
+    constant_series<double> c(5.);
+    dense_series<double> shifted = ss1 + c;
+    BOOST_CHECK_EQUAL(5., shifted[-100]);
+    BOOST_CHECK_EQUAL(6., shifted[1]);
+    BOOST_CHECK_EQUAL(6., shifted[3]);
+    BOOST_CHECK_EQUAL(5., shifted[4]);
+    BOOST_CHECK_EQUAL(5., shifted[100]);
+    BOOST_CHECK_EQUAL(1, rrs::end_offset(rrs::pre_run(shifted)));
+    BOOST_CHECK_EQUAL(4, rrs::offset(rrs::post_run(shifted)));
+
+    // operands with pre- and post-runs take the general path
+    dense_series<double> with_pre = shifted + ss2;
+    BOOST_CHECK_EQUAL(5., with_pre[0]);
+    BOOST_CHECK_EQUAL(16., with_pre[2]);
+    BOOST_CHECK_EQUAL(15., with_pre[8]);
+    BOOST_CHECK_EQUAL(5., with_pre[9]);
+
+    ss1 += ss2;
+    BOOST_CHECK_EQUAL(sum, ss1);
+
+    dense_series<double> empty;
+    BOOST_CHECK_EQUAL(ss2, empty + ss2);
+    BOOST_CHECK_EQUAL(ss2, ss2 + empty);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_series_plus_nary
+//
+void test_series_plus_nary()
+{
+    // summing many series in one pass gives the same result as summing
+    // them pairwise
+    std::vector<sparse_series<int> > series(5);
+    make_ordered_inserter(series[0])(1, 1)(2, 4)(3, 9).commit();
+    make_ordered_inserter(series[1])(10, 4)(20, 5).commit();
+    make_ordered_inserter(series[2])(100, -3)(200, 9).commit();
+    make_ordered_inserter(series[4])(1000, 1)(2000, 4)(3000, 20).commit();
+
+    sparse_series<int> pairwise;
+    for(std::size_t i = 0; i != series.size(); ++i)
+    {
+        pairwise += series[i];
+    }
+
+    sparse_series<int> sum;
+    {
+        ordered_inserter<sparse_series<int> > out(sum);
+        rrs::transform_union(series, boost::numeric::plus, out).commit();
+    }
+
+    BOOST_CHECK_EQUAL(std::distance(seq::begin(pairwise), seq::end(pairwise)), std::distance(seq::begin(sum), seq::end(sum)));
+    for(int i = -5; i < 25; ++i)
+    {
+        BOOST_CHECK_EQUAL(pairwise[i], sum[i]);
+    }
+
+    // many series, not a power of two of them, that start and stop runs at
+    // different offsets
+    std::vector<piecewise_constant_series<int> > many(37);
+    for(int i = 0; i != 37; ++i)
+    {
+        make_ordered_inserter(many[i])(i + 1, i, i + 10)(2 * i, 3 * i + 20, 3 * i + 25).commit();
+    }
+
+    piecewise_constant_series<int> many_total;
+    {
+        ordered_inserter<piecewise_constant_series<int> > out(many_total);
+        rrs::transform_union(many, boost::numeric::plus, out).commit();
+    }
+
+    for(int i = -5; i < 140; ++i)
+    {
+        int expected = 0;
+        for(int j = 0; j != 37; ++j)
+        {
+            expected += many[j][i];
+        }
+        BOOST_CHECK_EQUAL(expected, many_total[i]);
+    }
+
+    // runs that overlap and have pre- and post-runs
+    std::vector<piecewise_constant_series<int> > pieces(3);
+    make_ordered_inserter(pieces[0])(1, 0, 10).commit();
+    make_ordered_inserter(pieces[1])(2, 5, 15)(7, 20, 22).commit();
+    make_ordered_inserter(pieces[2])(4, -5, 6)(8, 8, 21).commit();
+
+    piecewise_constant_series<int> total;
+    {
+        ordered_inserter<piecewise_constant_series<int> > out(total);
+        rrs::transform_union(pieces, boost::numeric::plus, out).commit();
+    }
+
+    piecewise_constant_series<int> product;
+    {
+        ordered_inserter<piecewise_constant_series<int> > out(product);
+        rrs::transform_intersection(pieces, boost::numeric::multiplies, out).commit();
+    }
+
+    for(int i = -10; i < 25; ++i)
+    {
+        BOOST_CHECK_EQUAL(pieces[0][i] + pieces[1][i] + pieces[2][i], total[i]);
+        BOOST_CHECK_EQUAL(pieces[0][i] * pieces[1][i] * pieces[2][i], product[i]);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -108,6 +256,8 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
     test->add(BOOST_TEST_CASE(&test_series_plus));
     test->add(BOOST_TEST_CASE(&test_series_plus_2));
     test->add(BOOST_TEST_CASE(&test_series_plus_floating_point));
+    test->add(BOOST_TEST_CASE(&test_series_plus_dense));
+    test->add(BOOST_TEST_CASE(&test_series_plus_nary));
 
     return test;
 }
@@ -0,0 +1,141 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/quantile.hpp>
+#include <boost/time_series/numeric/quantile_sketch.hpp>
+
+using namespace boost;
+using namespace unit_test;
+
+///////////////////////////////////////////////////////////////////////////////
+// test_quantile
+//
+void test_quantile()
+{
+    using namespace time_series;
+
+    sparse_series<int> s;
+    make_ordered_inserter(s)(5, 0)(1, 3)(4, 7)(2, 8)(3, 20).commit();
+
+    BOOST_CHECK_EQUAL(1, quantile(s, 0.));
+    BOOST_CHECK_EQUAL(1, quantile(s, .2));
+    BOOST_CHECK_EQUAL(2, quantile(s, .3));
+    BOOST_CHECK_EQUAL(3, median(s));
+    BOOST_CHECK_EQUAL(5, quantile(s, .9));
+    BOOST_CHECK_EQUAL(5, quantile(s, 1.));
+
+    // Each run counts with its length as its weight
+    piecewise_constant_series<int> p;
+    make_ordered_inserter(p)
+        (7, 0, 10)
+        (3, 10, 100)
+        (9, 200, 201)
+    .commit();
+
+    BOOST_CHECK_EQUAL(3, quantile(p, 0.));
+    BOOST_CHECK_EQUAL(3, median(p));
+    BOOST_CHECK_EQUAL(3, quantile(p, .89));
+    BOOST_CHECK_EQUAL(7, quantile(p, .9));
+    BOOST_CHECK_EQUAL(7, quantile(p, .99));
+    BOOST_CHECK_EQUAL(9, quantile(p, 1.));
+
+    dense_series<double> d(start = 0, stop = 1001);
+    for(std::ptrdiff_t i = 0; i < 1001; ++i)
+        range_run_storage::set_at(d, range_run_storage::unit_run<std::ptrdiff_t>(i), (i * 379) % 1001 / 10.);
+
+    BOOST_CHECK_EQUAL(50., median(d));
+    BOOST_CHECK_EQUAL(0., quantile(d, 0.));
+    BOOST_CHECK_EQUAL(100., quantile(d, 1.));
+    BOOST_CHECK_EQUAL(9., quantile(d, .09));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_quantile_sketch
+//
+void test_quantile_sketch()
+{
+    using namespace time_series;
+
+    std::ptrdiff_t const size = 100000;
+    dense_series<double> d(start = 0, stop = size);
+    std::vector<double> sorted;
+    unsigned int seed = 12345;
+    for(std::ptrdiff_t i = 0; i < size; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        double const x = (seed >> 8) % 100000 / 1000.;
+        range_run_storage::set_at(d, range_run_storage::unit_run<std::ptrdiff_t>(i), x * x);
+        sorted.push_back(x * x);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    quantile_sketch<double> sketch = make_quantile_sketch(d);
+    BOOST_CHECK_EQUAL(double(size), sketch.weight());
+    BOOST_CHECK(sketch.size() <= 200u);
+    BOOST_CHECK_EQUAL(sorted.front(), sketch.quantile(0.));
+    BOOST_CHECK_EQUAL(sorted.back(), sketch.quantile(1.));
+
+    double const qs[] = {.001, .01, .1, .25, .5, .75, .9, .99, .999};
+    for(std::size_t i = 0; i != sizeof(qs) / sizeof(*qs); ++i)
+    {
+        // The rank of the estimate is within 1% of the requested one
+        double const estimate = sketch.quantile(qs[i]);
+        double const rank = double(std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin()) / size;
+        BOOST_CHECK_SMALL(rank - qs[i], .01);
+    }
+
+    // Sketched in two pieces and merged
+    dense_series<double> first(start = 0, stop = size / 2);
+    dense_series<double> second(start = size / 2, stop = size);
+    for(std::ptrdiff_t i = 0; i < size; ++i)
+        range_run_storage::set_at(i < size / 2 ? first : second, range_run_storage::unit_run<std::ptrdiff_t>(i), d[i]);
+
+    quantile_sketch<double> merged = make_quantile_sketch(first);
+    merged.merge(make_quantile_sketch(second));
+    BOOST_CHECK_EQUAL(double(size), merged.weight());
+    double const rank = double(std::lower_bound(sorted.begin(), sorted.end(), merged.median()) - sorted.begin()) / size;
+    BOOST_CHECK_SMALL(rank - .5, .01);
+
+    // Long runs are weighted by their length, not expanded
+    piecewise_constant_series<double> p;
+    make_ordered_inserter(p)
+        (1., 0, 900000)
+        (2., 900000, 1000000)
+    .commit();
+
+    quantile_sketch<double> weighted = make_quantile_sketch(p);
+    BOOST_CHECK_EQUAL(1e6, weighted.weight());
+    BOOST_CHECK_EQUAL(2u, weighted.size());
+    BOOST_CHECK_EQUAL(1., weighted.quantile(.5));
+    BOOST_CHECK_EQUAL(1., weighted.quantile(.4));
+    BOOST_CHECK_EQUAL(2., weighted.quantile(1.));
+
+    // Merged with itself, with its values still buffered
+    weighted.merge(weighted);
+    BOOST_CHECK_EQUAL(2e6, weighted.weight());
+    BOOST_CHECK_EQUAL(1., weighted.quantile(.5));
+    BOOST_CHECK_EQUAL(2., weighted.quantile(1.));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("quantile test");
+
+    test->add(BOOST_TEST_CASE(&test_quantile));
+    test->add(BOOST_TEST_CASE(&test_quantile_sketch));
+
+    return test;
+}
@@ -0,0 +1,104 @@
+//  (C) Copyright Eric Niebler 2006.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/time_series/dense_series.hpp>
+#include <boost/time_series/sparse_series.hpp>
+#include <boost/time_series/piecewise_constant_series.hpp>
+#include <boost/time_series/ordered_inserter.hpp>
+#include <boost/time_series/numeric/rolling.hpp>
+
+using namespace boost;
+using namespace unit_test;
+using namespace time_series;
+
+namespace rrs = boost::range_run_storage;
+
+// Compares the rolling statistics of series to ones computed the slow way
+// over the offsets [-5, 60)
+template<typename Series>
+void check_rolling(Series const &series, std::ptrdiff_t window)
+{
+    piecewise_constant_series<int> sum = rolling_sum(series, window);
+    piecewise_constant_series<double> mean = rolling_mean(series, window);
+    piecewise_constant_series<double> var = rolling_var(series, window);
+    piecewise_constant_series<int> lo = rolling_min(series, window);
+    piecewise_constant_series<int> hi = rolling_max(series, window);
+
+    for(std::ptrdiff_t i = -5; i < 60; ++i)
+    {
+        std::vector<int> values;
+        for(std::ptrdiff_t j = i - window + 1; j <= i; ++j)
+            values.push_back(series[j]);
+
+        int s = 0;
+        double m2 = 0.;
+        for(std::size_t j = 0; j < values.size(); ++j)
+            s += values[j];
+        double m = double(s) / window;
+        for(std::size_t j = 0; j < values.size(); ++j)
+            m2 += (values[j] - m) * (values[j] - m);
+
+        BOOST_CHECK_EQUAL(s, sum[i]);
+        BOOST_CHECK_CLOSE(m + 1., mean[i] + 1., 1e-9);
+        BOOST_CHECK_CLOSE(m2 / window + 1., var[i] + 1., 1e-9);
+        BOOST_CHECK_EQUAL(*std::min_element(values.begin(), values.end()), lo[i]);
+        BOOST_CHECK_EQUAL(*std::max_element(values.begin(), values.end()), hi[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_rolling
+//
+void test_rolling()
+{
+    piecewise_constant_series<int> p;
+    make_ordered_inserter(p)
+        (2, 0, 10)
+        (-3, 10, 12)
+        (4, 12, 13)
+        (5, 20, 35)
+        (-1, 40, 41)
+    .commit();
+
+    dense_series<int> d(start = 2, stop = 30);
+    for(int i = 2; i < 30; ++i)
+        rrs::set_at(d, rrs::unit_run<std::ptrdiff_t>(i), (i * 7) % 11 - 5);
+
+    sparse_series<int> s;
+    make_ordered_inserter(s)
+        (3, 1)(-2, 4)(6, 5)(1, 20)
+    .commit();
+
+    for(std::ptrdiff_t window = 1; window < 10; window += 2)
+    {
+        check_rolling(p, window);
+        check_rolling(d, window);
+        check_rolling(s, window);
+    }
+
+    // A window inside a long constant run gives one run of output
+    piecewise_constant_series<int> sum = rolling_sum(p, 4);
+    BOOST_CHECK_EQUAL(20, sum[23]);
+    BOOST_CHECK_EQUAL(20, sum[34]);
+    BOOST_CHECK_EQUAL(15, sum[35]);
+    BOOST_CHECK_EQUAL(0, sum[1000]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// init_unit_test_suite
+//
+test_suite* init_unit_test_suite( int argc, char* argv[] )
+{
+    test_suite *test = BOOST_TEST_SUITE("rolling test");
+
+    test->add(BOOST_TEST_CASE(&test_rolling));
+
+    return test;
+}
@@ -4,6 +4,7 @@
 //  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <fstream>
+#include <sstream>
 #include <boost/test/unit_test.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
 #include <boost/time_series/characteristic_series.hpp>
@@ -205,6 +206,35 @@ void test_serialization()
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// test_sparse_archive_version_0
+//
+void test_sparse_archive_version_0()
+{
+    namespace rrs = range_run_storage;
+    using namespace time_series;
+
+    // A sparse_series<int> written before sparse_array kept its offsets and
+    // values apart, when they were archived in (offset, value) pairs
+    std::istringstream iss(
+        "22 serialization::archive 18 0 0 30 0 0 0 0 3 0 0 0 0 0 -5 4 0 6 4 7 3 0 0 0 0 "
+        "-9223372036854775808 -10 2 10 9223372036854775807 5"
+    );
+
+    sparse_series<int> expected(discretization = 30, zero = 3);
+    make_ordered_inserter(expected)(2, -inf, -10)(4, -5)(6, 0)(7, 4)(5, 10, inf).commit();
+
+    sparse_series<int> result;
+    boost::archive::text_iarchive ia(iss);
+    ia >> result;
+
+    BOOST_CHECK_EQUAL(expected, result);
+    BOOST_CHECK_EQUAL(result.discretization(), 30);
+    BOOST_CHECK_EQUAL(3, rrs::zero(result));
+    BOOST_CHECK_EQUAL(6, result[0]);
+    BOOST_CHECK_EQUAL(3, result[1]);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -213,6 +243,7 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
     test_suite *test = BOOST_TEST_SUITE("series serialization test");
 
     test->add(BOOST_TEST_CASE(&test_serialization));
+    test->add(BOOST_TEST_CASE(&test_sparse_archive_version_0));
 
     return test;
 }
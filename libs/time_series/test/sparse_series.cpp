@@ -62,6 +62,65 @@ void test_random_access()
     BOOST_CHECK_EQUAL(0, cs[0]);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// test_bulk_insert
+//
+void test_bulk_insert()
+{
+    int const values[] = {1, 0, 3, 0, 5};
+    std::ptrdiff_t const offsets[] = {-4, 0, 1, 7, 9};
+
+    // zeros in the block are not stored
+    sparse_series<int> s1;
+    make_ordered_inserter(s1).set_at_range(2, values, values + 5)(6, 7).commit();
+    BOOST_CHECK_EQUAL(4, std::distance(seq::begin(s1), seq::end(s1)));
+    BOOST_CHECK_EQUAL(1, s1[2]);
+    BOOST_CHECK_EQUAL(0, s1[3]);
+    BOOST_CHECK_EQUAL(3, s1[4]);
+    BOOST_CHECK_EQUAL(5, s1[6]);
+    BOOST_CHECK_EQUAL(6, s1[7]);
+
+    sparse_series<int> s2;
+    make_ordered_inserter(s2).set_at_offsets(offsets, offsets + 5, values)(6, 10).commit();
+    BOOST_CHECK_EQUAL(4, std::distance(seq::begin(s2), seq::end(s2)));
+    BOOST_CHECK_EQUAL(-4, rrs::offset(rrs::runs(s2)(*seq::begin(s2))));
+    BOOST_CHECK_EQUAL(1, s2[-4]);
+    BOOST_CHECK_EQUAL(3, s2[1]);
+    BOOST_CHECK_EQUAL(0, s2[7]);
+    BOOST_CHECK_EQUAL(5, s2[9]);
+    BOOST_CHECK_EQUAL(6, s2[10]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// test_large_lookup
+//
+void test_large_lookup()
+{
+    sparse_series<int> s;
+    sparse_series<int> const &cs = s;
+
+    // enough points that lookups go through the sampled index, once it is built
+    ordered_inserter<sparse_series<int> > o(s);
+    for(int i = 0; i < 1000; ++i)
+    {
+        o(i + 1, 3 * i);
+    }
+    o.commit();
+    s.build_index();
+
+    for(int j = -2; j < 3005; ++j)
+    {
+        BOOST_CHECK_EQUAL((j >= 0 && j < 3000 && j % 3 == 0) ? j / 3 + 1 : 0, cs[j]);
+    }
+
+    // replacing the contents drops the index
+    make_ordered_inserter(s)(7, 1)(8, 2).commit();
+    BOOST_CHECK_EQUAL(0, cs[0]);
+    BOOST_CHECK_EQUAL(7, cs[1]);
+    BOOST_CHECK_EQUAL(8, cs[2]);
+    BOOST_CHECK_EQUAL(0, cs[3]);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -71,6 +130,8 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
 
     test->add(BOOST_TEST_CASE(&test_sparse_series));
     test->add(BOOST_TEST_CASE(&test_random_access));
+    test->add(BOOST_TEST_CASE(&test_bulk_insert));
+    test->add(BOOST_TEST_CASE(&test_large_lookup));
 
     return test;
 }
@@ -10,6 +10,7 @@
 #include <boost/time_series/piecewise_constant_series.hpp>
 #include <boost/time_series/ordered_inserter.hpp>
 #include <boost/time_series/numeric/variable_period_sums.hpp>
+#include <boost/time_series/numeric/integral_index.hpp>
 #include "./is_close.hpp"
 
 using namespace boost;
@@ -119,6 +120,71 @@ void test_floating_variable_period_sums2()
     BOOST_CHECK(is_close(expected, actual, 0.1));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// test_indexed_variable_period_sums
+//
+void test_indexed_variable_period_sums()
+{
+    using namespace time_series;
+    typedef counting_iterator<int> int_;
+
+    dense_series<int> d;
+    std::copy(int_(0), int_(10), make_ordered_inserter(d, 0)).commit();
+    integral_index<int> di = make_integral_index(d);
+
+    std::ptrdiff_t periods[] = { 0, 4, 6, 8, 12 };
+    int elements[] = { 0, 1, 0, 2, 0 };
+
+    BOOST_CHECK_EQUAL(variable_period_sums(d, periods), di.variable_period_sums(periods));
+    BOOST_CHECK_EQUAL(
+        shifted_variable_period_sums(d, periods, elements)
+      , di.shifted_variable_period_sums(periods, elements)
+    );
+
+    // arbitrary ranges
+    BOOST_CHECK_EQUAL(45, di.sum(-5, 20));
+    BOOST_CHECK_EQUAL(2 + 3 + 4, di.sum(2, 5));
+    BOOST_CHECK_EQUAL(0, di.sum(3, 3));
+    BOOST_CHECK_EQUAL(9, di.sum(9, 100));
+
+    // runs longer than one offset count in part
+    piecewise_constant_series<double> pwc(discretization = 2);
+    make_ordered_inserter(pwc)
+        (3.1, -2, -1)
+        (4.2, -1, 0)
+        (5.3, 1, 2)
+        (6.4, 10, 20)
+    .commit();
+    integral_index<double> pi = make_integral_index(pwc);
+
+    std::ptrdiff_t periods2[] = { -10, -2, 0, 1, 2, 3, 6, 12, 15 };
+    BOOST_CHECK(is_close(variable_period_sums(pwc, periods2), pi.variable_period_sums(periods2), 1e-6));
+    BOOST_CHECK_CLOSE(6.4 * 3 + 5.3, pi.sum(1, 13), 1e-6);
+    BOOST_CHECK_CLOSE(2 * 6.4 * 3 + 2 * 5.3, pi.integral(1, 13), 1e-6);
+
+    piecewise_constant_series<double, int, double> fpwc;
+    make_ordered_inserter(fpwc)
+        (3., -2.2, -1.1)
+        (4., -.1, .1)
+        (5., 1.1, 2.2)
+        (6., 10.1, 20.2)
+    .commit();
+
+    double periods3[] = { -10.0, -2.1, -0.9, 0.9, 2.1, 3.3, 6.6, 12.3, 15.7 };
+    BOOST_CHECK(is_close(
+        variable_period_sums(fpwc, periods3)
+      , make_integral_index(fpwc).variable_period_sums(periods3)
+      , 1e-6
+    ));
+
+    // an infinite pre-run counts from its finite end
+    sparse_series<int> s;
+    make_ordered_inserter(s)(2, -inf, 0)(5, 3).commit();
+    integral_index<int> si = make_integral_index(s);
+    BOOST_CHECK_EQUAL(2 * 4, si.sum(-4, 0));
+    BOOST_CHECK_EQUAL(2 * 2 + 5, si.sum(-2, 7));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -130,6 +196,7 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
     test->add(BOOST_TEST_CASE(&test_shifted_variable_period_sums));
     test->add(BOOST_TEST_CASE(&test_floating_variable_period_sums));
     test->add(BOOST_TEST_CASE(&test_floating_variable_period_sums2));
+    test->add(BOOST_TEST_CASE(&test_indexed_variable_period_sums));
 
     return test;
 }